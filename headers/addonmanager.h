@@ -10,12 +10,15 @@ enum ADDON_PROCESS {
     CORE0_INPUT,
     CORE0_USBREPORT,
     CORE1_ALWAYS,
-    CORE1_LOOP
+    CORE1_LOOP,
+    ADDON_PROCESS_COUNT
 };
 
 struct AddonBlock {
     GPAddon * ptr;
     ADDON_PROCESS process;
+    std::string name;   // cached at load, name() builds a new string every call
+    bool deferred;      // keeps its place in the load order until LoadDeferredAddon() sets it up
 };
 
 class AddonManager {
@@ -24,12 +27,22 @@ public:
     ~AddonManager() {}
     bool LoadAddon(GPAddon*, ADDON_PROCESS);
     bool LoadUSBAddon(GPAddon*, ADDON_PROCESS);
+    void DeferAddon(GPAddon*, ADDON_PROCESS);   // available()/setup() run later, in LoadDeferredAddon()
+    bool LoadDeferredAddon();                   // sets up the next deferred add-on, false once none are left
     void ReinitializeAddons(ADDON_PROCESS);
     void PreprocessAddons(ADDON_PROCESS);
     void ProcessAddons(ADDON_PROCESS);
+    absolute_time_t NextDeadline(ADDON_PROCESS);
     GPAddon * GetAddon(std::string); // hack for NeoPicoLED
 private:
+    void BuildCallLists();
     std::vector<AddonBlock*> addons;    // addons currently loaded
+
+    // Per-phase call lists, built once at load so the hot loops only walk
+    // the add-ons that actually do work in that phase
+    std::vector<GPAddon*> reinitList[ADDON_PROCESS_COUNT];
+    std::vector<GPAddon*> preprocessList[ADDON_PROCESS_COUNT];
+    std::vector<GPAddon*> processList[ADDON_PROCESS_COUNT];
 };
 
 #endif
@@ -101,6 +101,7 @@ public:
     virtual void setup();       // Analog Setup
     virtual void process();     // Analog Process
     virtual void preprocess() {}
+    virtual bool hasPreprocess() { return false; }
     virtual std::string name() { return AnalogName; }
 private:
     float readPin(Pin_t pin, uint16_t center);
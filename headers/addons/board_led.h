@@ -29,7 +29,9 @@ public:
 	virtual bool available();
 	virtual void setup();       // BoardLed Setup
 	virtual void process();     // BoardLed Process
+	virtual absolute_time_t nextDeadline();
 	virtual void preprocess() {}
+	virtual bool hasPreprocess() { return false; }
 	virtual std::string name() { return OnBoardLedName; }
 private:
 	OnBoardLedMode onBoardLedMode;
@@ -20,6 +20,7 @@ public:
 	virtual bool available();
 	virtual void setup();       // BootselButton Setup
 	virtual void process() {}     // BootselButton Process
+	virtual bool hasProcess() { return false; }
 	virtual void preprocess();
 	virtual std::string name() { return BootselButtonName; }
 private:	
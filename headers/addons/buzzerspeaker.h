@@ -1,9 +1,11 @@
 #ifndef BUZZER_H_
 #define BUZZER_H_
 
-#include <vector>
+#include <array>
 #include <string>
+#include "pico/time.h"
 #include "gpaddon.h"
+#include "peripheralmanager.h"
 
 #ifndef BUZZER_ENABLED
 #define BUZZER_ENABLED 0
@@ -21,6 +23,15 @@
 #define BUZZER_VOLUME 100
 #endif
 
+// System clocks the PWM tables are built for: 125 MHz by default, the USB host clock when USB host is enabled
+#ifndef BUZZER_SYS_CLOCK_HZ
+#define BUZZER_SYS_CLOCK_HZ 125000000
+#endif
+
+#ifndef BUZZER_USB_HOST_SYS_CLOCK_HZ
+#define BUZZER_USB_HOST_SYS_CLOCK_HZ (USB_HOST_SYS_CLOCK_KHZ * 1000)
+#endif
+
 // Buzzer Speaker Module
 #define BuzzerSpeakerName "BuzzerSpeaker"
 
@@ -116,13 +127,36 @@ enum Tone {
 	PAUSE = 0
 };
 
+// PWM settings for one tone, divider in 1/16ths as written to the slice. A wrap of 0 is a pause.
+struct BuzzerNote {
+	uint16_t divider16;
+	uint16_t wrap;
+};
+
+constexpr BuzzerNote buzzerNote(uint32_t clock, uint32_t frequency) {
+	if (frequency == 0)
+		return BuzzerNote{0, 0};
+	uint32_t divider16 = clock / frequency / 4096 +
+							(clock % (frequency * 4096) != 0);
+	if (divider16 / 16 == 0)
+		divider16 = 16;
+	uint32_t wrap = clock * 16ull / divider16 / frequency - 1;
+	return BuzzerNote{(uint16_t)divider16, (uint16_t)wrap};
+}
+
+template <size_t N>
+constexpr std::array<BuzzerNote, N> buzzerNotes(uint32_t clock, const Tone (&tones)[N]) {
+	std::array<BuzzerNote, N> notes{};
+	for (size_t i = 0; i < N; i++)
+		notes[i] = buzzerNote(clock, tones[i]);
+	return notes;
+}
+
 struct Song {
 	uint16_t toneDuration;
-	std::vector<Tone> song;
-	Song(uint16_t t, std::vector<Tone> s){
-		toneDuration = t;
-		song = s;
-	};
+	uint16_t length;
+	const BuzzerNote *notes;
+	const BuzzerNote *usbHostNotes;
 };
 
 // Buzzer Speaker
@@ -132,21 +166,28 @@ public:
 	virtual bool available();
 	virtual void setup();
 	virtual void preprocess() {}
+	virtual bool hasPreprocess() { return false; }
 	virtual void process();
+	virtual absolute_time_t nextDeadline();
 	virtual std::string name() { return BuzzerSpeakerName; }
 private:
-	void processBuzzer();
-	void play(Song *song);
+	static int64_t noteAlarm(alarm_id_t id, void *userData);
+	int64_t nextNote();
+	void applyNote(const BuzzerNote& note);
+	void play(const Song *song);
 	void playIntro();
 	void stop();
-	uint32_t pwmSetFreqDuty(uint slice, uint channel, uint32_t frequency, float duty);
 	uint8_t buzzerPin;
 	uint8_t buzzerEnablePin;
 	uint8_t buzzerPinSlice;
 	uint8_t buzzerPinChannel;
 	uint8_t buzzerVolume;
-	uint32_t startedSongMils;
-	Song *currentSong;
+	bool usbHostClock;
+	const Song * volatile currentSong;
+	const BuzzerNote *currentNotes;
+	volatile uint16_t currentNotePosition;
+	alarm_id_t noteAlarmId;
+	alarm_pool_t *alarmPool = nullptr;
 	bool introPlayed;
     bool isSpeakerOn = false;
 };
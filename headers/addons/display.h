@@ -46,6 +46,11 @@
 #define I2C_SPEED 800000
 #endif
 
+// Redraw rate while nothing changes on Core0 (animations, screen saver)
+#ifndef DISPLAY_FRAME_INTERVAL_MS
+#define DISPLAY_FRAME_INTERVAL_MS 16
+#endif
+
 #ifndef DISPLAY_SIZE
 #define DISPLAY_SIZE GPGFX_DisplaySize::SIZE_128x64
 #endif
@@ -192,7 +197,9 @@ public:
 	virtual bool available();
 	virtual void setup();
 	virtual void preprocess() {}
+	virtual bool hasPreprocess() { return false; }
 	virtual void process();
+	virtual absolute_time_t nextDeadline();
 	virtual std::string name() { return DisplayName; }
 
     void handleSystemRestart(GPEvent* e);
@@ -50,7 +50,9 @@ public:
 	virtual bool available();
 	virtual void setup();
 	virtual void preprocess() {}
+	virtual bool hasPreprocess() { return false; }
 	virtual void process();
+	virtual absolute_time_t nextDeadline() { return at_the_end_of_time; } // host rumble changes arrive within CORE1_IDLE_MAX_MS
 	virtual std::string name() { return DRV8833RumbleName; }
 private:
 	uint32_t pwmSetFreqDuty(uint slice, uint channel, uint32_t frequency, float duty);
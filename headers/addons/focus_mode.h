@@ -41,6 +41,7 @@ public:
 	virtual void setup();       // FocusMode Setup
 	virtual void process();     // FocusMode Process
 	virtual void preprocess() {}
+	virtual bool hasPreprocess() { return false; }
 	virtual std::string name() { return FocusModeName; }
 private:
 	uint32_t buttonLockMask;
@@ -19,6 +19,7 @@ public:
 	virtual bool available();
 	virtual void setup();       // GamepadUSBHost Setup
 	virtual void process() {}   // GamepadUSBHost Process
+	virtual bool hasProcess() { return false; }
 	virtual void preprocess();
 	virtual std::string name() { return GamepadUSBHostName; }
 private:
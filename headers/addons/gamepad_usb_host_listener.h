@@ -126,6 +126,8 @@ class GamepadUSBHostListener : public USBListener {
         void process();
     private:
         GamepadState _controller_host_state;
+        USBListenerMailbox<GamepadState> _controller_host_mailbox;
+        GamepadState _controller_host_report;
         bool _controller_host_enabled;
         void process_ctrlr_report(uint8_t dev_addr, uint8_t const* report, uint16_t len);
 
@@ -141,6 +141,7 @@ public:
 	virtual bool available();
 	virtual void setup();
 	virtual void preprocess() {}
+	virtual bool hasPreprocess() { return false; }
 	virtual void process();
     virtual std::string name() { return PCF8575AddonName; }
 
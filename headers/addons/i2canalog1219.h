@@ -32,11 +32,20 @@
 #define I2C_ANALOG1219_ADDRESS 0x40
 #endif
 
+// Without a DRDY pin the STATUS register is polled at this rate
+#ifndef I2C_ANALOG1219_READ_INTERVAL_US
+#define I2C_ANALOG1219_READ_INTERVAL_US 1000
+#endif
+
+#ifndef I2C_ANALOG1219_DRDY_PIN
+#define I2C_ANALOG1219_DRDY_PIN -1
+#endif
+
 // Analog Module Name
 #define I2CAnalog1219Name "I2CAnalog"
 
 typedef struct {
-	float A[4];
+	uint16_t A[4];              // latest sample per channel, full scale 65535
 } ADS_PINS;
 
 class I2CAnalog1219Input : public GPAddon {
@@ -44,14 +53,15 @@ public:
 	virtual bool available();
 	virtual void setup();       // Analog Setup
 	virtual void preprocess() {}
+	virtual bool hasPreprocess() { return false; }
 	virtual void process();     // Analog Process
     virtual std::string name() { return I2CAnalog1219Name; }
 private:
+	void readChannel();
     ADS1219Device * ads;
 	ADS_PINS pins;
 	int channelHop;
-	uint32_t uIntervalMS;       // ADS1219 Interval
-	uint32_t nextTimer;         // Turbo Timer
+	int32_t drdyPin;
 };
 
 #endif  // _I2CAnalog_H_
@@ -37,6 +37,7 @@ public:
 	virtual bool available();   // GPAddon available
 	virtual void setup();       // Analog Setup
 	virtual void process() {};     // Analog Process
+	virtual bool hasProcess() { return false; }
 	virtual void preprocess();
     virtual void reinit();
     virtual std::string name() { return InputMacroName; }
@@ -23,6 +23,7 @@ public:
 	virtual bool available();
 	virtual void setup();       // KeyboardHost Setup
 	virtual void process() {}   // KeyboardHost Process
+	virtual bool hasProcess() { return false; }
 	virtual void preprocess();
 	virtual std::string name() { return KeyboardHostName; }
 private:
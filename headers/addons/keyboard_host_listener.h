@@ -5,23 +5,39 @@
 #include "gamepad.h"
 #include "class/hid/hid.h"
 
-struct KeyboardButtonMapping
-{
-	uint8_t key;
-	uint16_t buttonMask;
-
-	inline void setMask(uint16_t m) {
-		buttonMask = m;
-	}
+// Maximum number of keyboard input fields (modifier bitmap, key array, NKRO bitmap)
+// tracked from a keyboard's HID report descriptor
+#ifndef KEYBOARD_HOST_MAX_REPORT_FIELDS
+#define KEYBOARD_HOST_MAX_REPORT_FIELDS 4
+#endif
 
-	inline void setKey(uint8_t p)
-	{
-		key = (p > HID_KEY_NONE && p <= HID_KEY_GUI_RIGHT) ? p : 0xff;
-	}
+// Gamepad inputs driven by a single HID keycode
+struct KeyboardKeyMask
+{
+	uint32_t buttons;
+	uint8_t dpad;
+};
 
-	bool isAssigned() const { return key != 0xff; }
+// Keyboard usage page input field from the report descriptor, either a bitmap of
+// keys (NKRO and modifiers) or an array of pressed keycodes (boot style)
+struct KeyboardReportField
+{
+	uint8_t reportId;
+	uint16_t bitOffset;
+	uint16_t count;
+	uint8_t usageMin;
+	bool isBitmap;
 };
 
+// Decoded keyboard/mouse state handed from the USB host core to the input loop
+struct KeyboardHostReport
+{
+	GamepadState state;
+	int16_t mouseX;
+	int16_t mouseY;
+	int16_t mouseZ;
+	uint16_t mouseReports;
+};
 
 class KeyboardHostListener : public USBListener {
 public:// USB Listener Features
@@ -35,31 +51,20 @@ public:// USB Listener Features
 	virtual void get_report_complete(uint8_t dev_addr, uint8_t instance, uint8_t report_id, uint8_t report_type, uint16_t len) {}
 	void process();
 private:
-	uint8_t getKeycodeFromModifier(uint8_t modifier);
+	void mapKey(uint8_t key, uint8_t dpad, uint32_t buttons);
+	bool parseKeyboardDescriptor(uint8_t const* desc_report, uint16_t desc_len);
     void preprocess_report();
 	void process_kbd_report(uint8_t dev_addr, hid_keyboard_report_t const *report);
+	void process_nkro_report(uint8_t const* report, uint16_t len);
+	void post_report();
     void process_mouse_report(uint8_t dev_addr, hid_mouse_report_t const *report);
-	KeyboardButtonMapping _keyboard_host_mapDpadUp;
-	KeyboardButtonMapping _keyboard_host_mapDpadDown;
-	KeyboardButtonMapping _keyboard_host_mapDpadLeft;
-	KeyboardButtonMapping _keyboard_host_mapDpadRight;
-	KeyboardButtonMapping _keyboard_host_mapButtonB1;
-	KeyboardButtonMapping _keyboard_host_mapButtonB2;
-	KeyboardButtonMapping _keyboard_host_mapButtonB3;
-	KeyboardButtonMapping _keyboard_host_mapButtonB4;
-	KeyboardButtonMapping _keyboard_host_mapButtonL1;
-	KeyboardButtonMapping _keyboard_host_mapButtonR1;
-	KeyboardButtonMapping _keyboard_host_mapButtonL2;
-	KeyboardButtonMapping _keyboard_host_mapButtonR2;
-	KeyboardButtonMapping _keyboard_host_mapButtonS1;
-	KeyboardButtonMapping _keyboard_host_mapButtonS2;
-	KeyboardButtonMapping _keyboard_host_mapButtonL3;
-	KeyboardButtonMapping _keyboard_host_mapButtonR3;
-	KeyboardButtonMapping _keyboard_host_mapButtonA1;
-	KeyboardButtonMapping _keyboard_host_mapButtonA2;
-	KeyboardButtonMapping _keyboard_host_mapButtonA3;
-	KeyboardButtonMapping _keyboard_host_mapButtonA4;
+	KeyboardKeyMask _keyboard_host_keymap[256];
+	KeyboardReportField _keyboard_host_fields[KEYBOARD_HOST_MAX_REPORT_FIELDS];
+	uint8_t _keyboard_host_field_count;
+	bool _keyboard_host_report_ids;
 	GamepadState _keyboard_host_state;
+	USBListenerMailbox<KeyboardHostReport> _keyboard_host_mailbox;
+	KeyboardHostReport _keyboard_host_report;
 	bool _keyboard_host_mounted;
     uint8_t _keyboard_dev_addr;
     uint8_t _keyboard_instance;
@@ -72,7 +77,8 @@ private:
     int16_t mouseX;
     int16_t mouseY;
     int16_t mouseZ;
-    bool mouseActive;
+    uint16_t mouseReports;
+    uint16_t mouseReportsSeen;
 };
 
 #endif  // _KeyboardHost_H_
\ No newline at end of file
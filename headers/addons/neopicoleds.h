@@ -170,16 +170,21 @@ public:
 
 #define NeoPicoLEDName "NeoPicoLED"
 
+// suspended, brightness, turbo, status light, then one level per player LED
+#define NEOPICO_OVERLAY_STATE_SIZE (4 + PLED_COUNT)
+
 // NeoPico LED Addon
 class NeoPicoLEDAddon : public GPAddon {
 public:
 	virtual bool available();
 	virtual void setup();
 	virtual void preprocess() {}
+	virtual bool hasPreprocess() { return false; }
 	virtual void process();
+	virtual absolute_time_t nextDeadline();
 	virtual std::string name() { return NeoPicoLEDName; }
 	void configureLEDs();
-	uint32_t frame[100];
+	std::vector<uint32_t> frame; // one entry per LED on the chain, sized in configureLEDs
 private:
 	std::vector<uint8_t> * getLEDPositions(std::string button, std::vector<std::vector<uint8_t>> *positions);
 	std::vector<std::vector<Pixel>> generatedLEDButtons(std::vector<std::vector<uint8_t>> *positions);
@@ -190,7 +195,7 @@ private:
 	uint8_t setupButtonPositions();
 	const uint32_t intervalMS = 10;
 	absolute_time_t nextRunTime;
-	uint8_t ledCount;
+	uint16_t ledCount;
 	PixelMatrix matrix;
 	NeoPico *neopico;
 	InputMode inputMode; // HACK
@@ -199,6 +204,9 @@ private:
 	AnimationStation as;
 	std::map<std::string, int> buttonPositions;
 	bool turnOffWhenSuspended;
+	bool frameDirty = true;
+	uint32_t lastButtonState = 0;
+	uint32_t lastOverlayState[NEOPICO_OVERLAY_STATE_SIZE] = {};
     PLEDType ledType;
 };
 
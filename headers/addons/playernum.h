@@ -24,6 +24,7 @@ public:
 	virtual void setup();       // Analog Setup
 	virtual void process();     // Analog Process
 	virtual void preprocess() {}
+	virtual bool hasPreprocess() { return false; }
     virtual std::string name() { return PlayerNumName; }
 private:
 	void handleLED(int);
@@ -30,6 +30,11 @@ public:
 // Player LED Module
 #define PLEDName "PLED"
 
+// How often PWM player LED blink animations are stepped
+#ifndef PLED_PWM_INTERVAL_MS
+#define PLED_PWM_INTERVAL_MS 10
+#endif
+
 // Player LED Module
 class PlayerLEDAddon : public GPAddon
 {
@@ -37,7 +42,9 @@ public:
 	virtual bool available();
 	virtual void setup();
 	virtual void preprocess() {}
+	virtual bool hasPreprocess() { return false; }
 	virtual void process();
+	virtual absolute_time_t nextDeadline();
 	virtual std::string name() { return PLEDName; }
 	PlayerLEDAddon() {
 		type = static_cast<PLEDType>(Storage::getInstance().getLedOptions().pledType);
@@ -33,7 +33,9 @@ class ReactiveLEDAddon : public GPAddon
         virtual bool available();
         virtual void setup();
         virtual void preprocess() {}
+        virtual bool hasPreprocess() { return false; }
         virtual void process();
+        virtual absolute_time_t nextDeadline();
         virtual std::string name() { return ReactiveLEDName; }
     private:
         struct ReactiveLEDPinState {
@@ -42,6 +44,8 @@ class ReactiveLEDAddon : public GPAddon
             ReactiveLEDMode modeUp = ReactiveLEDMode::REACTIVE_LED_STATIC_OFF;
             GpioAction action = GpioAction::NONE;
             uint8_t value = 0;
+            int16_t lastValue = -1;  // last level written to the PWM slice
+            uint32_t buttonMask = 0; // action as a bit in the (dpad << 16) | buttons state word
             bool currState = false;
             bool prevState = false;
             uint32_t lastUpdate;
@@ -49,8 +53,12 @@ class ReactiveLEDAddon : public GPAddon
         };
 
         ReactiveLEDPinState ledPins[REACTIVE_LED_COUNT];
+        uint32_t lastButtonState = 0;
+        uint32_t fadingLEDs = 0;
 
         void setLEDByMode(ReactiveLEDPinState &ledState, bool pressed);
+        bool isFading(const ReactiveLEDPinState &ledState);
+        static uint32_t getButtonMask(GpioAction action);
 };
 
 #endif
\ No newline at end of file
@@ -41,6 +41,7 @@ public:
 	virtual bool available();
 	virtual void setup();       // Reverse Button Setup
 	virtual void preprocess() {}
+	virtual bool hasPreprocess() { return false; }
 	virtual void process();     // Reverse process
     virtual std::string name() { return ReverseName; }
 private:
@@ -6,6 +6,8 @@
 #include "GamepadEnums.h"
 #include "types.h"
 
+#include "hardware/pio.h"
+
 #ifndef ROTARY_ENCODER_ENABLED
 #define ROTARY_ENCODER_ENABLED 0
 #endif
@@ -86,6 +88,7 @@ public:
     virtual bool available();
 	virtual void setup();       // Rotary Setup
     virtual void preprocess() {}
+    virtual bool hasPreprocess() { return false; }
 	virtual void process();     // Rotary process
     virtual std::string name() { return RotaryEncoderName; }
 
@@ -111,6 +114,10 @@ public:
         uint32_t updateTime = 0;
         uint32_t changeTime = 0;
         uint8_t delay = 1;
+        // hardware decoder, used when pinA and pinB are adjacent
+        int8_t sm = -1;
+        int8_t direction = 1;
+        int32_t count = 0;
     } EncoderPinState;
 private:
     EncoderPinState encoderState[MAX_ENCODERS];
@@ -128,6 +135,10 @@ private:
     int8_t mapEncoderValueDPad(int8_t index, int32_t encoderValue, uint16_t ppr);
 
     int8_t getEncoderIndexByPin(uint8_t pin);
+
+    bool setupHardwareDecoder(uint8_t index);
+    bool isUSBHostPIO(PIO pio);
+    PIO encoderPio = nullptr;
     
     bool dpadUp = false;
     bool dpadDown = false;
@@ -31,6 +31,7 @@ public:
 	virtual void setup();       // SliderSOCD Button Setup
     virtual void reinit();
     virtual void preprocess() {}
+    virtual bool hasPreprocess() { return false; }
 	virtual void process();     // SliderSOCD process
     virtual std::string name() { return SliderSOCDName; }
 private:
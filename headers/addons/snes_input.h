@@ -28,17 +28,23 @@
 #define SNES_PAD_DATA_PIN -1
 #endif
 
+// The pad is polled by the core0 task runner at this rate
+#ifndef SNES_PAD_POLL_INTERVAL_US
+#define SNES_PAD_POLL_INTERVAL_US 1000
+#endif
+
 class SNESpadInput : public GPAddon {
 public:
 	virtual bool available();
 	virtual void setup();       // SNESpad Setup
 	virtual void process();     // SNESpad Process
 	virtual void preprocess() {}
+	virtual bool hasPreprocess() { return false; }
 	virtual std::string name() { return SNESpadName; }
 private:
+    void poll();
+
     SNESpad * snes;
-    uint32_t uIntervalMS;
-    uint32_t nextTimer;
 
     bool buttonA = false;
     bool buttonB = false;
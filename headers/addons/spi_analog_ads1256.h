@@ -37,6 +37,7 @@ public:
 	virtual bool available();
 	virtual void setup();       // Analog Setup
 	virtual void preprocess() {}
+	virtual bool hasPreprocess() { return false; }
 	virtual void process();     // Analog Process
     virtual std::string name() { return SPIAnalog1256Name; }
 private:
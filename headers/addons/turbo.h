@@ -105,6 +105,7 @@ public:
     virtual void setup();       // TURBO Button Setup
     virtual void reinit();
     virtual void preprocess() {}
+    virtual bool hasPreprocess() { return false; }
     virtual void process();     // TURBO Setting of buttons (Enable/Disable)
     virtual std::string name() { return TurboName; }
 
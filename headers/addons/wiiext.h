@@ -38,6 +38,14 @@
 #define WII_EXTENSION_I2C_SPEED 400000
 #endif
 
+// The extension is polled by the core0 task runner at this rate
+#ifndef WII_EXTENSION_POLL_INTERVAL_US
+#define WII_EXTENSION_POLL_INTERVAL_US 1000
+#endif
+
+// Fractional bits of the compiled raw analog scaling, one step of the extension's 10 bit sticks
+#define WII_ANALOG_SCALE_SHIFT 10
+
 #define WII_SET_MASK(bits, check, val) ((check) ? ((bits) |= (val)) : ((bits) &= ~(val)))
 
 typedef enum {
@@ -73,10 +81,53 @@ typedef struct {
     std::unordered_map<uint16_t, WiiAnalogAxis> analogMap;
 } WiiExtensionConfig;
 
+// One extension button and the gamepad masks it sets
+typedef struct {
+    uint8_t source;         // index into the extension's buttons[]
+    uint8_t dpadMask;
+    uint32_t buttonMask;
+} WiiButtonDecode;
+
+// One extension analog. value = (raw * multiplier + offset) >> WII_ANALOG_SCALE_SHIFT spreads
+// a stick over the joystick range, Y inverted, and leaves a trigger as read.
+typedef struct {
+    uint8_t source;         // index into the extension's analogState[]
+    int32_t multiplier;
+    int32_t offset;
+} WiiAnalogDecode;
+
+// The analogs given one axis type in the config. Their values are averaged, then mapped from the
+// range of the first one to base +/- average * scale / inputRange, kept within low and high. base,
+// low and high are relative to the center of the target axis. Dpad axes compare the average
+// against low and high instead.
+typedef struct {
+    uint8_t target;         // WiiAnalogType
+    uint8_t first;          // index of its first analog in the decoder's analogs[]
+    uint8_t count;
+    bool negative;
+    uint32_t scale;
+    uint32_t inputRange;
+    int32_t base;
+    int32_t low;
+    int32_t high;
+} WiiAxisDecode;
+
+// Layout of the connected extension, compiled from its config when the extension is identified
 typedef struct {
-    uint16_t analogInput;
-    uint16_t analogValue;
-} WiiAnalogChange;
+    int8_t extensionType;
+    uint16_t joystickMid;
+    uint8_t buttonCount;
+    uint8_t analogCount;
+    uint8_t axisCount;
+    uint16_t axisMask;      // bit per WiiAnalogType axis with at least one source
+    bool hasAnalogTriggers;
+    bool hasAccelerometer;
+    bool hasGyroscope;
+    bool hasTouch;
+    WiiButtonDecode buttons[WiiButtons::WII_MAX_BUTTONS];
+    WiiAnalogDecode analogs[WiiAnalogs::WII_MAX_ANALOGS];
+    WiiAxisDecode axes[WiiAnalogs::WII_MAX_ANALOGS];
+} WiiExtensionDecoder;
 
 class WiiExtensionInput : public GPAddon {
 public:
@@ -84,11 +135,10 @@ public:
     virtual void setup();       // WiiExtension Setup
     virtual void process();     // WiiExtension Process
     virtual void preprocess() {}
+    virtual bool hasPreprocess() { return false; }
     virtual std::string name() { return WiiExtensionName; }
 private:
     WiiExtensionDevice * wii;
-    uint32_t uIntervalMS;
-    uint32_t nextTimer;
 
     // controller ID = config
     // defaults if no defined config
@@ -293,100 +343,15 @@ private:
             }
         },
     };
-    WiiExtensionConfig* currentConfig = NULL;
-
-    bool buttonC = false;
-    bool buttonZ = false;
-
-    bool buttonA = false;
-    bool buttonB = false;
-    bool buttonX = false;
-    bool buttonY = false;
-    bool buttonL = false;
-    bool buttonZL = false;
-    bool buttonR = false;
-    bool buttonZR = false;
-
-    bool buttonSelect = false;
-    bool buttonStart = false;
-    bool buttonHome = false;
-
-    bool dpadUp     = false;
-    bool dpadDown   = false;
-    bool dpadLeft   = false;
-    bool dpadRight  = false;
-
-    bool isAnalogTriggers = false;
-    bool isGyroscope = false;
-    bool isAccelerometer = false;
-    bool isTouch = false;
-
-    uint16_t triggerLeft  = 0;
-    uint16_t triggerRight = 0;
-    uint16_t lastTriggerLeft  = 0;
-    uint16_t lastTriggerRight = 0;
-    uint16_t whammyBar    = 0;
-
-    uint16_t leftX = 0;
-    uint16_t lastLeftX = 0;
-
-    uint16_t leftY = 0;
-    uint16_t lastLeftY = 0;
-
-    uint16_t rightX = 0;
-    uint16_t lastRightX = 0;
-
-    uint16_t rightY = 0;
-    uint16_t lastRightY = 0;
-
-    uint16_t accelerometerX = 0;
-    uint16_t accelerometerY = 0;
-    uint16_t accelerometerZ = 0;
-
-    uint16_t gyroscopeX = 0;
-    uint16_t gyroscopeY = 0;
-    uint16_t gyroscopeZ = 0;
-
-    uint16_t touchX = 0;
-    uint16_t touchY = 0;
-    uint16_t touchZ = 0;
-    bool touchPressed = false;
-
-    std::map<uint16_t, std::vector<WiiAnalogChange>> analogChanges = {
-        {WII_ANALOG_TYPE_LEFT_STICK_X,{}},
-        {WII_ANALOG_TYPE_LEFT_STICK_Y,{}},
-        {WII_ANALOG_TYPE_RIGHT_STICK_X,{}},
-        {WII_ANALOG_TYPE_RIGHT_STICK_Y,{}},
-        {WII_ANALOG_TYPE_DPAD_X,{}},
-        {WII_ANALOG_TYPE_DPAD_Y,{}},
-        {WII_ANALOG_TYPE_LEFT_TRIGGER,{}},
-        {WII_ANALOG_TYPE_RIGHT_TRIGGER,{}},
-
-        {WII_ANALOG_TYPE_LEFT_STICK_X_PLUS,{}},
-        {WII_ANALOG_TYPE_LEFT_STICK_X_MINUS,{}},
-        {WII_ANALOG_TYPE_LEFT_STICK_Y_PLUS,{}},
-        {WII_ANALOG_TYPE_LEFT_STICK_Y_MINUS,{}},
-        {WII_ANALOG_TYPE_RIGHT_STICK_X_PLUS,{}},
-        {WII_ANALOG_TYPE_RIGHT_STICK_X_MINUS,{}},
-        {WII_ANALOG_TYPE_RIGHT_STICK_Y_PLUS,{}},
-        {WII_ANALOG_TYPE_RIGHT_STICK_Y_MINUS,{}},
-    };
-
-    uint16_t map(uint16_t x, uint16_t in_min, uint16_t in_max, uint16_t out_min, uint16_t out_max);
-    uint16_t bounds(uint16_t x, uint16_t out_min, uint16_t out_max);
+    WiiExtensionDecoder decoder;
 
     void update();
+    void compileDecoder(int8_t extensionType, uint16_t joystickMid);
+    void setAxisDecode(WiiAxisDecode& axis, uint16_t axisType, bool isTriggerInput);
     void setControllerButton(uint16_t controllerID, uint16_t buttonID, uint32_t buttonMask);
     void setControllerAnalog(uint16_t controllerID, uint16_t analogID, uint32_t axisType);
-    void setControllerStickMode(uint16_t controllerID, uint16_t analogID, uint32_t axisType);
-    void setButtonState(bool buttonState, uint16_t buttonMask);
-    void queueAnalogChange(uint16_t analogInput, uint16_t analogValue, uint16_t lastAnalogValue);
-    void updateAnalogState();
-    void updateMotionState();
+    void updateMotionState(Gamepad * gamepad, ExtensionBase * controller);
     void reloadConfig();
-
-    uint16_t getAverage(std::vector<WiiAnalogChange> const& changes);
-    uint16_t getDelta(std::vector<uint16_t> const& changes, uint16_t baseValue);
 };
 
 #endif  // _WIIExtensionAddon_H
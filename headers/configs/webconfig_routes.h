@@ -0,0 +1,83 @@
+#ifndef _WEBCONFIG_ROUTES_H_
+#define _WEBCONFIG_ROUTES_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+// Perfect hash over the webconfig routes. Any route type with a `path` member works, the seed
+// is searched at compile time so resolving a request is one hash, one slot read and one strcmp.
+
+// FNV-1a, evaluated at compile time for the route table and at runtime for the requested path
+static constexpr uint32_t routeHash(const char* str, uint32_t seed)
+{
+    uint32_t hash = 2166136261u ^ seed;
+    while (*str)
+    {
+        hash ^= static_cast<uint8_t>(*str++);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+static constexpr size_t routeTableSize(size_t numRoutes)
+{
+    // 8x oversized so that a collision free seed is found after a handful of attempts
+    size_t size = 1;
+    while (size < numRoutes * 8)
+        size <<= 1;
+    return size;
+}
+
+template <size_t NumRoutes>
+struct RouteTable
+{
+    static constexpr size_t size = routeTableSize(NumRoutes);
+    static constexpr uint8_t emptySlot = 0xFF;
+    static_assert(NumRoutes < emptySlot, "Too many routes for 8 bit route table slots");
+
+    bool valid = false;
+    uint32_t seed = 0;
+    uint8_t slots[size] = {};
+};
+
+// Searches for a seed that maps every route into its own slot
+template <typename Route, size_t NumRoutes>
+static constexpr RouteTable<NumRoutes> makeRouteTable(const Route (&routeDefs)[NumRoutes])
+{
+    RouteTable<NumRoutes> table;
+    for (uint32_t seed = 0; seed < 1024; seed++)
+    {
+        for (size_t i = 0; i < table.size; i++)
+            table.slots[i] = table.emptySlot;
+
+        bool collision = false;
+        for (size_t i = 0; i < NumRoutes && !collision; i++)
+        {
+            const size_t slot = routeHash(routeDefs[i].path, seed) & (table.size - 1);
+            if (table.slots[slot] != table.emptySlot)
+                collision = true;
+            else
+                table.slots[slot] = static_cast<uint8_t>(i);
+        }
+
+        if (!collision)
+        {
+            table.valid = true;
+            table.seed = seed;
+            return table;
+        }
+    }
+    return table;
+}
+
+template <typename Route, size_t NumRoutes>
+static const Route* findRoute(const RouteTable<NumRoutes>& table, const Route (&routeDefs)[NumRoutes], const char* name)
+{
+    const uint8_t index = table.slots[routeHash(name, table.seed) & (table.size - 1)];
+    if (index == table.emptySlot || strcmp(routeDefs[index].path, name) != 0)
+        return nullptr;
+    return &routeDefs[index];
+}
+
+#endif
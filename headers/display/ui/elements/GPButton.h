@@ -9,15 +9,19 @@
 class GPButton : public GPWidget {
     public:
         void draw();
-        GPButton* setSize(uint16_t sizeX, uint16_t sizeY) { this->_sizeX = sizeX; this->_sizeY = sizeY; return this; }
-        GPButton* setInputMask(int16_t inputMask) { this->_inputMask = inputMask; return this; }
-        GPButton* setInputDirection(bool inputDirection) { this->_inputDirection = inputDirection; return this; }
-        GPButton* setInputType(GPElement inputType) { this->_inputType = inputType; return this; }
-        GPButton* setAngle(double angle) { this->_angle = angle; return this; }
-        GPButton* setAngleEnd(double angleEnd) { this->_angleEnd = angleEnd; return this; }
-        GPButton* setClosed(bool closed) { this->_closed = closed; return this; }
-        GPButton* setShape(GPShape_Type shape) { this->_shape = shape; return this; }
+        bool getStateKey(uint32_t& key);
+        GPButton* setSize(uint16_t sizeX, uint16_t sizeY) { this->_sizeX = sizeX; this->_sizeY = sizeY; invalidate(); return this; }
+        GPButton* setInputMask(int16_t inputMask) { this->_inputMask = inputMask; invalidate(); return this; }
+        GPButton* setInputDirection(bool inputDirection) { this->_inputDirection = inputDirection; invalidate(); return this; }
+        GPButton* setInputType(GPElement inputType) { this->_inputType = inputType; invalidate(); return this; }
+        GPButton* setAngle(double angle) { this->_angle = angle; invalidate(); return this; }
+        GPButton* setAngleEnd(double angleEnd) { this->_angleEnd = angleEnd; invalidate(); return this; }
+        GPButton* setClosed(bool closed) { this->_closed = closed; invalidate(); return this; }
+        GPButton* setShape(GPShape_Type shape) { this->_shape = shape; invalidate(); return this; }
     private:
+        bool getPressed();
+        bool getTurbo();
+
         uint16_t _sizeX = 0;
         uint16_t _sizeY = 0;
         double _angle = 0;
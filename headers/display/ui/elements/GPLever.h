@@ -6,13 +6,17 @@
 class GPLever : public GPWidget {
     public:
         void draw();
-        void setRadius(uint16_t radius) { this->_radius = radius; }
-        void setInputType(uint16_t inputType) { this->_inputType = inputType; }
-        void setShowCardinal(bool show) { this->_showCardinal = show; }
-        void setShowOrdinal(bool show) { this->_showOrdinal = show; }
+        bool getStateKey(uint32_t& key);
+        void setRadius(uint16_t radius) { this->_radius = radius; invalidate(); }
+        void setInputType(uint16_t inputType) { this->_inputType = inputType; invalidate(); }
+        void setShowCardinal(bool show) { this->_showCardinal = show; invalidate(); }
+        void setShowOrdinal(bool show) { this->_showOrdinal = show; invalidate(); }
 
         void setDirectionMasks(int32_t upMask, int32_t downMask, int32_t leftMask, int32_t rightMask);
     private:
+        uint8_t getDirections();
+        void getAnalog(uint16_t& analogX, uint16_t& analogY);
+
         uint16_t _radius = 0;
         uint16_t _inputType = 0;
         bool _showCardinal = false;
@@ -15,8 +15,12 @@ class GPScreen : public GPWidget {
     protected:
         virtual void drawScreen() = 0;
         GPWidget * addElement(GPWidget* element) {
-            displayList.push_back(element);
-            element->setID(displayList.size()-1);
+            // keep the display list in draw order (higher priority first, then insertion order)
+            std::vector<GPWidget*>::iterator it = displayList.begin();
+            while ((it != displayList.end()) && ((*it)->getPriority() >= element->getPriority())) ++it;
+            element->setID(displayList.size());
+            displayList.insert(it, element);
+            widgetLayerValid = false;
             return element;
         }
         void clearElements() {
@@ -24,9 +28,14 @@ class GPScreen : public GPWidget {
                 delete (*it);
             }
             displayList.clear();
+            widgetLayerValid = false;
         }
     private:
         std::vector<GPWidget*> displayList;
+
+        // frame buffer as it stood after the last full widget pass
+        std::vector<uint8_t> widgetLayer;
+        bool widgetLayerValid = false;
 };
 
-#endif
\ No newline at end of file
+#endif
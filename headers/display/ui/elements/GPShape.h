@@ -7,11 +7,12 @@
 class GPShape : public GPWidget {
     public:
         void draw();
-        GPShape* setSize(uint16_t sizeX, uint16_t sizeY) { this->_sizeX = sizeX; this->_sizeY = sizeY; return this; }
-        GPShape* setAngle(double angle) { this->_angle = angle; return this; }
-        GPShape* setAngleEnd(double angleEnd) { this->_angleEnd = angleEnd; return this; }
-        GPShape* setClosed(bool closed) { this->_closed = closed; return this; }
-        GPShape* setShape(GPShape_Type shape) { this->_shape = shape; return this; }
+        bool getStateKey(uint32_t& key) { key = 0; return true; }
+        GPShape* setSize(uint16_t sizeX, uint16_t sizeY) { this->_sizeX = sizeX; this->_sizeY = sizeY; invalidate(); return this; }
+        GPShape* setAngle(double angle) { this->_angle = angle; invalidate(); return this; }
+        GPShape* setAngleEnd(double angleEnd) { this->_angleEnd = angleEnd; invalidate(); return this; }
+        GPShape* setClosed(bool closed) { this->_closed = closed; invalidate(); return this; }
+        GPShape* setShape(GPShape_Type shape) { this->_shape = shape; invalidate(); return this; }
     private:
         uint16_t _sizeX = 0;
         uint16_t _sizeY = 0;
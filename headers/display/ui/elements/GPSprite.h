@@ -6,7 +6,8 @@
 class GPSprite : public GPWidget {
     public:
         void draw();
-        GPSprite* setSize(uint16_t sizeX, uint16_t sizeY) { this->_sizeX = sizeX; this->_sizeY = sizeY; return this; }
+        bool getStateKey(uint32_t& key) { key = 0; return true; }
+        GPSprite* setSize(uint16_t sizeX, uint16_t sizeY) { this->_sizeX = sizeX; this->_sizeY = sizeY; invalidate(); return this; }
     private:
         uint16_t _sizeX = 0;
         uint16_t _sizeY = 0;
@@ -11,25 +11,40 @@ class GPWidget : public GPGFX_UI {
         virtual void draw() {}
         virtual int8_t update() { return 0; }
 
-        void setPosition(uint16_t x, uint16_t y) { this->x = x; this->y = y; }
+        // widgets whose output depends only on a few input bits report them here so the
+        // screen can reuse their last rendering; returning false redraws them every frame
+        virtual bool getStateKey(uint32_t& key) { return false; }
 
-        void setStrokeColor(uint16_t color) { this->strokeColor = color; }
-        void setFillColor(uint16_t color) { this->fillColor = color; }
+        // true when the widget has to be drawn again, latching the key it will be drawn with
+        bool refreshState() {
+            uint32_t key = 0;
+            if (!getStateKey(key)) return true;
+            bool changed = this->_invalidated || (key != this->_stateKey);
+            this->_stateKey = key;
+            this->_invalidated = false;
+            return changed;
+        }
+        void invalidate() { this->_invalidated = true; }
+
+        void setPosition(uint16_t x, uint16_t y) { this->x = x; this->y = y; invalidate(); }
+
+        void setStrokeColor(uint16_t color) { this->strokeColor = color; invalidate(); }
+        void setFillColor(uint16_t color) { this->fillColor = color; invalidate(); }
 
         void setID(uint16_t id) { this->_ID = id; }
         uint16_t getID() { return this->_ID; }
         
-        void setPriority(uint16_t priority) { this->_priority = priority; }
+        void setPriority(uint16_t priority) { this->_priority = priority; invalidate(); }
         uint16_t getPriority() { return this->_priority; }
 
-        void setViewport(uint16_t top, uint16_t left, uint16_t bottom, uint16_t right) { this->_viewport.top = top; this->_viewport.left = left; this->_viewport.bottom = bottom; this->_viewport.right = right; }
-        void setViewport(GPViewport viewport) { this->_viewport = viewport; }
+        void setViewport(uint16_t top, uint16_t left, uint16_t bottom, uint16_t right) { this->_viewport.top = top; this->_viewport.left = left; this->_viewport.bottom = bottom; this->_viewport.right = right; invalidate(); }
+        void setViewport(GPViewport viewport) { this->_viewport = viewport; invalidate(); }
         GPViewport getViewport() { return this->_viewport; }
 
         double getScaleX() { return ((double)(this->getViewport().right - this->getViewport().left) / (double)(getRenderer()->getDriver()->getMetrics()->width)); }
         double getScaleY() { return ((double)(this->getViewport().bottom - this->getViewport().top) / (double)(getRenderer()->getDriver()->getMetrics()->height)); }
 
-        void setVisibility(bool visible) { this->_visibility = visible; }
+        void setVisibility(bool visible) { this->_visibility = visible; invalidate(); }
         bool getVisibility() { return this->_visibility; }
     protected:
         uint16_t x = 0;
@@ -42,6 +57,9 @@ class GPWidget : public GPGFX_UI {
         bool _visibility = true;
 
         GPViewport _viewport;
+    private:
+        uint32_t _stateKey = 0;
+        bool _invalidated = true;
 };
 
 #endif
\ No newline at end of file
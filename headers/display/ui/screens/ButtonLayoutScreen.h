@@ -16,6 +16,7 @@
 
 #define INPUT_HISTORY_MAX_INPUTS 22
 #define INPUT_HISTORY_MAX_MODES 11
+#define INPUT_HISTORY_MAX_LENGTH 64
 
 // Static to ensure memory is never doubled
 static const char * displayNames[INPUT_HISTORY_MAX_MODES][INPUT_HISTORY_MAX_INPUTS] = {
@@ -146,9 +147,10 @@ class ButtonLayoutScreen : public GPScreen {
         uint16_t inputHistoryX = 0;
         uint16_t inputHistoryY = 0;
         size_t inputHistoryLength = 0;
-        std::string historyString;
-        std::deque<std::string> inputHistory;
-        std::array<bool, INPUT_HISTORY_MAX_INPUTS> lastInput;
+        // history line as font glyph codes, oldest first, trimmed to inputHistoryLength
+        char historyLine[INPUT_HISTORY_MAX_LENGTH];
+        uint8_t historyLineLength = 0;
+        uint32_t lastInput = 0;
 
         bool bannerDisplay;
         uint8_t bannerDelay = 2;
@@ -175,6 +177,7 @@ class ButtonLayoutScreen : public GPScreen {
 
         uint16_t map(uint16_t x, uint16_t in_min, uint16_t in_max, uint16_t out_min, uint16_t out_max);
         void processInputHistory();
+        void appendInputHistory(const char* entry, uint8_t entryLength);
         bool compareCustomLayouts();
         bool pressedUp();
         bool pressedDown();
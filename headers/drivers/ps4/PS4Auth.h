@@ -3,6 +3,7 @@
 
 #include "drivers/shared/gpauthdriver.h"
 #include "mbedtls/rsa.h"
+#include "mbedtls/sha256.h"
 
 // PS4 Auth Data in a single struct
 typedef struct {
@@ -12,6 +13,14 @@ typedef struct {
     bool dongle_ready = false;
     GPAuthState passthrough_state;    // PS4 Encryption Passthrough State
     uint8_t nonce_id;                 // for nonce passing
+    // Key mode nonce handoff, written by core0 once the page is in ps4_auth_buffer:
+    //  nonce count (high byte) and pages received in order (low byte, 0xFF if out of order)
+    volatile uint16_t nonce_received = 0;
+    // Core1 only: the nonce is hashed page by page as it arrives
+    mbedtls_sha256_context nonce_sha256;
+    uint8_t nonce_hashing = 0;        // nonce count nonce_sha256 belongs to
+    uint8_t nonce_pages_hashed = 0;   // 0xFF once the digest was taken
+    uint8_t hashed_nonce[32];
 } PS4AuthData;
 
 class PS4Auth : public GPAuthDriver {
@@ -22,9 +31,11 @@ public:
     void process();
     PS4AuthData * getAuthData() { return &ps4AuthData; }
     void resetAuth();
+    void nonceReceived(uint8_t nonce_page);
 private:
     void keyModeInitialize();
     void keyModeProcess();
+    bool keyModeHashNonce();
     PS4AuthData ps4AuthData;
 };
 
@@ -42,6 +42,7 @@ public:
     virtual void process(Gamepad * gamepad);
     virtual void initializeAux();
     virtual void processAux();
+    virtual bool hasAuxWork() { return ps4AuthDriver != nullptr && ps4AuthDriver->available(); }
     virtual uint16_t get_report(uint8_t report_id, hid_report_type_t report_type, uint8_t *buffer, uint16_t reqlen);
     virtual void set_report(uint8_t report_id, hid_report_type_t report_type, uint8_t const *buffer, uint16_t bufsize);
     virtual bool vendor_control_xfer_cb(uint8_t rhport, uint8_t stage, tusb_control_request_t const *request);
@@ -61,8 +62,8 @@ private:
     TouchpadData touchpadData;
     PSSensorData sensorData;
     uint32_t last_report_timer;
-    PS4Auth * ps4AuthDriver;
-    PS4AuthData * ps4AuthData;      // PS4 Authentication Data
+    PS4Auth * ps4AuthDriver = nullptr;
+    PS4AuthData * ps4AuthData = nullptr;      // PS4 Authentication Data
     uint8_t cur_nonce_chunk;            // PS4 Encryption Nonce Chunk (Max 19)
     uint8_t cur_nonce_id;
     uint32_t controllerType;        // PS4 DS4 / PS5 Third-Party
@@ -72,7 +73,7 @@ private:
     PS4FeatureOutputReport ps4Features;
     uint8_t lastFeatures[PS4_FEATURES_SIZE] = { };
     uint8_t deviceDescriptor[sizeof(ps4_device_descriptor)];
-    bool authsent;
+    bool authsent = false;
 };
 
 #endif // _PS4_DRIVER_H_
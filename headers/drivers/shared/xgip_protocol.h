@@ -76,26 +76,40 @@ typedef struct
     packet->Header.chunked = 0;                  \
     packet->Header.length = sizeof(*packet) - sizeof(GipHeader_t);
 
+// Largest reassembled XGIP payload we accept (auth messages)
+#define GIP_MAX_DATA_SIZE 1024
+
+//  The codec never owns payload data:
+//   - outgoing data set with setData() is read in place until the last chunk was generated,
+//     so it has to stay valid and unchanged for the whole transfer. Constant descriptors are
+//     passed directly, auth messages shared between the cores are copied out first.
+//   - incoming single packets are read in place from the endpoint buffer passed to parse(),
+//     getData() is valid until that buffer is handed back to the USB stack
+//   - incoming chunks are reassembled into the buffer given to setReassemblyBuffer(), without
+//     one they are tracked (length/end of chunk) but their payload is dropped
 class XGIPProtocol {
 public:
     XGIPProtocol();
     ~XGIPProtocol();
     void reset();                               // Reset packet information
+    void setReassemblyBuffer(uint8_t * buffer, uint16_t size); // Destination for incoming chunked data
     bool parse(const uint8_t * buffer, uint16_t len); // Parse incoming packet
     bool validate();                            // is valid packet?
     bool endOfChunk();                          // Is this the end of the chunk?
     void setAttributes(uint8_t cmd, uint8_t seq, uint8_t internal, uint8_t isChunked, uint8_t needsAck);   // Set attributes for next output packet
     void incrementSequence();                   // Add 1 to sequence
-    bool setData(const uint8_t* data, uint16_t len); // Set data (buf and length)
+    bool setData(const uint8_t* data, uint16_t len); // Set data (buf and length), data is not copied
     uint8_t * generatePacket();                 // Generate output packet (chunk will generate on-going packet)
+    uint8_t * generatePacket(uint8_t * buffer); // Generate output packet straight into an endpoint or queue buffer
     uint8_t * generateAckPacket();              // Generate an ack for the last received packet
+    uint8_t * generateAckPacket(uint8_t * buffer); // Generate an ack straight into an endpoint or queue buffer
     bool validateAck(XGIPProtocol & ackPacket); // Validate an incoming ack packet against 
     uint8_t getCommand();                       // Get command of a parsed packet
     uint8_t getSequence();                      // Get sequence of a parsed packet
     uint8_t getChunked();                       // Is this packet chunked?
     uint8_t getPacketAck();                     // Did the packet require an ACK?
     uint8_t getPacketLength();                  // Get packet length of our last output
-    uint8_t * getData();                        // Get data from a packet or packet-chunk
+    const uint8_t * getData();                  // Get data from a packet or packet-chunk
     uint16_t getDataLength();                   // Get length of a packet or packet-chunk
     bool getChunkData(XGIPProtocol & packet);   // Get chunk data from incoming packet
     bool ackRequired();                         // Did our last parsed packet require an ack?
@@ -108,10 +122,12 @@ private:
     uint16_t totalDataSent;         // How much actual data have we sent?
     uint16_t numberOfChunksSent;    // How many actual chunks have we sent?
     bool chunkEnded;                // did we hit the end of the chunk successfully?
-    uint8_t packet[64];             // for output packets
+    uint8_t packet[64];             // for output packets without a caller buffer
     uint16_t packetLength;          // LAST SENT packet length
-    uint8_t data[1024];             // Total data in this packet
+    const uint8_t * data;           // Payload: caller data, endpoint buffer or reassembly buffer
     uint16_t dataLength;            // actual length of data
+    uint8_t * reassemblyBuffer;     // Incoming chunked data is written here
+    uint16_t reassemblyBufferSize;
     bool isValidPacket;             // is this a valid packet or did we get an error?
 };
 
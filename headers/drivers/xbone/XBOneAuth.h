@@ -4,39 +4,31 @@
 #include "drivers/shared/gpauthdriver.h"
 #include "drivers/shared/xgip_protocol.h"
 
+// Fixed storage for one auth message, copied in once its last chunk arrived
 class XBOneAuthBuffer {
 public:
     XBOneAuthBuffer() {
-        data = nullptr;
-        sequence = 0;
-        length = 0;
-        type = 0;
-    }
-    ~XBOneAuthBuffer(){
-        if ( data != nullptr ) {
-            delete [] data;
-        }
+        reset();
     }
 
-    void setBuffer(uint8_t * inData, uint16_t inLen, uint8_t inSeq, uint8_t inType) {
-        data = new uint8_t[inLen];
+    void setBuffer(const uint8_t * inData, uint16_t inLen, uint8_t inSeq, uint8_t inType) {
+        if ( inLen > sizeof(data) ) {
+            inLen = sizeof(data);
+        }
         length = inLen;
         sequence = inSeq;
-        type = inType;        
+        type = inType;
         memcpy(data, inData, inLen);
     }
 
+    // Data is left untouched, the forwarding side copies it out before resetting
     void reset() {
-        if ( data != nullptr ) {
-            delete [] data;
-        }
-        data = nullptr;
         sequence = 0;
         length = 0;
         type = 0;
     }
 
-    uint8_t * data;
+    uint8_t data[GIP_MAX_DATA_SIZE];
     uint8_t sequence;
     uint16_t length;
     uint8_t type;
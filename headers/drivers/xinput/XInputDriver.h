@@ -20,6 +20,7 @@ public:
     virtual void process(Gamepad * gamepad);
     virtual void initializeAux();
     virtual void processAux();
+    virtual bool hasAuxWork() { return xAuthDriver != nullptr && xAuthDriver->available(); }
     virtual uint16_t get_report(uint8_t report_id, hid_report_type_t report_type, uint8_t *buffer, uint16_t reqlen);
     virtual void set_report(uint8_t report_id, hid_report_type_t report_type, uint8_t const *buffer, uint16_t bufsize) {}
     virtual bool vendor_control_xfer_cb(uint8_t rhport, uint8_t stage, tusb_control_request_t const *request);
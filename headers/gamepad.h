@@ -58,6 +58,11 @@ public:
 	 */
 	bool hasRightAnalogStick {false};
 
+	/**
+	 * @brief Flag set while a 4-way filter produced the dpad, so the report latch keeps it whole.
+	 */
+	bool fourWayDpad {false};
+
 	/**
 	 * @brief Check for a button press. Used by `pressed[Button]` helper methods.
 	 */
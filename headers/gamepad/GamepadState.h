@@ -158,7 +158,35 @@ uint16_t dpadToAnalogY(uint8_t dpad);
 
 uint8_t getMaskFromDirection(DpadDirection direction);
 
-uint8_t updateDpad(uint8_t dpad, DpadDirection direction);
+/**
+ * @brief History used to resolve one d-pad source across frames.
+ *
+ * Both members are state indices into the precomputed SOCD and 4-way
+ * transition tables, so every d-pad source (the gamepad, Dual Directional)
+ * keeps its own history but resolves through the same tables.
+ */
+struct DpadHistory
+{
+	uint8_t socd = 0;
+	uint8_t fourWay = 0;
+};
+
+/**
+ * @brief SOCD rules a d-pad source is cleaned with.
+ *
+ * Dual Directional keeps the behavior of the cleaners it had before the
+ * shared tables: with first/last input priority and no history, its own
+ * d-pad passes L+R through, and mixing also passes L+R and picks up (last)
+ * or down (first) for U+D. Mixing in up priority and neutral is stateless
+ * and up priority drops left/right when up and down meet.
+ */
+enum SOCDRules
+{
+	SOCD_RULES_GAMEPAD,
+	SOCD_RULES_DUAL,        // Dual Directional's own d-pad
+	SOCD_RULES_MIXED,       // Dual Directional combined with the gamepad
+	SOCD_RULES_COUNT
+};
 
 /**
  * @brief Filter diagonals out of the dpad, making the device work as a 4-way lever.
@@ -169,6 +197,7 @@ uint8_t updateDpad(uint8_t dpad, DpadDirection direction);
  * @return uint8_t The new dpad value.
  */
 uint8_t filterToFourWayMode(uint8_t dpad);
+uint8_t filterToFourWayMode(uint8_t dpad, DpadHistory & history);
 
 /**
  * @brief Run SOCD cleaning against a D-pad value.
@@ -178,3 +207,4 @@ uint8_t filterToFourWayMode(uint8_t dpad);
  * @return uint8_t The clean D-pad value.
  */
 uint8_t runSOCDCleaner(SOCDMode mode, uint8_t dpad);
+uint8_t runSOCDCleaner(SOCDMode mode, uint8_t dpad, DpadHistory & history, SOCDRules rules = SOCD_RULES_GAMEPAD);
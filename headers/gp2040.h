@@ -21,6 +21,9 @@ public:
     GP2040(){}
     ~GP2040(){}
     void setup();           // setup core0
+    void startUSB();        // start the USB device stack
+    void serviceUSB();      // USB device upkeep while core0 finishes its setup
+    void setupDeferredAddons(); // slow add-on bring-up, after startUSB()
     void run();             // loop core0
 private:
     Gamepad snapshot;
@@ -9,6 +9,13 @@
 #include "addonmanager.h"
 #include "drivermanager.h"
 
+// Longest Core1 sleeps between passes when no add-on deadline or Core0 wake comes sooner.
+// Bounds how late state Core1 polls without a wake (host rumble, player ID, auth LEDs)
+// is picked up. 0 keeps Core1 polling continuously.
+#ifndef CORE1_IDLE_MAX_MS
+#define CORE1_IDLE_MAX_MS 20
+#endif
+
 class GP2040Aux {
 public:
 	GP2040Aux();
@@ -16,10 +23,13 @@ public:
     void setup();           // setup core1
     void run();             // loop core1
     bool ready(){ return isReady; }
+    bool authReady(){ return isAuthReady; } // auth and add-on event handlers are set up, core0 may start USB and its loop
 private:
+    void idle();
     GPDriver * inputDriver;
     AddonManager addons;
-    bool isReady;
+    volatile bool isReady;
+    volatile bool isAuthReady;
 };
 
 #endif
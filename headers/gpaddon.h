@@ -3,6 +3,7 @@
 
 #include "gamepad.h"
 #include "usblistener.h"
+#include "pico/time.h"
 
 #include <string>
 
@@ -23,6 +24,18 @@ public:
      */
     virtual void reinit() { }
 
+    // Add-ons with an empty preprocess() or process() return false here, so the
+    // AddonManager leaves them out of that call list entirely
+    virtual bool hasPreprocess() { return true; }
+    virtual bool hasProcess() { return true; }
+
+    /**
+     * Core1 add-ons: the time process() next needs to run when nothing changes on Core0.
+     * nil_time (the default) asks for every loop pass, at_the_end_of_time means the add-on
+     * only reacts to Core0 state, which wakes Core1 through System::wakeCore1().
+     */
+    virtual absolute_time_t nextDeadline() { return nil_time; }
+
     // For add-ons that require a USB-host listener, get listener
     virtual USBListener * getListener() { return listener; }
 
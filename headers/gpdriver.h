@@ -17,6 +17,13 @@
 
 #include "usblistener.h"
 
+// Longest time press/release edges are held for a busy IN endpoint before the
+// latch falls back to live input (keeps an unmounted or stalled device from
+// replaying stale taps later)
+#ifndef REPORT_LATCH_TIMEOUT_MS
+#define REPORT_LATCH_TIMEOUT_MS 50
+#endif
+
 // Forward declare gamepad
 class Gamepad;
 
@@ -29,6 +36,8 @@ public:
     virtual void initializeAux() = 0;
     virtual void process(Gamepad * gamepad) = 0;
     virtual void processAux() = 0;
+    // True while processAux() has work to poll (console auth), which keeps Core1 from idling
+    virtual bool hasAuxWork() { return false; }
     virtual uint16_t get_report(uint8_t report_id, hid_report_type_t report_type, uint8_t *buffer, uint16_t reqlen) = 0;
     virtual void set_report(uint8_t report_id, hid_report_type_t report_type, uint8_t const *buffer, uint16_t bufsize) = 0;
     virtual bool vendor_control_xfer_cb(uint8_t rhport, uint8_t stage, tusb_control_request_t const *request) = 0;
@@ -40,8 +49,50 @@ public:
     virtual uint16_t GetJoystickMidValue() = 0;
     const usbd_class_driver_t * get_class_driver() { return &class_driver; }
     virtual USBListener * get_usb_auth_listener() = 0;
+
+    // Runs process() against the latched button/dpad state when the driver has the
+    // report latch enabled, then restores the live state for the rest of the loop
+    void processLatched(Gamepad * gamepad);
 protected:
+    // Drivers that call reportSent() after every successful IN transfer may enable
+    // the latch, which holds press and release edges since the last sent report until
+    // a report carries them, so a tap shorter than a host poll still reaches the host.
+    //
+    // What it guarantees (tests/report_latch_test.cpp):
+    // - every press and release reaches the host as long as an input is pressed, or a
+    //   4-way dpad moves to a new direction, at least two host polls after its previous
+    //   change; how briefly it is held does not matter;
+    // - closer taps on the same input can merge, each report carries at most one of its
+    //   changes and a tap shorter than a poll owes the next report its release;
+    // - no report shows a press that did not happen, or opposing directions together;
+    // - with a 4-way dpad the latch holds whole dpad values, so reports only carry
+    //   directions the filter produced: the first direction since the last report, then
+    //   the live one;
+    // - edges are kept for at most REPORT_LATCH_TIMEOUT_MS, an endpoint that stays
+    //   busy longer than that loses them.
+    void reportSent();
+
     usbd_class_driver_t class_driver;
+    bool reportLatchEnabled = false;
+private:
+    void latchReportState(GamepadState & state, bool fourWayDpad);
+    void restartLatch();
+    void latchDpadValue(uint8_t dpad);
+
+    uint32_t sentButtons = 0;
+    uint32_t anyButtons = 0;
+    uint32_t allButtons = 0;
+    uint32_t latchedButtons = 0;
+    uint32_t liveButtons = 0;
+    uint8_t sentDpad = 0;
+    uint8_t anyDpad = 0;
+    uint8_t allDpad = 0;
+    uint8_t latchedDpad = 0;
+    uint8_t liveDpad = 0;
+    uint8_t movedDpad = 0; // first direction since the report that differs from it
+    bool dpadMoved = false; // the dpad left the reported value, even if only to neutral
+    uint32_t latchStartMs = 0;
+    bool firstReportSent = false;
 };
 
 #endif
@@ -22,7 +22,7 @@ class GPGFX_DisplayBase : public I2CDeviceBase {
 
         virtual void drawPixel(uint8_t x, uint8_t y, uint32_t color) {}
 
-        virtual void drawText(uint8_t x, uint8_t y, std::string text, uint8_t invert = 0) {}
+        virtual void drawText(uint8_t x, uint8_t y, const std::string& text, uint8_t invert = 0) {}
 
         virtual void drawLine(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint32_t color, uint8_t filled) {}
 
@@ -38,6 +38,10 @@ class GPGFX_DisplayBase : public I2CDeviceBase {
 
         virtual void drawBuffer(uint8_t *pBuffer) {}
 
+        // direct access to the frame buffer, for callers that cache finished layers
+        virtual uint8_t* getFrameBuffer() { return nullptr; }
+        virtual uint16_t getFrameBufferSize() { return 0; }
+
         void setMetrics(GPGFX_DisplayMetrics* metrics) { this->_metrics = metrics; }
         GPGFX_DisplayMetrics* getMetrics() { return this->_metrics; }
 
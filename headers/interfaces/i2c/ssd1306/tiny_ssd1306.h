@@ -20,7 +20,7 @@ class GPGFX_TinySSD1306 : public GPGFX_DisplayBase {
 
         void drawPixel(uint8_t x, uint8_t y, uint32_t color);
 
-        void drawText(uint8_t x, uint8_t y, std::string text, uint8_t invert = 0);
+        void drawText(uint8_t x, uint8_t y, const std::string& text, uint8_t invert = 0);
 
         void drawLine(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint32_t color, uint8_t filled);
 
@@ -36,6 +36,9 @@ class GPGFX_TinySSD1306 : public GPGFX_DisplayBase {
 
         void drawBuffer(uint8_t *pBuffer);
 
+        uint8_t* getFrameBuffer() { return this->frameBuffer; }
+        uint16_t getFrameBufferSize() { return MAX_SCREEN_SIZE; }
+
         bool isSH1106(int detectedDisplay);
 
         std::vector<uint8_t> getDeviceAddresses() const override {
@@ -92,6 +95,18 @@ class GPGFX_TinySSD1306 : public GPGFX_DisplayBase {
         void sendCommand(uint8_t command);
         void sendCommands(uint8_t* commands, uint16_t length);
 
+        // integer helpers that write straight into the page-organized frame buffer
+        void blitColumn(int16_t x, int16_t y, uint8_t bits, uint8_t mask);
+        void drawSpan(int16_t x1, int16_t x2, int16_t y, uint32_t color);
+        void fillRect(int16_t x1, int16_t y1, int16_t x2, int16_t y2, uint32_t color);
+        void fillPolygon(const int16_t* xVertices, const int16_t* yVertices, uint16_t sides, uint32_t color);
+
+        // angles in 1/16 degree, results scaled by 1 << TRIG_SHIFT
+        static const uint8_t TRIG_SHIFT = 14;
+        static const int32_t TRIG_FULL_TURN = 360 * 16;
+        static int32_t sinFixed(int32_t angle);
+        static int32_t cosFixed(int32_t angle);
+
         uint8_t frameBuffer[MAX_SCREEN_SIZE];
         uint8_t framePage = 0;
 
@@ -8,6 +8,13 @@
 
 #define PMGR PeripheralManager::getInstance()
 
+// PIO-USB bit-bangs full speed USB, so the system clock must be a multiple of 12 MHz
+// while USB host is enabled. 120 MHz is the closest to the stock 125 MHz; boards with
+// flash and regulator headroom can opt into 240000.
+#ifndef USB_HOST_SYS_CLOCK_KHZ
+#define USB_HOST_SYS_CLOCK_KHZ 120000
+#endif
+
 typedef struct {
     int8_t address;
     uint8_t block;
@@ -3,38 +3,41 @@
 
 #include "addons/buzzerspeaker.h"
 
+// Songs are compiled into PWM tables for both system clocks, so playback only copies
+// precomputed divider/wrap values into the slice on each note boundary.
+#define BUZZER_SONG(name, duration) \
+    constexpr auto name##Notes = buzzerNotes(BUZZER_SYS_CLOCK_HZ, name##Tones); \
+    constexpr auto name##USBHostNotes = buzzerNotes(BUZZER_USB_HOST_SYS_CLOCK_HZ, name##Tones); \
+    constexpr Song name{duration, name##Notes.size(), name##Notes.data(), name##USBHostNotes.data()};
+
 // Intro example
-Song introSong{
-    100,
-    {
-        D5,
-        AS5,
-        B5,
-        C6,
-        CS6,
-        D6,
-        DS6,
-        E6,
-        C7,
-        CS7,
-        D7,
-        DS7,
-        E7,
-        F7,
-        D8,
-        DS8,
-    }
+constexpr Tone introSongTones[] = {
+    D5,
+    AS5,
+    B5,
+    C6,
+    CS6,
+    D6,
+    DS6,
+    E6,
+    C7,
+    CS7,
+    D7,
+    DS7,
+    E7,
+    F7,
+    D8,
+    DS8,
 };
+BUZZER_SONG(introSong, 100)
 
-Song configModeSong{
-    150,
-    {
-        E5,
-        E5,
-        G4,
-        FS5,
-        E5
-    }
+constexpr Tone configModeSongTones[] = {
+    E5,
+    E5,
+    G4,
+    FS5,
+    E5
 };
+BUZZER_SONG(configModeSong, 150)
 
 #endif
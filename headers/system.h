@@ -3,6 +3,12 @@
 
 #include <cstdint>
 
+#ifndef BOOT_TIMELINE_MAX_ENTRIES
+#define BOOT_TIMELINE_MAX_ENTRIES 16
+#endif
+
+#define BOOT_TIMELINE_LABEL_SIZE 16
+
 namespace System {
     // Returns the size of on-board flash memory reserved by the config
     uint32_t getTotalFlash();
@@ -29,6 +35,27 @@ namespace System {
     void reboot(BootMode bootMode);
     // Retrieves the BootMode value from the watchdog scratch register and resets its value to BootMode::DEFAULT
     BootMode takeBootMode();
+
+    struct BootTimelineEntry {
+        char label[BOOT_TIMELINE_LABEL_SIZE];
+        uint32_t timeUs;
+    };
+
+    struct BootTimeline {
+        uint32_t magic;
+        uint8_t count[2];
+        BootTimelineEntry entries[2][BOOT_TIMELINE_MAX_ENTRIES];
+    };
+
+    // Starts a new boot timeline, keeping the previous one when the RAM holding it survived the reboot
+    void startBootTimeline();
+    // Records a named step of the boot with the time since reset, per calling core
+    void markBootTimeline(const char* label);
+    // Returns the timeline of this boot, or of the boot before it (e.g. gamepad mode before a web config reboot)
+    const BootTimeline& getBootTimeline(bool previous);
+
+    // Wakes Core1 out of its idle wait after Core0 changed something it displays
+    void wakeCore1();
 }
 
 #endif
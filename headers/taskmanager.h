@@ -0,0 +1,75 @@
+#ifndef _TASKMANAGER_H_
+#define _TASKMANAGER_H_
+
+#include <cstdint>
+#include <functional>
+#include "pico/time.h"
+
+// Task slots per core
+#ifndef TASK_MANAGER_MAX_TASKS
+#define TASK_MANAGER_MAX_TASKS 8
+#endif
+
+#define TASK_NAME_SIZE 16
+
+// Counters of one task, kept in RAM that survives a watchdog reboot so web config
+// can also show the numbers of the gamepad session before it
+struct TaskStats {
+    char name[TASK_NAME_SIZE];
+    uint32_t periodUs;      // 0 for one-shot tasks
+    uint32_t runs;
+    uint32_t misses;        // periods that passed without a run
+    uint32_t maxLateUs;     // worst start time after the deadline
+};
+
+struct TaskStatsTable {
+    uint32_t magic;
+    uint8_t count[2];
+    TaskStats tasks[2][TASK_MANAGER_MAX_TASKS];
+};
+
+// Cooperative scheduler for timed work. Tasks run from the loop of the core that
+// added them, never from an interrupt, so they may use I2C/SPI and shared state
+// just like the add-on that owns them.
+class TaskManager {
+public:
+    typedef std::function<void()> TaskFunction;
+
+    TaskManager(TaskManager const&) = delete;
+    void operator=(TaskManager const&)  = delete;
+    static TaskManager& getInstance()
+    {
+        static TaskManager instance;
+        return instance;
+    }
+
+    // Keeps the stats of the previous boot and clears the current table, call before either core adds tasks
+    void init();
+
+    // Both return the task id, or -1 when the calling core has no free task slot.
+    // A one-shot task's slot is free again once it ran.
+    int addPeriodicTask(const char* name, uint32_t periodUs, TaskFunction task);
+    int addOneShotTask(const char* name, uint32_t delayUs, TaskFunction task);
+
+    // Runs the calling core's due tasks, returns at once when none is due
+    void process();
+    // Earliest deadline of the calling core's tasks
+    absolute_time_t nextDeadline();
+
+    // Stats of this boot, or of the boot before it
+    const TaskStatsTable& getStats(bool previous);
+private:
+    TaskManager() {}
+    int addTask(const char* name, uint32_t periodUs, uint32_t delayUs, TaskFunction task);
+
+    struct Task {
+        TaskFunction function;
+        absolute_time_t deadline;
+        bool active;
+    };
+
+    Task tasks[2][TASK_MANAGER_MAX_TASKS];
+    absolute_time_t nextDue[2];
+};
+
+#endif
@@ -2,6 +2,7 @@
 #define _USBLISTENER_H_
 
 #include <cstdint>
+#include "hardware/sync.h"
 
 class USBListener
 {
@@ -16,4 +17,41 @@ public:
     virtual void get_report_complete(uint8_t dev_addr, uint8_t instance, uint8_t report_id, uint8_t report_type, uint16_t len) = 0;
 };
 
+// Hands the latest decoded host state from the USB host core (core1) to the input
+// loop (core0) without locks. The writer bumps the sequence around each copy, and
+// the reader keeps its previous snapshot when it catches a write in progress
+// instead of waiting for it.
+template <typename T>
+class USBListenerMailbox
+{
+public:
+    void post(const T& value) {
+        uint32_t seq = sequence;
+        sequence = seq + 1;
+        __dmb();
+        data = value;
+        __dmb();
+        sequence = seq + 2;
+    }
+
+    // Returns true when a newer value than the last read was copied into value
+    bool read(T& value) {
+        uint32_t seq = sequence;
+        if ((seq & 1) || seq == lastRead)
+            return false;
+        __dmb();
+        T copy = data;
+        __dmb();
+        if (sequence != seq)
+            return false;
+        value = copy;
+        lastRead = seq;
+        return true;
+    }
+private:
+    T data {};
+    volatile uint32_t sequence = 0;
+    uint32_t lastRead = 0;
+};
+
 #endif
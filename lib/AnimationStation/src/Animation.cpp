@@ -7,22 +7,25 @@
 #define PRESS_COOLDOWN_MIN 0
 
 LEDFormat Animation::format;
-std::map<uint32_t, int32_t> Animation::times = {};
-std::map<uint32_t, RGB> Animation::hitColor = {};
+std::vector<int32_t> Animation::times = {};
+std::vector<RGB> Animation::hitColor = {};
 
 Animation::Animation(PixelMatrix &matrix) : matrix(&matrix) {
-  for (size_t r = 0; r != matrix.pixels.size(); r++) {
-    for (size_t c = 0; c != matrix.pixels[r].size(); c++) {
-      if (matrix.pixels[r][c].index == NO_PIXEL.index)
-        continue;
-      times.insert_or_assign(matrix.pixels[r][c].index, 0);
-      hitColor.insert_or_assign(matrix.pixels[r][c].index, defaultColor);
-    }
-  }
+  times.assign(matrix.maxPixelIndex + 1, 0);
+  hitColor.assign(matrix.maxPixelIndex + 1, defaultColor);
+  pressedPixels.assign(matrix.maxPixelIndex + 1, false);
 }
 
 void Animation::UpdatePixels(std::vector<Pixel> inpixels) {
+  for (auto &pixel : this->pixels)
+    if (pixel.index != NO_PIXEL.index)
+      pressedPixels[pixel.index] = false;
+
   this->pixels = inpixels;
+
+  for (auto &pixel : this->pixels)
+    if (pixel.index != NO_PIXEL.index)
+      pressedPixels[pixel.index] = true;
 }
 
 void Animation::UpdateTime() {
@@ -33,7 +36,7 @@ void Animation::UpdateTime() {
   lastUpdateTime = currentTime;
 }
 
-void Animation::UpdatePresses(RGB (&frame)[100]) {
+void Animation::UpdatePresses(RGB *frame) {
   // Queue up blend on hit
   for (size_t p = 0; p < pixels.size(); p++) {
     if (pixels[p].index != NO_PIXEL.index) {
@@ -50,24 +53,43 @@ void Animation::DecrementFadeCounter(int32_t index) {
   };
 }
 
+bool Animation::IsFading() {
+  for (auto &time : times)
+    if (time > 0)
+      return true;
+
+  return false;
+}
+
 void Animation::ClearPixels() {
-  this->pixels.clear();
+  UpdatePixels({});
 }
 
 /* Some of these animations are filtered to specific pixels, such as button press animations.
 This somewhat backwards named method determines if a specific pixel is _not_ included in the filter */
-bool Animation::notInFilter(Pixel pixel) {
+bool Animation::notInFilter(int index) {
   if (!this->filtered) {
     return false;
   }
 
-  for (size_t i = 0; i < this->pixels.size(); i++) {
-    if (pixel == this->pixels.at(i)) {
-      return false;
-    }
-  }
+  return !pressedPixels[index];
+}
 
-  return true;
+void Animation::WritePixel(RGB *frame, const FlatPixel &pixel, RGB color) {
+  const uint8_t *position = &matrix->ledPositions[pixel.firstLed];
+  for (uint16_t p = 0; p != pixel.ledCount; p++)
+    frame[position[p]] = color;
+}
+
+void Animation::BuildPalette(const std::map<uint32_t, RGB> &theme) {
+  palette.clear();
+  for (auto &pixel : matrix->flatPixels) {
+    auto itr = theme.find(pixel.mask);
+    if (itr != theme.end())
+      palette.push_back({ itr->second, true });
+    else
+      palette.push_back({ defaultColor, false });
+  }
 }
 
 RGB Animation::BlendColor(RGB start, RGB end, uint32_t timeRemainingInMs) {
@@ -77,13 +99,19 @@ RGB Animation::BlendColor(RGB start, RGB end, uint32_t timeRemainingInMs) {
     return end;
   }
 
-  float progress = 1.0f - (static_cast<float>(timeRemainingInMs) / static_cast<float>(coolDownTimeInMs));
-  if (progress < 0.0f) progress = 0.0f;
-  if (progress > 1.0f) progress = 1.0f;
+  if (timeRemainingInMs >= coolDownTimeInMs) {
+    result.r = start.r;
+    result.g = start.g;
+    result.b = start.b;
+    return result;
+  }
+
+  // start + (end - start) * elapsed / coolDown, rounded down, without floats
+  uint32_t elapsed = coolDownTimeInMs - timeRemainingInMs;
 
-  result.r = static_cast<uint32_t>(static_cast<float>(start.r + (end.r - start.r) * progress));
-  result.g = static_cast<uint32_t>(static_cast<float>(start.g + (end.g - start.g) * progress));
-  result.b = static_cast<uint32_t>(static_cast<float>(start.b + (end.b - start.b) * progress));
+  result.r = (start.r * timeRemainingInMs + end.r * elapsed) / coolDownTimeInMs;
+  result.g = (start.g * timeRemainingInMs + end.g * elapsed) / coolDownTimeInMs;
+  result.b = (start.b * timeRemainingInMs + end.b * elapsed) / coolDownTimeInMs;
 
   return result;
 }
@@ -81,6 +81,40 @@ struct RGB {
     assert(false);
     return 0;
   }
+
+  // Same packing as value(), with brightness as a 0.16 fixed-point scale (65536 = full)
+  inline uint32_t scaledValue(LEDFormat format, uint32_t scale) const {
+    uint32_t sr = (r * scale) >> 16;
+    uint32_t sg = (g * scale) >> 16;
+    uint32_t sb = (b * scale) >> 16;
+
+    switch (format) {
+      case LED_FORMAT_GRB:
+        return (sg << 16) | (sr << 8) | sb;
+
+      case LED_FORMAT_RGB:
+        return (sr << 16) | (sg << 8) | sb;
+
+      case LED_FORMAT_GRBW:
+      {
+        if ((r == g) && (r == b))
+          return sr;
+
+        return (sg << 24) | (sr << 16) | (sb << 8) | ((w * scale) >> 16);
+      }
+
+      case LED_FORMAT_RGBW:
+      {
+        if ((r == g) && (r == b))
+          return sr;
+
+        return (sr << 24) | (sg << 16) | (sb << 8) | ((w * scale) >> 16);
+      }
+    }
+
+    assert(false);
+    return 0;
+  }
 };
 
 constexpr RGB ColorBlack(0, 0, 0);
@@ -112,11 +146,16 @@ public:
 
   static LEDFormat format;
 
-  bool notInFilter(Pixel pixel);
-  virtual void Animate(RGB (&frame)[100]) = 0;
+  bool notInFilter(int index);
+  virtual void Animate(RGB *frame) = 0;
   void UpdateTime();
-  void UpdatePresses(RGB (&frame)[100]);
+  void UpdatePresses(RGB *frame);
   void DecrementFadeCounter(int32_t index);
+  void WritePixel(RGB *frame, const FlatPixel &pixel, RGB color);
+
+  // Effects whose output changes with time alone, even without new input
+  virtual bool IsAnimated() { return false; }
+  static bool IsFading();
 
   virtual void ParameterUp() = 0;
   virtual void ParameterDown() = 0;
@@ -132,12 +171,21 @@ button press changes. Rather than adjusting the matrix to represent a subset of
 we provide a subset of pixels to use as a filter. */
   PixelMatrix *matrix;
   std::vector<Pixel> pixels;
+  std::vector<bool> pressedPixels;
   bool filtered = false;
 
-  // Color fade 
+  // Theme colors resolved per entry of matrix->flatPixels; themed is false where the theme has no color
+  struct PaletteEntry {
+    RGB color;
+    bool themed;
+  };
+  std::vector<PaletteEntry> palette;
+  void BuildPalette(const std::map<uint32_t, RGB> &theme);
+
+  // Color fade, indexed by pixel index
   RGB defaultColor = ColorBlack;  
-  static std::map<uint32_t, int32_t> times;
-  static std::map<uint32_t, RGB> hitColor;    
+  static std::vector<int32_t> times;
+  static std::vector<RGB> hitColor;    
   absolute_time_t lastUpdateTime = nil_time;
   uint32_t coolDownTimeInMs = 1000;
   int64_t updateTimeInMs = 20;
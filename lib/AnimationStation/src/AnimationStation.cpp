@@ -10,6 +10,7 @@
 uint8_t AnimationStation::brightnessMax = 100;
 uint8_t AnimationStation::brightnessSteps = 5;
 float AnimationStation::brightnessX = 0;
+uint32_t AnimationStation::brightnessScale = 0;
 absolute_time_t AnimationStation::nextChange = nil_time;
 AnimationOptions AnimationStation::options = {};
 uint8_t AnimationStation::effectCount = TOTAL_EFFECTS;
@@ -118,16 +119,30 @@ void AnimationStation::Animate() {
     return;
   }
 
-  baseAnimation->Animate(this->frame);
-  buttonAnimation->Animate(this->frame);
+  baseAnimation->Animate(this->frame.data());
+  buttonAnimation->Animate(this->frame.data());
 }
 
-void AnimationStation::Clear() { memset(frame, 0, sizeof(frame)); }
+// True when Animate() would reproduce the current frame: no timed effect, fade or held button
+bool AnimationStation::IsSettled() {
+  if (baseAnimation == nullptr || buttonAnimation == nullptr) {
+    return true;
+  }
+
+  return !baseAnimation->IsAnimated() && !buttonAnimation->IsAnimated()
+      && this->lastPressed.empty() && !Animation::IsFading();
+}
+
+void AnimationStation::Clear() { std::fill(frame.begin(), frame.end(), ColorBlack); }
 
 float AnimationStation::GetBrightnessX() {
   return AnimationStation::brightnessX;
 }
 
+uint32_t AnimationStation::GetBrightnessScale() {
+  return AnimationStation::brightnessScale;
+}
+
 uint8_t AnimationStation::GetBrightness() {
   return AnimationStation::options.brightness;
 }
@@ -174,6 +189,7 @@ void AnimationStation::SetMode(uint8_t mode) {
 
 void AnimationStation::SetMatrix(PixelMatrix matrix) {
   this->matrix = matrix;
+  this->frame.assign(this->matrix.getFrameSize(), ColorBlack);
 }
 
 void AnimationStation::SetOptions(AnimationOptions options) {
@@ -181,9 +197,12 @@ void AnimationStation::SetOptions(AnimationOptions options) {
   AnimationStation::SetBrightness(options.brightness);
 }
 
-void AnimationStation::ApplyBrightness(uint32_t *frameValue) {
-  for (int i = 0; i < 100; i++)
-    frameValue[i] = this->frame[i].value(Animation::format, brightnessX);
+// Fills frameSize entries: the animated LEDs, then zeroes for anything past the matrix
+void AnimationStation::ApplyBrightness(uint32_t *frameValue, uint16_t frameSize) {
+  uint16_t animated = std::min<size_t>(frameSize, this->frame.size());
+  for (uint16_t i = 0; i < animated; i++)
+    frameValue[i] = this->frame[i].scaledValue(Animation::format, brightnessScale);
+  std::fill(frameValue + animated, frameValue + frameSize, 0);
 }
 
 void AnimationStation::SetBrightness(uint8_t brightness) {
@@ -196,6 +215,10 @@ void AnimationStation::SetBrightness(uint8_t brightness) {
     AnimationStation::brightnessX = 1;
   else if (AnimationStation::brightnessX < 0)
     AnimationStation::brightnessX = 0;
+
+  // Rounded up so (c * brightnessScale) >> 16 gives the same 8-bit value as c * brightnessX
+  uint32_t level = AnimationStation::options.brightness * getBrightnessStepSize();
+  AnimationStation::brightnessScale = (level >= 255) ? 65536 : ((level << 16) + 254) / 255;
 }
 
 void AnimationStation::DecreaseBrightness() {
@@ -212,4 +235,5 @@ void AnimationStation::IncreaseBrightness() {
 
 void AnimationStation::DimBrightnessTo0() {
   AnimationStation::brightnessX = 0;
+  AnimationStation::brightnessScale = 0;
 }
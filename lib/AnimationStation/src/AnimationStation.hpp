@@ -99,10 +99,11 @@ public:
   AnimationStation();
 
   void Animate();
+  bool IsSettled();
   void HandleEvent(AnimationHotkey action);
   void Clear();
   void ChangeAnimation(int changeSize);
-  void ApplyBrightness(uint32_t *frameValue);
+  void ApplyBrightness(uint32_t *frameValue, uint16_t frameSize);
   uint16_t AdjustIndex(int changeSize);
   void HandlePressed(std::vector<Pixel> pressed);
   void ClearPressed();
@@ -112,6 +113,7 @@ public:
   void SetMatrix(PixelMatrix matrix);
   static void ConfigureBrightness(uint8_t max, uint8_t steps);
   static float GetBrightnessX();
+  static uint32_t GetBrightnessScale();
   static uint8_t GetBrightness();
   static void SetBrightness(uint8_t brightness);
   static void DecreaseBrightness();
@@ -125,13 +127,14 @@ public:
   static AnimationOptions options;
   static absolute_time_t nextChange;
   static uint8_t effectCount;
-  RGB frame[100];
+  std::vector<RGB> frame; // sized to the matrix in SetMatrix
 
 protected:
   inline static uint8_t getBrightnessStepSize() { return (brightnessMax / brightnessSteps); }
   static uint8_t brightnessMax;
   static uint8_t brightnessSteps;
   static float brightnessX;
+  static uint32_t brightnessScale; // brightnessX in 0.16 fixed point
   PixelMatrix matrix;
 };
 
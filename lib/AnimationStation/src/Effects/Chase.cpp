@@ -7,7 +7,7 @@
 Chase::Chase(PixelMatrix &matrix) : Animation(matrix) {
 }
 
-void Chase::Animate(RGB (&frame)[100]) {
+void Chase::Animate(RGB *frame) {
   if (!time_reached(this->nextRunTime)) {
     return;
   }
@@ -15,23 +15,12 @@ void Chase::Animate(RGB (&frame)[100]) {
   UpdateTime();
   UpdatePresses(frame);
 
-  for (auto &col : matrix->pixels) {
-    for (auto &pixel : col) {
-      if (pixel.index == NO_PIXEL.index)
-        continue;
-
-      // Count down the timer
-      DecrementFadeCounter(pixel.index);
-
-      if (this->IsChasePixel(pixel.index)) {
-        RGB color = RGB::wheel(this->WheelFrame(pixel.index));
-        for (auto &pos : pixel.positions)
-          frame[pos] = BlendColor(hitColor[pixel.index], color, times[pixel.index]);
-      } else {
-        for (auto &pos : pixel.positions)
-          frame[pos] = BlendColor(hitColor[pixel.index], ColorBlack, times[pixel.index]);
-      }
-    }
+  for (auto &pixel : matrix->flatPixels) {
+    // Count down the timer
+    DecrementFadeCounter(pixel.index);
+
+    RGB color = this->IsChasePixel(pixel.index) ? RGB::wheel(this->WheelFrame(pixel.index)) : ColorBlack;
+    WritePixel(frame, pixel, BlendColor(hitColor[pixel.index], color, times[pixel.index]));
   }
 
   currentPixel++;
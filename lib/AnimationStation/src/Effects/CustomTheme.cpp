@@ -3,31 +3,24 @@
 std::map<uint32_t, RGB> CustomTheme::theme;
 
 CustomTheme::CustomTheme(PixelMatrix &matrix) : Animation(matrix) {
+  BuildPalette(theme);
 }
 
-void CustomTheme::Animate(RGB (&frame)[100]) {
+void CustomTheme::Animate(RGB *frame) {
   UpdateTime();
   UpdatePresses(frame);
 
-  for (size_t r = 0; r != matrix->pixels.size(); r++) {
-    for (size_t c = 0; c != matrix->pixels[r].size(); c++) {
-      if (matrix->pixels[r][c].index == NO_PIXEL.index)
-        continue;
-
-      // Count down the timer
-      DecrementFadeCounter(matrix->pixels[r][c].index);
-
-      auto itr = theme.find(matrix->pixels[r][c].mask);
-      if (itr != theme.end()) {
-        for (size_t p = 0; p != matrix->pixels[r][c].positions.size(); p++) {
-          // Interpolate from hitColor (color the button was assigned when pressed) back to the theme color
-          frame[matrix->pixels[r][c].positions[p]] = BlendColor(hitColor[matrix->pixels[r][c].index], itr->second, times[matrix->pixels[r][c].index]);
-        }
-      } else {
-        for (size_t p = 0; p != matrix->pixels[r][c].positions.size(); p++) {
-          frame[matrix->pixels[r][c].positions[p]] = defaultColor;
-        }
-      }
+  for (size_t i = 0; i != matrix->flatPixels.size(); i++) {
+    const FlatPixel &pixel = matrix->flatPixels[i];
+
+    // Count down the timer
+    DecrementFadeCounter(pixel.index);
+
+    if (palette[i].themed) {
+      // Interpolate from hitColor (color the button was assigned when pressed) back to the theme color
+      WritePixel(frame, pixel, BlendColor(hitColor[pixel.index], palette[i].color, times[pixel.index]));
+    } else {
+      WritePixel(frame, pixel, defaultColor);
     }
   }
 }
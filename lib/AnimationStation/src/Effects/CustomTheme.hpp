@@ -12,7 +12,7 @@ public:
 
   static bool HasTheme();
   static void SetCustomTheme(std::map<uint32_t, RGB> customTheme);
-  void Animate(RGB (&frame)[100]);
+  void Animate(RGB *frame);
   void ParameterUp();
   void ParameterDown();
 protected:
@@ -3,7 +3,7 @@
 Rainbow::Rainbow(PixelMatrix &matrix) : Animation(matrix) {
 }
 
-void Rainbow::Animate(RGB (&frame)[100]) {
+void Rainbow::Animate(RGB *frame) {
   if (!time_reached(this->nextRunTime)) {
     return;
   }
@@ -11,18 +11,12 @@ void Rainbow::Animate(RGB (&frame)[100]) {
   UpdateTime();
   UpdatePresses(frame);
 
-  for (auto &col : matrix->pixels) {
-    for (auto &pixel : col) {
-      if (pixel.index == NO_PIXEL.index)
-        continue;
+  RGB color = RGB::wheel(this->currentFrame);
+  for (auto &pixel : matrix->flatPixels) {
+    // Count down the timer
+    DecrementFadeCounter(pixel.index);
 
-      // Count down the timer
-      DecrementFadeCounter(pixel.index);
-
-      RGB color = RGB::wheel(this->currentFrame);
-      for (auto &pos : pixel.positions)
-        frame[pos] = BlendColor(hitColor[pixel.index], color, times[pixel.index]);
-    }
+    WritePixel(frame, pixel, BlendColor(hitColor[pixel.index], color, times[pixel.index]));
   }
 
   if (reverse) {
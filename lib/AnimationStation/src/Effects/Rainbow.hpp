@@ -13,7 +13,8 @@ public:
   Rainbow(PixelMatrix &matrix);
   ~Rainbow() {};
 
-  void Animate(RGB (&frame)[100]);
+  void Animate(RGB *frame);
+  bool IsAnimated() { return true; }
   void ParameterUp();
   void ParameterDown();
 
@@ -5,29 +5,26 @@ StaticColor::StaticColor(PixelMatrix &matrix) : Animation(matrix) {
 
 StaticColor::StaticColor(PixelMatrix &matrix, std::vector<Pixel> &inpixels) : Animation(matrix) {
   this->filtered = true;
-  pixels = inpixels;
+  UpdatePixels(inpixels);
 }
 
-void StaticColor::Animate(RGB (&frame)[100]) {
+void StaticColor::Animate(RGB *frame) {
   UpdateTime();
   UpdatePresses(frame);
 
-  for (size_t r = 0; r != matrix->pixels.size(); r++) {
-    for (size_t c = 0; c != matrix->pixels[r].size(); c++) {
-      if (matrix->pixels[r][c].index == NO_PIXEL.index || this->notInFilter(matrix->pixels[r][c]))
-        continue;
+  RGB color = colors[this->GetColor()];
+  for (auto &pixel : matrix->flatPixels) {
+    if (this->notInFilter(pixel.index))
+      continue;
 
-      // Count down the timer
-      DecrementFadeCounter(matrix->pixels[r][c].index);
+    // Count down the timer
+    DecrementFadeCounter(pixel.index);
 
-      for (size_t p = 0; p != matrix->pixels[r][c].positions.size(); p++) {
-        // Interpolate from hitColor (color the button was assigned when pressed) back to the theme color
-        if (!this->filtered) {
-          frame[matrix->pixels[r][c].positions[p]] = BlendColor(hitColor[matrix->pixels[r][c].index], colors[this->GetColor()], times[matrix->pixels[r][c].index]);
-        } else {
-          frame[matrix->pixels[r][c].positions[p]] = colors[this->GetColor()];
-        }
-      }
+    // Interpolate from hitColor (color the button was assigned when pressed) back to the theme color
+    if (!this->filtered) {
+      WritePixel(frame, pixel, BlendColor(hitColor[pixel.index], color, times[pixel.index]));
+    } else {
+      WritePixel(frame, pixel, color);
     }
   }
 }
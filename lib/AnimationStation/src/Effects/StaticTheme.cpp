@@ -8,32 +8,28 @@ StaticTheme::StaticTheme(PixelMatrix &matrix) : Animation(matrix) {
   }
 }
 
-void StaticTheme::Animate(RGB (&frame)[100]) {
+void StaticTheme::Animate(RGB *frame) {
   if (StaticTheme::themes.size() > 0) {
     UpdateTime();
     UpdatePresses(frame);
 
-    for (size_t r = 0; r != matrix->pixels.size(); r++) {
-      for (size_t c = 0; c != matrix->pixels[r].size(); c++) {
-        if (matrix->pixels[r][c].index == NO_PIXEL.index)
-          continue;
-
-        // Count down the timer
-        DecrementFadeCounter(matrix->pixels[r][c].index);
-
-        std::map<uint32_t, RGB> theme = StaticTheme::themes.at(AnimationStation::options.themeIndex);
-
-        auto itr = theme.find(matrix->pixels[r][c].mask);
-        if (itr != theme.end()) {
-          for (size_t p = 0; p != matrix->pixels[r][c].positions.size(); p++) {
-            // Interpolate from hitColor (color the button was assigned when pressed) back to the theme color
-            frame[matrix->pixels[r][c].positions[p]] = BlendColor(hitColor[matrix->pixels[r][c].index], itr->second, times[matrix->pixels[r][c].index]);
-          }
-        } else {
-          for (size_t p = 0; p != matrix->pixels[r][c].positions.size(); p++) {
-            frame[matrix->pixels[r][c].positions[p]] = defaultColor;
-          }
-        }
+    // Theme colors are looked up once per theme change, not per pixel per frame
+    if (paletteThemeIndex != AnimationStation::options.themeIndex) {
+      BuildPalette(StaticTheme::themes.at(AnimationStation::options.themeIndex));
+      paletteThemeIndex = AnimationStation::options.themeIndex;
+    }
+
+    for (size_t i = 0; i != matrix->flatPixels.size(); i++) {
+      const FlatPixel &pixel = matrix->flatPixels[i];
+
+      // Count down the timer
+      DecrementFadeCounter(pixel.index);
+
+      if (palette[i].themed) {
+        // Interpolate from hitColor (color the button was assigned when pressed) back to the theme color
+        WritePixel(frame, pixel, BlendColor(hitColor[pixel.index], palette[i].color, times[pixel.index]));
+      } else {
+        WritePixel(frame, pixel, defaultColor);
       }
     }
   }
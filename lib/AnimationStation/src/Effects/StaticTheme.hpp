@@ -17,11 +17,12 @@ public:
 
   static void AddTheme(const std::map<uint32_t, RGB>& theme) { themes.push_back(theme); }
   static void ClearThemes() { themes.clear(); }
-  void Animate(RGB (&frame)[100]);
+  void Animate(RGB *frame);
   void ParameterUp();
   void ParameterDown();
 protected:
   RGB defaultColor = ColorBlack;
+  int paletteThemeIndex = -1;
   static std::vector<std::map<uint32_t, RGB>> themes;
 };
 
@@ -18,34 +18,63 @@ struct Pixel {
 
 inline const Pixel NO_PIXEL(-1);
 
+// A real (non NO_PIXEL) pixel with its LED positions stored contiguously in PixelMatrix::ledPositions
+struct FlatPixel {
+  int index;
+  uint32_t mask;
+  uint16_t firstLed;
+  uint16_t ledCount;
+};
+
 struct PixelMatrix {
   PixelMatrix() { }
 
   std::vector<std::vector<Pixel>> pixels;
   uint8_t ledsPerPixel;
+
+  // Flattened copy of pixels, built once in setup() so effects can walk a single table
+  std::vector<FlatPixel> flatPixels;
+  std::vector<uint8_t> ledPositions;
+  uint16_t pixelCount = 0;
+  int maxPixelIndex = -1;
+  uint16_t frameSize = 0; // highest LED position + 1
+
   void setup(std::vector<std::vector<Pixel>> pixels, int ledsPerPixel = -1) {
     this->pixels = pixels;
     this->ledsPerPixel = ledsPerPixel;
-  }
 
-  inline int getLedCount() {
-    int count = 0;
-    for (auto &col : pixels)
-      for (auto &pixel : col)
+    flatPixels.clear();
+    ledPositions.clear();
+    pixelCount = 0;
+    maxPixelIndex = -1;
+    frameSize = 0;
+    for (auto &col : this->pixels) {
+      pixelCount += col.size();
+      for (auto &pixel : col) {
         if (pixel.index == NO_PIXEL.index)
           continue;
-        else
-          count += pixel.positions.size();
 
-    return count;
+        flatPixels.push_back({ pixel.index, pixel.mask, (uint16_t)ledPositions.size(), (uint16_t)pixel.positions.size() });
+        ledPositions.insert(ledPositions.end(), pixel.positions.begin(), pixel.positions.end());
+        for (auto &pos : pixel.positions)
+          if (pos >= frameSize)
+            frameSize = pos + 1;
+        if (pixel.index > maxPixelIndex)
+          maxPixelIndex = pixel.index;
+      }
+    }
+  }
+
+  inline int getLedCount() const {
+    return ledPositions.size();
   }
 
   inline uint16_t getPixelCount() const {
-    uint16_t count = 0;
-    for (auto &col : pixels)
-      count += col.size();
+    return pixelCount;
+  }
 
-    return count;
+  inline uint16_t getFrameSize() const {
+    return frameSize;
   }
 
 };
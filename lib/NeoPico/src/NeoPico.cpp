@@ -8,58 +8,105 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <algorithm>
 
 #include "pico/stdlib.h"
 #include "hardware/pio.h"
+#include "hardware/dma.h"
 #include "hardware/clocks.h"
 #include "NeoPico.hpp"
 
+// WS2812 bits are 1.25 us at 800 kHz, and the chain latches once the line idles low for 280 us
+#define WS2812_BIT_TIME_NS 1250
+#define WS2812_RESET_US 280
+
 LEDFormat NeoPico::GetFormat() {
   return format;
 }
 
-void NeoPico::PutPixel(uint32_t pixelData) {
-  switch (format) {
-    case LED_FORMAT_GRB:
-    case LED_FORMAT_RGB:
-      pio_sm_put_blocking(pio0, 0, pixelData << 8u);
-      break;
-    case LED_FORMAT_GRBW:
-    case LED_FORMAT_RGBW:
-      pio_sm_put_blocking(pio0, 0, pixelData);
-      break;
-  }
-}
-
-NeoPico::NeoPico(int ledPin, int numPixels, LEDFormat format) : format(format), numPixels(numPixels) {
-  PIO pio = pio0;
-  int sm = 0;
-  uint offset = pio_add_program(pio, &ws2812_program);
+NeoPico::NeoPico(int ledPin, int numPixels, LEDFormat format, uint32_t reservedDMAChannels) : format(format), numPixels(numPixels) {
+  offset = pio_add_program(pio, &ws2812_program);
   bool rgbw = (format == LED_FORMAT_GRBW) || (format == LED_FORMAT_RGBW);
   ws2812_program_init(pio, sm, offset, ledPin, 800000, rgbw);
+
+  outputBuffer.assign(numPixels, 0);
+
+  // The whole chain is streamed by DMA, paced by the state machine's TX FIFO. Reserved
+  // channels are held while picking ours, then handed back to their owner unclaimed.
+  uint32_t heldChannels = 0;
+  for (uint channel = 0; channel < NUM_DMA_CHANNELS; channel++) {
+    if ((reservedDMAChannels & (1u << channel)) && !dma_channel_is_claimed(channel)) {
+      dma_channel_claim(channel);
+      heldChannels |= (1u << channel);
+    }
+  }
+  dmaChannel = dma_claim_unused_channel(true);
+  dma_unclaim_mask(heldChannels);
+  dma_channel_config c = dma_channel_get_default_config(dmaChannel);
+  channel_config_set_transfer_data_size(&c, DMA_SIZE_32);
+  channel_config_set_read_increment(&c, true);
+  channel_config_set_write_increment(&c, false);
+  channel_config_set_dreq(&c, pio_get_dreq(pio, sm, true));
+  dma_channel_configure(dmaChannel, &c, &pio->txf[sm], outputBuffer.data(), 0, false);
+
   this->Clear();
   sleep_ms(10);
 }
 
+NeoPico::~NeoPico() {
+  WaitForIdle();
+  dma_channel_unclaim(dmaChannel);
+  pio_sm_set_enabled(pio, sm, false);
+  pio_remove_program(pio, &ws2812_program, offset);
+}
+
 void NeoPico::Clear() {
-  memset(frame, 0, sizeof(frame));
+  WaitForIdle();
+  std::fill(outputBuffer.begin(), outputBuffer.end(), 0);
+  frame = nullptr;
 }
 
-void NeoPico::SetFrame(uint32_t newFrame[100]) {
-  memcpy(frame, newFrame, sizeof(frame));
+void NeoPico::SetFrame(const uint32_t *newFrame) {
+  frame = newFrame;
 }
 
-void NeoPico::Show() {
-  for (int i = 0; i < this->numPixels; ++i) {
-     this->PutPixel(this->frame[i]);
+void NeoPico::WaitForIdle() {
+  dma_channel_wait_for_finish_blocking(dmaChannel);
+}
+
+void NeoPico::WaitForReset() {
+  WaitForIdle();
+  sleep_until(resetTime);
+}
+
+bool NeoPico::Show() {
+  // A frame still streaming out or latching is left alone; the caller sends again later
+  if (numPixels == 0) {
+    return true;
   }
-  sleep_ms(10);
+  if (!time_reached(resetTime)) {
+    return false;
+  }
+
+  if (frame != nullptr) {
+    // 24-bit formats are shifted out MSB first from the top of each word
+    uint8_t shift = (format == LED_FORMAT_GRB || format == LED_FORMAT_RGB) ? 8u : 0u;
+    for (int i = 0; i < this->numPixels; ++i) {
+      outputBuffer[i] = this->frame[i] << shift;
+    }
+  }
+
+  // The FIFO keeps the line busy for the whole chain, so the last bit leaves at a fixed time
+  uint8_t bitsPerPixel = (format == LED_FORMAT_GRB || format == LED_FORMAT_RGB) ? 24u : 32u;
+  uint64_t frameTimeUs = ((uint64_t)this->numPixels * bitsPerPixel * WS2812_BIT_TIME_NS + 999) / 1000;
+  resetTime = make_timeout_time_us(frameTimeUs + WS2812_RESET_US);
+  dma_channel_transfer_from_buffer_now(dmaChannel, outputBuffer.data(), this->numPixels);
+  return true;
 }
 
 void NeoPico::Off() {
+  WaitForReset();
   Clear();
-  for (int i = 0; i < this->numPixels; ++i) {
-     this->PutPixel(this->frame[i]);
-  }
-  sleep_ms(10);
+  Show();
+  WaitForReset();
 }
@@ -1,6 +1,7 @@
 #ifndef _NEO_PICO_H_
 #define _NEO_PICO_H_
 
+#include "pico/time.h"
 #include "ws2812.pio.h"
 #include <vector>
 
@@ -15,19 +16,28 @@ typedef enum
 class NeoPico
 {
 public:
-  NeoPico(int ledPin, int numPixels, LEDFormat format = LED_FORMAT_GRB);
-  void Show();
+  // reservedDMAChannels is a mask of channels other code uses without having claimed them yet
+  NeoPico(int ledPin, int numPixels, LEDFormat format = LED_FORMAT_GRB, uint32_t reservedDMAChannels = 0);
+  ~NeoPico();
+  bool Show(); // false when the previous frame is still being sent or latched
   void Clear();
   void Off();
   LEDFormat GetFormat();
   // void SetPixel(int pixel, uint32_t color);
-  void SetFrame(uint32_t newFrame[100]);
+  // The frame is read in place on Show() and must hold at least numPixels entries
+  void SetFrame(const uint32_t *newFrame);
 private:
-  void PutPixel(uint32_t pixel_grb);
+  void WaitForIdle();
+  void WaitForReset();
   LEDFormat format;
   PIO pio = pio0;
+  uint sm = 0;
+  uint offset = 0;
+  int dmaChannel = -1;
   int numPixels = 0;
-  uint32_t frame[100];
+  const uint32_t *frame = nullptr;
+  absolute_time_t resetTime = nil_time; // when the chain has latched the last frame sent
+  std::vector<uint32_t> outputBuffer; // what the DMA channel is streaming to the state machine
 };
 
 #endif
@@ -31,6 +31,7 @@
 #else
     #include <cstring>
     #include <cstdio>
+    #include "generated/snespad.pio.h"
 #endif
 
 SNESpad::SNESpad(int clock, int latch, int data) {
@@ -41,6 +42,13 @@ SNESpad::SNESpad(int clock, int latch, int data) {
 
 void SNESpad::begin() {
     init();
+#ifndef ARDUINO
+    // the first frame has been requested by init(), wait for it so the
+    // initial poll sees the buttons held at boot
+    if (sm != -1) {
+        while (pio_sm_get_rx_fifo_level(pio, sm) < 2) tight_loop_contents();
+    }
+#endif
 #if SNES_PAD_DEBUG==true
     printf("SNESpad::begin\n");
 #endif
@@ -190,19 +198,52 @@ void SNESpad::init() {
     gpio_set_dir(latchPin, GPIO_OUT);
     gpio_set_dir(dataPin, GPIO_IN);
     gpio_pull_up(dataPin);
+
+    if (initPIO()) {
+        // request the first frame
+        pio_sm_put(pio, sm, 0);
+    }
 #endif
 
     return;
 }
 
-// signal mouse to go to next speed if not at desired speed
-void SNESpad::speed()
-{
+#ifndef ARDUINO
+// load the reader on whichever PIO block still has room for it
+bool SNESpad::initPIO() {
+    PIO candidates[] = { pio1, pio0 };
+    for (PIO candidate : candidates) {
+        if (reservedPIOs & (1 << pio_get_index(candidate))) continue;
+        if (!pio_can_add_program(candidate, &snespad_program)) continue;
+
+        // NeoPico drives sm 0 of pio0 without claiming it
+        for (uint i = (candidate == pio0) ? 1 : 0; i < NUM_PIO_STATE_MACHINES; i++) {
+            if (pio_sm_is_claimed(candidate, i)) continue;
+
+            pio_sm_claim(candidate, i);
+            uint offset = pio_add_program(candidate, &snespad_program);
+            snespad_program_init(candidate, i, offset, clockPin, latchPin, dataPin);
+            pio = candidate;
+            sm = i;
+            return true;
+        }
+    }
+    return false;
+}
+#endif
+
+bool SNESpad::needsSpeedPulse() {
     // default mouse to fastest speed
-    if (type == SNES_PAD_MOUSE
+    return (type == SNES_PAD_MOUSE
         && mouseSpeed != SNES_MOUSE_FAST
         && mouseSpeedFails < SNES_MOUSE_THRESHOLD
-    ) {
+    );
+}
+
+// signal mouse to go to next speed if not at desired speed
+void SNESpad::speed()
+{
+    if (needsSpeedPulse()) {
 #ifdef ARDUINO
         digitalWrite(clockPin,LOW);
         delayMicroseconds(6);
@@ -271,6 +312,27 @@ uint32_t SNESpad::read()
     uint32_t ret = 0;
     uint8_t i;
 
+#ifndef ARDUINO
+    if (sm != -1) {
+        // The state machine clocks the next frame in on its own, so only pick
+        // up a finished one and keep reporting the last one until then.
+        if (pio_sm_get_rx_fifo_level(pio, sm) < 2) return _lastPacket;
+
+        bool disconnected = pio_sm_get(pio, sm) >> 31;
+        ret = pio_sm_get(pio, sm);
+
+        // it always clocks 32 bits, drop the extra ones like the bit-banged
+        // reader does for anything that is not a mouse
+        if (ret & (1 << 15)) ret &= 0xFFFF;
+
+        _lastPacket = decode(~ret, disconnected);
+
+        // request the next frame
+        pio_sm_put(pio, sm, needsSpeedPulse());
+        return _lastPacket;
+    }
+#endif
+
     /* A connected device will pull the data line low prior to latch.
        A disconnected pin is kept high by internal pull_up.*/
     uint32_t disconnected = false;
@@ -297,6 +359,12 @@ uint32_t SNESpad::read()
     }
     ret = ~ret; // buttons are active low, so invert bits
 
+    return decode(ret, disconnected);
+}
+
+// identify the device from an inverted packet
+uint32_t SNESpad::decode(uint32_t ret, bool disconnected)
+{
     // verify controller or mouse is connected
     if (disconnected && !(ret & 0xFFFF)) {
         type = SNES_PAD_NONE;
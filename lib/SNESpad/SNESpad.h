@@ -34,6 +34,7 @@
 #else
     // If we aren't compiling on Arduino, include the Pico SDK standard library
     #include "pico/stdlib.h"
+    #include "hardware/pio.h"
 #endif
 
 #define SNES_PAD_NONE   -1
@@ -104,6 +105,10 @@ class SNESpad {
     void begin();
     void start();
     void poll();
+#ifndef ARDUINO
+    // keep the reader off a PIO block something else loads later, call before begin()
+    void reservePIO(uint pioIndex) { reservedPIOs |= (1 << pioIndex); }
+#endif
   private:
   
     uint8_t latchPin; // output: latch
@@ -112,11 +117,23 @@ class SNESpad {
     uint8_t mouseSpeed;   // mouse speed (0=SLOW|1=MEDIUM|2=FAST)
     uint8_t mouseSpeedFails = 0;
     uint32_t _lastRead;
+    uint32_t _lastPacket = 0;
+
+#ifndef ARDUINO
+    // PIO reader, falls back to bit-banging when no unreserved state machine is free
+    PIO pio = nullptr;
+    int8_t sm = -1;
+    uint8_t reservedPIOs = 0;
+
+    bool initPIO();
+#endif
 
     void init();
+    bool needsSpeedPulse();
     void speed();
     void latch();
     uint32_t read();
+    uint32_t decode(uint32_t ret, bool disconnected);
     uint32_t clock();
     uint8_t reverse(uint8_t c);
 };
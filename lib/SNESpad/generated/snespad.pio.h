@@ -0,0 +1,80 @@
+// -------------------------------------------------- //
+// This file is autogenerated by pioasm; do not edit! //
+// -------------------------------------------------- //
+
+#pragma once
+
+#if !PICO_NO_HARDWARE
+#include "hardware/pio.h"
+#endif
+
+// ------- //
+// snespad //
+// ------- //
+
+#define snespad_wrap_target 0
+#define snespad_wrap 18
+
+static const uint16_t snespad_program_instructions[] = {
+            //     .wrap_target
+    0x80a0, //  0: pull   block 
+    0x6021, //  1: out    x, 1 
+    0x4001, //  2: in     pins, 1 
+    0x8020, //  3: push   block 
+    0xe501, //  4: set    pins, 1                [5] 
+    0x0028, //  5: jmp    !x, 8 
+    0xb242, //  6: nop                   side 0 [2] 
+    0xbd42, //  7: nop                   side 1 [5] 
+    0xe200, //  8: set    pins, 0                [2] 
+    0xe04f, //  9: set    y, 15 
+    0xb242, // 10: nop                   side 0 [2] 
+    0x4001, // 11: in     pins, 1 
+    0x1a8a, // 12: jmp    y--, 10        side 1 [2] 
+    0xa542, // 13: nop                          [5] 
+    0xe04f, // 14: set    y, 15 
+    0xb242, // 15: nop                   side 0 [2] 
+    0x4001, // 16: in     pins, 1 
+    0x1a8f, // 17: jmp    y--, 15        side 1 [2] 
+    0x8020, // 18: push   block 
+            //     .wrap
+};
+
+#if !PICO_NO_HARDWARE
+static const struct pio_program snespad_program = {
+    .instructions = snespad_program_instructions,
+    .length = 19,
+    .origin = -1,
+};
+
+static inline pio_sm_config snespad_program_get_default_config(uint offset) {
+    pio_sm_config c = pio_get_default_sm_config();
+    sm_config_set_wrap(&c, offset + snespad_wrap_target, offset + snespad_wrap);
+    sm_config_set_sideset(&c, 2, true, false);
+    return c;
+}
+
+#include "hardware/clocks.h"
+static inline void snespad_program_init(PIO pio, uint sm, uint offset, uint clockPin, uint latchPin, uint dataPin) {
+    pio_gpio_init(pio, clockPin);
+    pio_gpio_init(pio, latchPin);
+    pio_gpio_init(pio, dataPin);
+    gpio_pull_up(dataPin);
+    // clock idles high, latch idles low
+    pio_sm_set_pins_with_mask(pio, sm, (1u << clockPin), (1u << clockPin) | (1u << latchPin));
+    pio_sm_set_consecutive_pindirs(pio, sm, clockPin, 1, true);
+    pio_sm_set_consecutive_pindirs(pio, sm, latchPin, 1, true);
+    pio_sm_set_consecutive_pindirs(pio, sm, dataPin, 1, false);
+    pio_sm_config c = snespad_program_get_default_config(offset);
+    sm_config_set_sideset_pins(&c, clockPin);
+    sm_config_set_set_pins(&c, latchPin, 1);
+    sm_config_set_in_pins(&c, dataPin);
+    sm_config_set_in_shift(&c, true, false, 32);
+    sm_config_set_out_shift(&c, true, false, 32);
+    // 2us per cycle
+    float div = (float)clock_get_hz(clk_sys) / 500000;
+    sm_config_set_clkdiv(&c, div);
+    pio_sm_init(pio, sm, offset, &c);
+    pio_sm_set_enabled(pio, sm, true);
+}
+
+#endif
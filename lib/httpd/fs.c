@@ -68,6 +68,15 @@ fs_open(struct fs_file *file, const char *name)
      return ERR_ARG;
   }
 
+#if LWIP_HTTPD_CUSTOM_FILES
+  /* Custom files are resolved by a single lookup, so check them once up front
+   * instead of for every entry of the flash file list */
+  if (fs_open_custom(file, name)) {
+    file->is_custom_file = 1;
+    return ERR_OK;
+  }
+#endif /* LWIP_HTTPD_CUSTOM_FILES */
+
   for (f = FS_ROOT; f != NULL; f = f->next) {
     if (!strcmp(name, (char *)f->name)) {
       file->data = (const char *)f->data;
@@ -85,14 +94,6 @@ fs_open(struct fs_file *file, const char *name)
 #endif /* #if LWIP_HTTPD_FILE_STATE */
       return ERR_OK;
     }
-
-#if LWIP_HTTPD_CUSTOM_FILES
-  if (fs_open_custom(file, name)) {
-    file->is_custom_file = 1;
-    return ERR_OK;
-  }
-#endif /* LWIP_HTTPD_CUSTOM_FILES */
-
   }
   /* file not found */
   return ERR_VAL;
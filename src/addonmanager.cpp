@@ -7,7 +7,15 @@ bool AddonManager::LoadAddon(GPAddon* addon, ADDON_PROCESS processAt) {
         addon->setup();
         block->ptr = addon;
         block->process = processAt;
+        block->name = addon->name();
+        block->deferred = false;
         addons.push_back(block);
+
+        reinitList[processAt].push_back(addon);
+        if (addon->hasPreprocess())
+            preprocessList[processAt].push_back(addon);
+        if (addon->hasProcess())
+            processList[processAt].push_back(addon);
         return true;
     } else {
         delete addon; // Don't use the memory if we don't have to   
@@ -23,34 +31,86 @@ bool AddonManager::LoadUSBAddon(GPAddon* addon, ADDON_PROCESS processAt) {
     return ret;
 }
 
-void AddonManager::ReinitializeAddons(ADDON_PROCESS processType) {
-    // Loop through all addons and process any that match our type
+// Add-ons whose detection is slow (bus scans, ADC calibration) are queued here and set up once
+// the USB device stack runs. They keep their place in the processing order.
+void AddonManager::DeferAddon(GPAddon* addon, ADDON_PROCESS processAt) {
+    AddonBlock * block = new AddonBlock;
+    block->ptr = addon;
+    block->process = processAt;
+    block->deferred = true;
+    addons.push_back(block);
+}
+
+bool AddonManager::LoadDeferredAddon() {
     for (std::vector<AddonBlock*>::iterator it = addons.begin(); it != addons.end(); it++) {
-        if ( (*it)->process == processType )
-            (*it)->ptr->reinit();
+        AddonBlock * block = *it;
+        if ( !block->deferred )
+            continue;
+
+        GPAddon * addon = block->ptr;
+        if (addon->available()) {
+            addon->setup();
+            block->name = addon->name();
+            block->deferred = false;
+        } else {
+            delete addon;
+            delete block;
+            addons.erase(it);
+        }
+        BuildCallLists();
+        return true;
     }
+    return false;
 }
 
-void AddonManager::PreprocessAddons(ADDON_PROCESS processType) {
-    // Loop through all addons and process any that match our type
-    for (std::vector<AddonBlock*>::iterator it = addons.begin(); it != addons.end(); it++) {
-        if ( (*it)->process == processType )
-            (*it)->ptr->preprocess();
+// Rebuilds the per-phase call lists in load order, skipping add-ons that are still deferred
+void AddonManager::BuildCallLists() {
+    for (int i = 0; i < ADDON_PROCESS_COUNT; i++) {
+        reinitList[i].clear();
+        preprocessList[i].clear();
+        processList[i].clear();
+    }
+    for (AddonBlock * block : addons) {
+        if ( block->deferred )
+            continue;
+        reinitList[block->process].push_back(block->ptr);
+        if (block->ptr->hasPreprocess())
+            preprocessList[block->process].push_back(block->ptr);
+        if (block->ptr->hasProcess())
+            processList[block->process].push_back(block->ptr);
     }
 }
 
+void AddonManager::ReinitializeAddons(ADDON_PROCESS processType) {
+    for (GPAddon* addon : reinitList[processType])
+        addon->reinit();
+}
+
+void AddonManager::PreprocessAddons(ADDON_PROCESS processType) {
+    for (GPAddon* addon : preprocessList[processType])
+        addon->preprocess();
+}
+
 void AddonManager::ProcessAddons(ADDON_PROCESS processType) {
-    // Loop through all addons and process any that match our type
-    for (std::vector<AddonBlock*>::iterator it = addons.begin(); it != addons.end(); it++) {
-        if ( (*it)->process == processType )
-            (*it)->ptr->process();
+    for (GPAddon* addon : processList[processType])
+        addon->process();
+}
+
+// Earliest nextDeadline() of the add-ons processed in this phase
+absolute_time_t AddonManager::NextDeadline(ADDON_PROCESS processType) {
+    absolute_time_t deadline = at_the_end_of_time;
+    for (GPAddon* addon : processList[processType]) {
+        absolute_time_t addonDeadline = addon->nextDeadline();
+        if (absolute_time_diff_us(addonDeadline, deadline) > 0)
+            deadline = addonDeadline;
     }
+    return deadline;
 }
 
 // HACK : change this for NeoPicoLED
 GPAddon * AddonManager::GetAddon(std::string name) { // hack for NeoPicoLED
     for (std::vector<AddonBlock*>::iterator it = addons.begin(); it != addons.end(); it++) {
-        if ( (*it)->ptr->name() == name )
+        if ( !(*it)->deferred && (*it)->name == name )
             return (*it)->ptr;
     }
     return nullptr;
@@ -85,3 +85,16 @@ void BoardLedAddon::process() {
             break;
     }
 }
+
+absolute_time_t BoardLedAddon::nextDeadline() {
+    switch (onBoardLedMode) {
+        case OnBoardLedMode::ON_BOARD_LED_MODE_MODE_INDICATOR:
+            if (!get_usb_mounted())
+                return from_us_since_boot((uint64_t)(timeSinceBlink + BLINK_INTERVAL_USB_UNMOUNTED + 1) * 1000);
+            if (isConfigMode)
+                return from_us_since_boot((uint64_t)(timeSinceBlink + BLINK_INTERVAL_CONFIG_MODE + 1) * 1000);
+            return at_the_end_of_time; // mount changes wake Core1
+        default: // input test follows Core0, auth state is picked up by the idle cap
+            return at_the_end_of_time;
+    }
+}
@@ -2,8 +2,8 @@
 #include "addons/buzzerspeaker.h"
 #include "songs.h"
 #include "storagemanager.h"
+#include "peripheralmanager.h"
 #include "usbdriver.h"
-#include "math.h"
 #include "helper.h"
 #include "config.pb.h"
 
@@ -30,14 +30,32 @@ void BuzzerSpeakerAddon::setup() {
 
 	buzzerVolume = options.volume;
 	introPlayed = false;
+
+	// Tables are picked for the clock GP2040::setup() selected: USB_HOST_SYS_CLOCK_KHZ with USB host, 125 MHz otherwise
+	usbHostClock = PeripheralManager::getInstance().isUSBEnabled(0);
+	currentSong = nullptr;
+	currentNotes = nullptr;
+	currentNotePosition = 0;
+	noteAlarmId = 0;
+
+	// setup() runs on core1, so the pool's alarm IRQ does too. The default pool fires on
+	// core0 and would preempt the input loop; PIO USB keeps its own pool on hardware alarm 2.
+	if (alarmPool == nullptr) {
+		alarmPool = alarm_pool_create_with_unused_hardware_alarm(2);
+	}
 }
 
 void BuzzerSpeakerAddon::process() {
 	if (!introPlayed) {
 		playIntro();
 	}
+}
 
-	processBuzzer();
+// Songs are driven by their own alarm, so only the boot intro needs the loop
+absolute_time_t BuzzerSpeakerAddon::nextDeadline() {
+	if (introPlayed)
+		return at_the_end_of_time;
+	return from_us_since_boot(1000 * 1000);
 }
 
 void BuzzerSpeakerAddon::playIntro() {
@@ -55,51 +73,71 @@ void BuzzerSpeakerAddon::playIntro() {
 	introPlayed = true;
 }
 
-void BuzzerSpeakerAddon::processBuzzer() {
-	if (currentSong == NULL) {
-		return;
-	}
+// Note changes are paced by a core1 hardware alarm rather than the core1 loop, so a busy
+// display or auth pass cannot stretch a note. Returning a negative delay reschedules
+// relative to the previous deadline, keeping the sequence free of drift. play() and stop()
+// run on the same core as the alarm IRQ, so a callback only ever lands between their
+// statements, never alongside them.
+int64_t BuzzerSpeakerAddon::noteAlarm(alarm_id_t id, void *userData) {
+	return ((BuzzerSpeakerAddon*)userData)->nextNote();
+}
 
-	uint32_t currentTimeSong = getMillis() - startedSongMils;
-	uint32_t totalTimeSong = currentSong->song.size() * currentSong->toneDuration;
-	uint16_t currentTonePosition = floor((currentTimeSong * currentSong->song.size()) / totalTimeSong);
-	Tone currentTone = currentSong->song[currentTonePosition];
+int64_t BuzzerSpeakerAddon::nextNote() {
+	const Song *song = currentSong;
+	if (song == nullptr) {
+		return 0;
+	}
 
-	if (currentTonePosition >= currentSong->song.size()) {
-		stop();
-		return;
+	uint16_t position = currentNotePosition + 1;
+	if (position >= song->length) {
+		pwm_set_enabled(buzzerPinSlice, false);
+		currentSong = nullptr;
+		noteAlarmId = 0;
+		return 0;
 	}
 
-	if (currentTone == PAUSE) {
-		pwm_set_enabled (buzzerPinSlice, false);
+	currentNotePosition = position;
+	applyNote(currentNotes[position]);
+	return -((int64_t)song->toneDuration * 1000);
+}
+
+void BuzzerSpeakerAddon::applyNote(const BuzzerNote& note) {
+	if (note.wrap == 0) {
+		pwm_set_enabled(buzzerPinSlice, false);
 		return;
 	}
 
-	pwmSetFreqDuty(buzzerPinSlice, buzzerPinChannel, currentTone, 0.03 * ((float) buzzerVolume));
-	pwm_set_enabled (buzzerPinSlice, true);
+	pwm_set_clkdiv_int_frac(buzzerPinSlice, note.divider16 / 16, note.divider16 & 0xF);
+	pwm_set_wrap(buzzerPinSlice, note.wrap);
+	// 0.03% duty per volume step
+	pwm_set_chan_level(buzzerPinSlice, buzzerPinChannel, ((uint32_t)note.wrap * buzzerVolume * 3) / 10000);
+	pwm_set_enabled(buzzerPinSlice, true);
 }
 
-void BuzzerSpeakerAddon::play(Song *song) {
-	startedSongMils = getMillis();
+void BuzzerSpeakerAddon::play(const Song *song) {
+	stop();
+	if (song == nullptr || song->length == 0) {
+		return;
+	}
+
+	currentNotes = usbHostClock ? song->usbHostNotes : song->notes;
+	currentNotePosition = 0;
 	currentSong = song;
-}
+	applyNote(currentNotes[0]);
 
-void BuzzerSpeakerAddon::stop() {
-	pwm_set_enabled (buzzerPinSlice, false);
-	currentSong = NULL;
+	noteAlarmId = alarm_pool_add_alarm_in_ms(alarmPool, song->toneDuration, noteAlarm, this, true);
+	if (noteAlarmId <= 0) {
+		// no alarm slot available (or the song already ended), leave the speaker quiet
+		noteAlarmId = 0;
+		stop();
+	}
 }
 
-uint32_t BuzzerSpeakerAddon::pwmSetFreqDuty(uint slice, uint channel, uint32_t frequency, float duty) {
-	uint32_t clock = 125000000;
-	uint32_t divider16 = clock / frequency / 4096 +
-							(clock % (frequency * 4096) != 0);
-	if (divider16 / 16 == 0)
-	divider16 = 16;
-	uint32_t wrap = clock * 16 / divider16 / frequency - 1;
-	pwm_set_clkdiv_int_frac(slice, divider16/16,
-										divider16 & 0xF);
-	pwm_set_wrap(slice, wrap);
-	pwm_set_chan_level(slice, channel, wrap * duty / 100);
-	return wrap;
+void BuzzerSpeakerAddon::stop() {
+	if (noteAlarmId > 0) {
+		alarm_pool_cancel_alarm(alarmPool, noteAlarmId);
+		noteAlarmId = 0;
+	}
+	pwm_set_enabled(buzzerPinSlice, false);
+	currentSong = nullptr;
 }
-
@@ -222,6 +222,12 @@ void DisplayAddon::process() {
     }
 }
 
+absolute_time_t DisplayAddon::nextDeadline() {
+    if (gpDisplay->getDriver() == nullptr)
+        return at_the_end_of_time;
+    return make_timeout_time_ms(DISPLAY_FRAME_INTERVAL_MS);
+}
+
 const DisplayOptions& DisplayAddon::getDisplayOptions() {
     bool configMode = Storage::getInstance().GetConfigMode();
     return configMode ? Storage::getInstance().getPreviewDisplayOptions() : Storage::getInstance().getDisplayOptions();
@@ -26,9 +26,9 @@ void DRV8833RumbleAddon::setup() {
 	dutyMin = options.dutyMin;
 	dutyMax = options.dutyMax;
 
-	// TODO: More robust clock check. Currently just assumes 120 MHz if USB Enabled, 125 MHz otherwise.
+	// TODO: More robust clock check. Currently just assumes the USB host clock if USB Enabled, 125 MHz otherwise.
 	if ( PeripheralManager::getInstance().isUSBEnabled(0) )
-		sysClock = 120000000;
+		sysClock = USB_HOST_SYS_CLOCK_KHZ * 1000;
 	else
 		sysClock = 125000000;
 
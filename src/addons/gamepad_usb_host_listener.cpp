@@ -7,19 +7,21 @@ void GamepadUSBHostListener::setup() {
     _controller_host_enabled = false;
 }
 
+// Runs on Core0, reports are decoded on the USB host core and picked up from the mailbox
 void GamepadUSBHostListener::process() {
     Gamepad *gamepad = Storage::getInstance().GetGamepad();
+    _controller_host_mailbox.read(_controller_host_report);
     gamepad->hasAnalogTriggers = true;
     gamepad->hasLeftAnalogStick = true;
     gamepad->hasRightAnalogStick = true;
-    gamepad->state.dpad     |= _controller_host_state.dpad;
-    gamepad->state.buttons  |= _controller_host_state.buttons;
-    gamepad->state.lx       = _controller_host_state.lx;
-    gamepad->state.ly       = _controller_host_state.ly;
-    gamepad->state.rx       = _controller_host_state.rx;
-    gamepad->state.ry       = _controller_host_state.ry;
-    gamepad->state.rt       = _controller_host_state.rt;
-    gamepad->state.lt       = _controller_host_state.lt;
+    gamepad->state.dpad     |= _controller_host_report.dpad;
+    gamepad->state.buttons  |= _controller_host_report.buttons;
+    gamepad->state.lx       = _controller_host_report.lx;
+    gamepad->state.ly       = _controller_host_report.ly;
+    gamepad->state.rx       = _controller_host_report.rx;
+    gamepad->state.ry       = _controller_host_report.ry;
+    gamepad->state.rt       = _controller_host_report.rt;
+    gamepad->state.lt       = _controller_host_report.lt;
 }
 
 void GamepadUSBHostListener::mount(uint8_t dev_addr, uint8_t instance, uint8_t const* desc_report, uint16_t desc_len) {
@@ -44,6 +46,7 @@ void GamepadUSBHostListener::report_received(uint8_t dev_addr, uint8_t instance,
     if ( itf_protocol == HID_ITF_PROTOCOL_KEYBOARD ) return;
 
     process_ctrlr_report(dev_addr, report, len);
+    _controller_host_mailbox.post(_controller_host_state);
 }
 
 void GamepadUSBHostListener::process_ctrlr_report(uint8_t dev_addr, uint8_t const* report, uint16_t len) {
@@ -1,10 +1,26 @@
 #include "addons/i2canalog1219.h"
 #include "storagemanager.h"
 #include "helper.h"
+#include "taskmanager.h"
 #include "config.pb.h"
 
-#define ADS_MAX (float)((1 << 23) - 1)
-#define VREF_VOLTAGE 2.048f
+#include "hardware/gpio.h"
+#include "hardware/irq.h"
+
+// Positive full scale of the 24-bit result is 2^23 - 1, shifting by 7 keeps the top 16 bits
+#define ADS_SAMPLE_SHIFT 7
+
+// Set on the DRDY falling edge, the sample itself is read from the input loop since
+// the I2C bus is shared with other devices and can't be used from an interrupt
+static volatile bool conversionReady = false;
+static uint drdyIRQPin;
+
+static void __not_in_flash_func(drdyIRQ)() {
+    if ( gpio_get_irq_event_mask(drdyIRQPin) & GPIO_IRQ_EDGE_FALL ) {
+        gpio_acknowledge_irq(drdyIRQPin, GPIO_IRQ_EDGE_FALL);
+        conversionReady = true;
+    }
+}
 
 bool I2CAnalog1219Input::available() {
     const AnalogADS1219Options& options = Storage::getInstance().getAddonOptions().analogADS1219Options;
@@ -27,9 +43,7 @@ void I2CAnalog1219Input::setup() {
 
     memset(&pins, 0, sizeof(ADS_PINS));
     channelHop = 0;
-
-    uIntervalMS = 1;
-    nextTimer = getMillis();
+    drdyPin = options.drdyPin;
 
     // Init our ADS1219 library
     ads->begin();                               // setup I2C and chip start
@@ -39,27 +53,45 @@ void I2CAnalog1219Input::setup() {
     ads->setDataRate(1000);                     // 1mhz (1.1ms delay)
     ads->setVoltageReference(REF_INTERNAL);     // Use internal VREF for now
     ads->start();                               // START/SYNC command
+
+    if ( isValidPin(drdyPin) ) {
+        // DRDY is an active low, open drain output
+        drdyIRQPin = drdyPin;
+        gpio_init(drdyPin);
+        gpio_set_dir(drdyPin, GPIO_IN);
+        gpio_pull_up(drdyPin);
+        gpio_add_raw_irq_handler(drdyPin, drdyIRQ);
+        gpio_set_irq_enabled(drdyPin, GPIO_IRQ_EDGE_FALL, true);
+        irq_set_enabled(IO_IRQ_BANK0, true);
+    } else {
+        // interval for read (we can't be too fast)
+        TaskManager::getInstance().addPeriodicTask("ads1219", I2C_ANALOG1219_READ_INTERVAL_US, [this]() {
+            if ( ads->readRegister(STATUS) & REGISTER_STATUS_DRDY )
+                readChannel();
+        });
+    }
+}
+
+// Switching channels restarts the conversion, so the next DRDY belongs to the new channel
+void I2CAnalog1219Input::readChannel()
+{
+    int32_t readValue = (int32_t)ads->readConversionResult();
+    pins.A[channelHop] = (readValue > 0) ? (uint16_t)(readValue >> ADS_SAMPLE_SHIFT) : 0;
+    channelHop = (channelHop+1) % 4; // Loop 0-3
+    ads->setChannel(channelHop);
 }
 
 void I2CAnalog1219Input::process()
 {
-    if (nextTimer < getMillis()) {
-        float result;
-        uint32_t readValue;
-        if ( ads->readRegister(STATUS) & REGISTER_STATUS_DRDY ) {
-            readValue = ads->readConversionResult();
-            result = readValue / float(ADS_MAX); // gives us 0.0f to 1.0f (actual voltage is times voltage)
-            pins.A[channelHop] = result;
-            channelHop = (channelHop+1) % 4; // Loop 0-3
-            ads->setChannel(channelHop);
-            nextTimer = getMillis() + uIntervalMS; // interval for read (we can't be too fast)
-        }
+    // A DRDY edge that came in before the channel switch was for the old channel
+    if ( conversionReady ) {
+        readChannel();
+        conversionReady = false;
     }
 
     Gamepad * gamepad = Storage::getInstance().GetGamepad();
-    gamepad->state.lx = (uint16_t)(65535.f*pins.A[0]);
-    gamepad->state.ly = (uint16_t)(65535.f*pins.A[1]);
-    gamepad->state.rx = (uint16_t)(65535.f*pins.A[2]);
-    gamepad->state.ry = (uint16_t)(65535.f*pins.A[3]);
-
+    gamepad->state.lx = pins.A[0];
+    gamepad->state.ly = pins.A[1];
+    gamepad->state.rx = pins.A[2];
+    gamepad->state.ry = pins.A[3];
 }
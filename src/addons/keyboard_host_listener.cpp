@@ -5,48 +5,40 @@
 
 #define DEV_ADDR_NONE 0xFF
 
+void KeyboardHostListener::mapKey(uint8_t key, uint8_t dpad, uint32_t buttons) {
+  if (key > HID_KEY_NONE && key <= HID_KEY_GUI_RIGHT) {
+    _keyboard_host_keymap[key].dpad |= dpad;
+    _keyboard_host_keymap[key].buttons |= buttons;
+  }
+}
+
 void KeyboardHostListener::setup() {
   const KeyboardHostOptions& keyboardHostOptions = Storage::getInstance().getAddonOptions().keyboardHostOptions;
   const KeyboardMapping& keyboardMapping = keyboardHostOptions.mapping;
 
-  _keyboard_host_mapDpadUp.setMask(GAMEPAD_MASK_UP);
-  _keyboard_host_mapDpadDown.setMask(GAMEPAD_MASK_DOWN);
-  _keyboard_host_mapDpadLeft.setMask(GAMEPAD_MASK_LEFT);
-  _keyboard_host_mapDpadRight.setMask(GAMEPAD_MASK_RIGHT);
-  _keyboard_host_mapButtonB1.setMask(GAMEPAD_MASK_B1);
-  _keyboard_host_mapButtonB2.setMask(GAMEPAD_MASK_B2);
-  _keyboard_host_mapButtonB3.setMask(GAMEPAD_MASK_B3);
-  _keyboard_host_mapButtonB4.setMask(GAMEPAD_MASK_B4);
-  _keyboard_host_mapButtonL1.setMask(GAMEPAD_MASK_L1);
-  _keyboard_host_mapButtonR1.setMask(GAMEPAD_MASK_R1);
-  _keyboard_host_mapButtonL2.setMask(GAMEPAD_MASK_L2);
-  _keyboard_host_mapButtonR2.setMask(GAMEPAD_MASK_R2);
-  _keyboard_host_mapButtonS1.setMask(GAMEPAD_MASK_S1);
-  _keyboard_host_mapButtonS2.setMask(GAMEPAD_MASK_S2);
-  _keyboard_host_mapButtonL3.setMask(GAMEPAD_MASK_L3);
-  _keyboard_host_mapButtonR3.setMask(GAMEPAD_MASK_R3);
-  _keyboard_host_mapButtonA1.setMask(GAMEPAD_MASK_A1);
-  _keyboard_host_mapButtonA2.setMask(GAMEPAD_MASK_A2);
-  _keyboard_host_mapDpadUp.setKey(keyboardMapping.keyDpadUp);
-  _keyboard_host_mapDpadDown.setKey(keyboardMapping.keyDpadDown);
-  _keyboard_host_mapDpadLeft.setKey(keyboardMapping.keyDpadLeft);
-  _keyboard_host_mapDpadRight.setKey(keyboardMapping.keyDpadRight);
-  _keyboard_host_mapButtonB1.setKey(keyboardMapping.keyButtonB1);
-  _keyboard_host_mapButtonB2.setKey(keyboardMapping.keyButtonB2);
-  _keyboard_host_mapButtonR2.setKey(keyboardMapping.keyButtonR2);
-  _keyboard_host_mapButtonL2.setKey(keyboardMapping.keyButtonL2);
-  _keyboard_host_mapButtonB3.setKey(keyboardMapping.keyButtonB3);
-  _keyboard_host_mapButtonB4.setKey(keyboardMapping.keyButtonB4);
-  _keyboard_host_mapButtonR1.setKey(keyboardMapping.keyButtonR1);
-  _keyboard_host_mapButtonL1.setKey(keyboardMapping.keyButtonL1);
-  _keyboard_host_mapButtonS1.setKey(keyboardMapping.keyButtonS1);
-  _keyboard_host_mapButtonS2.setKey(keyboardMapping.keyButtonS2);
-  _keyboard_host_mapButtonL3.setKey(keyboardMapping.keyButtonL3);
-  _keyboard_host_mapButtonR3.setKey(keyboardMapping.keyButtonR3);
-  _keyboard_host_mapButtonA1.setKey(keyboardMapping.keyButtonA1);
-  _keyboard_host_mapButtonA2.setKey(keyboardMapping.keyButtonA2);
-  _keyboard_host_mapButtonA3.setKey(keyboardMapping.keyButtonA3);
-  _keyboard_host_mapButtonA4.setKey(keyboardMapping.keyButtonA4);
+  // Every keycode resolves to its gamepad inputs with a single table lookup
+  memset(_keyboard_host_keymap, 0, sizeof(_keyboard_host_keymap));
+  mapKey(keyboardMapping.keyDpadUp, GAMEPAD_MASK_UP, 0);
+  mapKey(keyboardMapping.keyDpadDown, GAMEPAD_MASK_DOWN, 0);
+  mapKey(keyboardMapping.keyDpadLeft, GAMEPAD_MASK_LEFT, 0);
+  mapKey(keyboardMapping.keyDpadRight, GAMEPAD_MASK_RIGHT, 0);
+  mapKey(keyboardMapping.keyButtonB1, 0, GAMEPAD_MASK_B1);
+  mapKey(keyboardMapping.keyButtonB2, 0, GAMEPAD_MASK_B2);
+  mapKey(keyboardMapping.keyButtonB3, 0, GAMEPAD_MASK_B3);
+  mapKey(keyboardMapping.keyButtonB4, 0, GAMEPAD_MASK_B4);
+  mapKey(keyboardMapping.keyButtonL1, 0, GAMEPAD_MASK_L1);
+  mapKey(keyboardMapping.keyButtonR1, 0, GAMEPAD_MASK_R1);
+  mapKey(keyboardMapping.keyButtonL2, 0, GAMEPAD_MASK_L2);
+  mapKey(keyboardMapping.keyButtonR2, 0, GAMEPAD_MASK_R2);
+  mapKey(keyboardMapping.keyButtonS1, 0, GAMEPAD_MASK_S1);
+  mapKey(keyboardMapping.keyButtonS2, 0, GAMEPAD_MASK_S2);
+  mapKey(keyboardMapping.keyButtonL3, 0, GAMEPAD_MASK_L3);
+  mapKey(keyboardMapping.keyButtonR3, 0, GAMEPAD_MASK_R3);
+  mapKey(keyboardMapping.keyButtonA1, 0, GAMEPAD_MASK_A1);
+  mapKey(keyboardMapping.keyButtonA2, 0, GAMEPAD_MASK_A2);
+  // A3 and A4 keys have never driven an input from a host keyboard
+  _keyboard_host_field_count = 0;
+  _keyboard_host_report_ids = false;
 
   mouseLeftMapping = keyboardHostOptions.mouseLeft;
   mouseMiddleMapping = keyboardHostOptions.mouseMiddle;
@@ -63,32 +55,37 @@ void KeyboardHostListener::setup() {
   mouseX = 0;
   mouseY = 0;
   mouseZ = 0;
-  mouseActive = false;
+  mouseReports = 0;
+  mouseReportsSeen = 0;
+  _keyboard_host_report = {};
 }
 
+// Runs on Core0, reports are decoded on the USB host core and picked up from the mailbox
 void KeyboardHostListener::process() {
   Gamepad *gamepad = Storage::getInstance().GetGamepad();
+  _keyboard_host_mailbox.read(_keyboard_host_report);
+  const GamepadState& hostState = _keyboard_host_report.state;
   if (_keyboard_host_mounted == true || _mouse_host_mounted == true) {
-    gamepad->state.dpad     |= _keyboard_host_state.dpad;
-    gamepad->state.buttons  |= _keyboard_host_state.buttons;
-    gamepad->state.lx       |= _keyboard_host_state.lx;
-    gamepad->state.ly       |= _keyboard_host_state.ly;
-    gamepad->state.rx       |= _keyboard_host_state.rx;
-    gamepad->state.ry       |= _keyboard_host_state.ry;
+    gamepad->state.dpad     |= hostState.dpad;
+    gamepad->state.buttons  |= hostState.buttons;
+    gamepad->state.lx       |= hostState.lx;
+    gamepad->state.ly       |= hostState.ly;
+    gamepad->state.rx       |= hostState.rx;
+    gamepad->state.ry       |= hostState.ry;
     if (!gamepad->hasAnalogTriggers) {
-        gamepad->state.lt       |= _keyboard_host_state.lt;
-        gamepad->state.rt       |= _keyboard_host_state.rt;
+        gamepad->state.lt       |= hostState.lt;
+        gamepad->state.rt       |= hostState.rt;
     }
   }
 
   if ( _mouse_host_mounted == true ) {
+    bool mouseActive = (_keyboard_host_report.mouseReports != mouseReportsSeen);
     gamepad->auxState.sensors.mouse.active = mouseActive;
     if ( mouseActive == true ) {
-        gamepad->auxState.sensors.mouse.active = true;
-        gamepad->auxState.sensors.mouse.x = mouseX;
-        gamepad->auxState.sensors.mouse.y = mouseY;
-        gamepad->auxState.sensors.mouse.z = mouseZ;
-        mouseActive = false;
+        gamepad->auxState.sensors.mouse.x = _keyboard_host_report.mouseX;
+        gamepad->auxState.sensors.mouse.y = _keyboard_host_report.mouseY;
+        gamepad->auxState.sensors.mouse.z = _keyboard_host_report.mouseZ;
+        mouseReportsSeen = _keyboard_host_report.mouseReports;
     }
   }
 }
@@ -102,6 +99,12 @@ void KeyboardHostListener::mount(uint8_t dev_addr, uint8_t instance, uint8_t con
         _keyboard_host_mounted = true;
         _keyboard_dev_addr = dev_addr;
         _keyboard_instance = instance;
+
+        // Boot protocol only carries 6 keys, switch keyboards that describe an NKRO
+        // bitmap over to report protocol and decode them through their descriptor
+        if (parseKeyboardDescriptor(desc_report, desc_len)) {
+            tuh_hid_set_protocol(dev_addr, instance, HID_PROTOCOL_REPORT);
+        }
     } else if (_mouse_host_mounted == false && itf_protocol == HID_ITF_PROTOCOL_MOUSE) {
         Gamepad *gamepad = Storage::getInstance().GetGamepad();
         gamepad->auxState.sensors.mouse.enabled = true;
@@ -116,6 +119,8 @@ void KeyboardHostListener::unmount(uint8_t dev_addr) {
         _keyboard_host_mounted = false;
         _keyboard_dev_addr = DEV_ADDR_NONE;
         _keyboard_instance = 0;
+        _keyboard_host_field_count = 0;
+        _keyboard_host_report_ids = false;
     } else if ( _mouse_host_mounted == true && _mouse_dev_addr == dev_addr ) {
         Gamepad *gamepad = Storage::getInstance().GetGamepad();
         gamepad->auxState.sensors.mouse.enabled = false;
@@ -132,25 +137,115 @@ if ( _keyboard_host_mounted == false && _mouse_host_mounted == false )
 
   // tuh_hid_report_received_cb() will be invoked when report is available
   if ( _keyboard_host_mounted == true && _keyboard_dev_addr == dev_addr && _keyboard_instance == instance ) {
-    process_kbd_report(dev_addr, (hid_keyboard_report_t const*) report );
+    if ( _keyboard_host_field_count > 0 && tuh_hid_get_protocol(dev_addr, instance) == HID_PROTOCOL_REPORT ) {
+      process_nkro_report(report, len);
+    } else {
+      process_kbd_report(dev_addr, (hid_keyboard_report_t const*) report );
+    }
   } else if ( _mouse_host_mounted == true && _mouse_dev_addr == dev_addr && _mouse_instance == instance) {
     process_mouse_report(dev_addr, (hid_mouse_report_t const*) report );
+  } else {
+    return;
   }
+
+  post_report();
+}
+
+void KeyboardHostListener::post_report() {
+  KeyboardHostReport hostReport;
+  hostReport.state = _keyboard_host_state;
+  hostReport.mouseX = mouseX;
+  hostReport.mouseY = mouseY;
+  hostReport.mouseZ = mouseZ;
+  hostReport.mouseReports = mouseReports;
+  _keyboard_host_mailbox.post(hostReport);
 }
 
-uint8_t KeyboardHostListener::getKeycodeFromModifier(uint8_t modifier) {
-	switch (modifier) {
-	  case KEYBOARD_MODIFIER_LEFTCTRL   : return HID_KEY_CONTROL_LEFT ;
-	  case KEYBOARD_MODIFIER_LEFTSHIFT  : return HID_KEY_SHIFT_LEFT   ;
-	  case KEYBOARD_MODIFIER_LEFTALT    : return HID_KEY_ALT_LEFT     ;
-	  case KEYBOARD_MODIFIER_LEFTGUI    : return HID_KEY_GUI_LEFT     ;
-	  case KEYBOARD_MODIFIER_RIGHTCTRL  : return HID_KEY_CONTROL_RIGHT;
-	  case KEYBOARD_MODIFIER_RIGHTSHIFT : return HID_KEY_SHIFT_RIGHT  ;
-	  case KEYBOARD_MODIFIER_RIGHTALT   : return HID_KEY_ALT_RIGHT    ;
-	  case KEYBOARD_MODIFIER_RIGHTGUI   : return HID_KEY_GUI_RIGHT    ;
-	}
-
-	return 0;
+// Collects the keyboard usage page input fields of a report descriptor, returns true
+// when one of them is a key bitmap beyond the modifiers (NKRO)
+bool KeyboardHostListener::parseKeyboardDescriptor(uint8_t const* desc_report, uint16_t desc_len) {
+  uint16_t usagePage = 0;
+  uint8_t reportSize = 0;
+  uint16_t reportCount = 0;
+  uint16_t usageMin = 0;
+  bool hasUsageMin = false;
+  uint16_t bitOffset = 0;
+  bool hasNKRO = false;
+
+  _keyboard_host_field_count = 0;
+  _keyboard_host_report_ids = false;
+
+  uint8_t reportId = 0;
+  while (desc_len > 0) {
+    uint8_t header = *desc_report++;
+    desc_len--;
+
+    // long items carry their own size and are never keyboard inputs
+    if (header == 0xFE) {
+      if (desc_len < 2 || (uint16_t)(desc_report[0] + 2) > desc_len)
+        break;
+      desc_len -= desc_report[0] + 2;
+      desc_report += desc_report[0] + 2;
+      continue;
+    }
+
+    uint8_t size = header & 0x03;
+    if (size == 3)
+      size = 4;
+    if (size > desc_len)
+      break;
+
+    uint32_t data = 0;
+    for (uint8_t i = 0; i < size; i++)
+      data |= (uint32_t)desc_report[i] << (8 * i);
+    desc_report += size;
+    desc_len -= size;
+
+    uint8_t type = (header >> 2) & 0x03;
+    uint8_t tag = header >> 4;
+    if (type == RI_TYPE_MAIN) {
+      if (tag == RI_MAIN_INPUT) {
+        if (usagePage == HID_USAGE_PAGE_KEYBOARD && !(data & HID_CONSTANT) &&
+            _keyboard_host_field_count < KEYBOARD_HOST_MAX_REPORT_FIELDS) {
+          KeyboardReportField& field = _keyboard_host_fields[_keyboard_host_field_count];
+          field.reportId = reportId;
+          field.bitOffset = bitOffset;
+          field.count = reportCount;
+          field.usageMin = usageMin;
+          if ((data & HID_VARIABLE) && reportSize == 1 && hasUsageMin && usageMin <= 0xFF) {
+            field.isBitmap = true;
+            _keyboard_host_field_count++;
+            if (usageMin < HID_KEY_CONTROL_LEFT)
+              hasNKRO = true;
+          } else if (!(data & HID_VARIABLE) && reportSize == 8 && (bitOffset & 0x07) == 0) {
+            field.isBitmap = false;
+            _keyboard_host_field_count++;
+          }
+        }
+        bitOffset += reportSize * reportCount;
+      }
+      hasUsageMin = false;
+      usageMin = 0;
+    } else if (type == RI_TYPE_GLOBAL) {
+      switch (tag) {
+        case RI_GLOBAL_USAGE_PAGE: usagePage = data; break;
+        case RI_GLOBAL_REPORT_SIZE: reportSize = data; break;
+        case RI_GLOBAL_REPORT_COUNT: reportCount = data; break;
+        case RI_GLOBAL_REPORT_ID:
+          reportId = data;
+          bitOffset = 0;
+          _keyboard_host_report_ids = true;
+          break;
+      }
+    } else if (type == RI_TYPE_LOCAL && tag == RI_LOCAL_USAGE_MIN) {
+      usageMin = data & 0xFFFF;
+      hasUsageMin = true;
+    }
+  }
+
+  if (!hasNKRO)
+    _keyboard_host_field_count = 0;
+  return hasNKRO;
 }
 
 void KeyboardHostListener::preprocess_report()
@@ -170,51 +265,83 @@ void KeyboardHostListener::preprocess_report()
   _keyboard_host_state.rt = 0;
 }
 
-// convert hid keycode to ascii and print via usb device CDC (ignore non-printable)
 void KeyboardHostListener::process_kbd_report(uint8_t dev_addr, hid_keyboard_report_t const *report)
 {
   preprocess_report();
 
-  // make this 13 instead of 7 to include modifier bitfields from hid_keyboard_modifier_bm_t
-  for(uint8_t i=0; i<13; i++)
+  // keycode 0 maps to nothing, so empty slots need no check
+  for(uint8_t i=0; i<6; i++)
   {
-    uint8_t keycode = 0;
-    if (i < 6) {
-        // process keycodes normally
-        keycode = report->keycode[i];
-    } else {
-        // keycode modifiers are bitfields, so the old getKeycodeFromModifier switch approach doesn't work
-        // keycode = getKeycodeFromModifier(report->modifier);
-        // new approach masks the modifier bit to determine which keys are pressed
-        keycode = getKeycodeFromModifier(report->modifier & (1 << (i - 6)));
-    }
-    if ( keycode )
+    const KeyboardKeyMask& mask = _keyboard_host_keymap[report->keycode[i]];
+    _keyboard_host_state.dpad |= mask.dpad;
+    _keyboard_host_state.buttons |= mask.buttons;
+  }
+
+  // modifier bits line up with the keycodes from HID_KEY_CONTROL_LEFT onwards
+  uint8_t modifier = report->modifier;
+  while (modifier)
+  {
+    const KeyboardKeyMask& mask = _keyboard_host_keymap[HID_KEY_CONTROL_LEFT + __builtin_ctz(modifier)];
+    _keyboard_host_state.dpad |= mask.dpad;
+    _keyboard_host_state.buttons |= mask.buttons;
+    modifier &= modifier - 1;
+  }
+}
+
+void KeyboardHostListener::process_nkro_report(uint8_t const* report, uint16_t len)
+{
+  uint8_t reportId = 0;
+  if (_keyboard_host_report_ids) {
+    if (len == 0)
+      return;
+    reportId = *report++;
+    len--;
+  }
+
+  // reports from other collections on the interface (consumer keys etc.) leave the state alone
+  bool isKeyboardReport = false;
+  for (uint8_t f = 0; f < _keyboard_host_field_count; f++)
+    isKeyboardReport |= (_keyboard_host_fields[f].reportId == reportId);
+  if (!isKeyboardReport)
+    return;
+
+  preprocess_report();
+
+  for (uint8_t f = 0; f < _keyboard_host_field_count; f++)
+  {
+    const KeyboardReportField& field = _keyboard_host_fields[f];
+    if (field.reportId != reportId)
+      continue;
+
+    for (uint16_t i = 0; i < field.count; i++)
     {
-      _keyboard_host_state.dpad |=
-            ((keycode == _keyboard_host_mapDpadUp.key)    ? _keyboard_host_mapDpadUp.buttonMask : _keyboard_host_state.dpad)
-          | ((keycode == _keyboard_host_mapDpadDown.key)  ? _keyboard_host_mapDpadDown.buttonMask : _keyboard_host_state.dpad)
-          | ((keycode == _keyboard_host_mapDpadLeft.key)  ? _keyboard_host_mapDpadLeft.buttonMask  : _keyboard_host_state.dpad)
-          | ((keycode == _keyboard_host_mapDpadRight.key) ? _keyboard_host_mapDpadRight.buttonMask : _keyboard_host_state.dpad)
-        ;
-
-        _keyboard_host_state.buttons |=
-            ((keycode == _keyboard_host_mapButtonB1.key)  ? _keyboard_host_mapButtonB1.buttonMask  : _keyboard_host_state.buttons)
-          | ((keycode == _keyboard_host_mapButtonB2.key)  ? _keyboard_host_mapButtonB2.buttonMask  : _keyboard_host_state.buttons)
-          | ((keycode == _keyboard_host_mapButtonB3.key)  ? _keyboard_host_mapButtonB3.buttonMask  : _keyboard_host_state.buttons)
-          | ((keycode == _keyboard_host_mapButtonB4.key)  ? _keyboard_host_mapButtonB4.buttonMask  : _keyboard_host_state.buttons)
-          | ((keycode == _keyboard_host_mapButtonL1.key)  ? _keyboard_host_mapButtonL1.buttonMask  : _keyboard_host_state.buttons)
-          | ((keycode == _keyboard_host_mapButtonR1.key)  ? _keyboard_host_mapButtonR1.buttonMask  : _keyboard_host_state.buttons)
-          | ((keycode == _keyboard_host_mapButtonL2.key)  ? _keyboard_host_mapButtonL2.buttonMask  : _keyboard_host_state.buttons)
-          | ((keycode == _keyboard_host_mapButtonR2.key)  ? _keyboard_host_mapButtonR2.buttonMask  : _keyboard_host_state.buttons)
-          | ((keycode == _keyboard_host_mapButtonS1.key)  ? _keyboard_host_mapButtonS1.buttonMask  : _keyboard_host_state.buttons)
-          | ((keycode == _keyboard_host_mapButtonS2.key)  ? _keyboard_host_mapButtonS2.buttonMask  : _keyboard_host_state.buttons)
-          | ((keycode == _keyboard_host_mapButtonL3.key)  ? _keyboard_host_mapButtonL3.buttonMask  : _keyboard_host_state.buttons)
-          | ((keycode == _keyboard_host_mapButtonR3.key)  ? _keyboard_host_mapButtonR3.buttonMask  : _keyboard_host_state.buttons)
-          | ((keycode == _keyboard_host_mapButtonA1.key)  ? _keyboard_host_mapButtonA1.buttonMask  : _keyboard_host_state.buttons)
-          | ((keycode == _keyboard_host_mapButtonA2.key)  ? _keyboard_host_mapButtonA2.buttonMask  : _keyboard_host_state.buttons)
-          | ((keycode == _keyboard_host_mapButtonA3.key)  ? _keyboard_host_mapButtonA3.buttonMask  : _keyboard_host_state.buttons)
-          | ((keycode == _keyboard_host_mapButtonA4.key)  ? _keyboard_host_mapButtonA4.buttonMask  : _keyboard_host_state.buttons)
-        ;
+      uint16_t keycode;
+      if (field.isBitmap) {
+        uint16_t bit = field.bitOffset + i;
+        if ((bit >> 3) >= len)
+          break;
+        uint8_t bits = report[bit >> 3] >> (bit & 0x07);
+        if (bits == 0) {
+          // nothing else set in this byte
+          i += 7 - (bit & 0x07);
+          continue;
+        }
+        if (!(bits & 0x01))
+          continue;
+        keycode = field.usageMin + i;
+      } else {
+        uint16_t index = (field.bitOffset >> 3) + i;
+        if (index >= len)
+          break;
+        keycode = report[index];
+      }
+
+      if (keycode > 0xFF)
+        break;
+
+      const KeyboardKeyMask& mask = _keyboard_host_keymap[keycode];
+      _keyboard_host_state.dpad |= mask.dpad;
+      _keyboard_host_state.buttons |= mask.buttons;
     }
   }
 }
@@ -234,5 +361,5 @@ void KeyboardHostListener::process_mouse_report(uint8_t dev_addr, hid_mouse_repo
   mouseX = report->x;
   mouseY = report->y;
   mouseZ = report->wheel;
-  mouseActive = true;
+  mouseReports++;
 }
@@ -15,6 +15,7 @@
 #include "usbdriver.h"
 #include "enums.h"
 #include "helper.h"
+#include "peripheralmanager.h"
 
 const std::string BUTTON_LABEL_UP = "Up";
 const std::string BUTTON_LABEL_DOWN = "Down";
@@ -222,6 +223,13 @@ void NeoPicoLEDAddon::setup()
     nextRunTime = make_timeout_time_ms(0); // Reset timeout
 }
 
+absolute_time_t NeoPicoLEDAddon::nextDeadline()
+{
+    if (!isValidPin(Storage::getInstance().getLedOptions().dataPin))
+        return at_the_end_of_time;
+    return nextRunTime;
+}
+
 void NeoPicoLEDAddon::process()
 {
     const LEDOptions& ledOptions = Storage::getInstance().getLedOptions();
@@ -264,44 +272,69 @@ void NeoPicoLEDAddon::process()
         as.HandleEvent(action);
     }
 
+    // Everything besides the animation that ends up in the frame
+    bool suspended = turnOffWhenSuspended && get_usb_suspended();
+    uint32_t overlayState[NEOPICO_OVERLAY_STATE_SIZE] = {
+        suspended,
+        AnimationStation::GetBrightness(),
+        gamepad->auxState.turbo.activity,
+        (uint32_t)(gamepad->auxState.sensors.statusLight.active << 24) | (gamepad->auxState.sensors.statusLight.color.red << 16) | (gamepad->auxState.sensors.statusLight.color.green << 8) | gamepad->auxState.sensors.statusLight.color.blue,
+    };
+    if (neoPLEDs != nullptr) {
+        for (int i = 0; i < PLED_COUNT; i++)
+            overlayState[4 + i] = neoPLEDs->getLedLevels()[i];
+    }
+
+    // Nothing changed and the animation would repeat itself: leave the strip as it is
     uint32_t buttonState = gamepad->state.dpad << 16 | gamepad->state.buttons;
-    vector<Pixel> pressed;
-    for (auto row : matrix.pixels)
-    {
-        for (auto pixel : row)
-        {
-            if (buttonState & pixel.mask)
-                pressed.push_back(pixel);
+    uint32_t buttonChanges = buttonState ^ lastButtonState;
+    bool overlayChanged = memcmp(overlayState, lastOverlayState, sizeof(overlayState)) != 0;
+    if (!frameDirty && buttonChanges == 0 && action == HOTKEY_LEDS_NONE && !overlayChanged && as.IsSettled()) {
+        this->nextRunTime = make_timeout_time_ms(NeoPicoLEDAddon::intervalMS);
+        return;
+    }
+    frameDirty = false;
+    lastButtonState = buttonState;
+    memcpy(lastOverlayState, overlayState, sizeof(overlayState));
+
+    if (buttonChanges != 0) {
+        vector<Pixel> pressed;
+        for (auto &row : matrix.pixels)
+        {
+            for (auto &pixel : row)
+            {
+                if (buttonState & pixel.mask)
+                    pressed.push_back(pixel);
+            }
         }
+        if (pressed.size() > 0)
+            as.HandlePressed(pressed);
+        else
+            as.ClearPressed();
     }
-    if (pressed.size() > 0)
-        as.HandlePressed(pressed);
-    else
-        as.ClearPressed();
 
     as.Animate();
 
-    if (turnOffWhenSuspended && get_usb_suspended()) {
+    if (suspended) {
         as.DimBrightnessTo0();
     } else {
         as.SetBrightness(AnimationStation::GetBrightness());
     }
 
-    as.ApplyBrightness(frame);
+    as.ApplyBrightness(frame.data(), frame.size());
 
     // Apply the player LEDs to our first 4 leds if we're in NEOPIXEL mode
     if (ledOptions.pledType == PLED_TYPE_RGB) {
         int32_t pledIndexes[] = { ledOptions.pledIndex1, ledOptions.pledIndex2, ledOptions.pledIndex3, ledOptions.pledIndex4 };
         for (int i = 0; i < PLED_COUNT; i++) {
-            if (pledIndexes[i] < 0 || pledIndexes[i] > 99)
+            if (pledIndexes[i] < 0 || pledIndexes[i] >= (int32_t)frame.size())
                 continue;
 
-            float level = (static_cast<float>(PLED_MAX_LEVEL - neoPLEDs->getLedLevels()[i]) / static_cast<float>(PLED_MAX_LEVEL));
-            float brightness = as.GetBrightnessX() * level;
+            uint32_t brightness = (as.GetBrightnessScale() * (uint32_t)(PLED_MAX_LEVEL - neoPLEDs->getLedLevels()[i])) / PLED_MAX_LEVEL;
             if (gamepad->auxState.sensors.statusLight.enabled && gamepad->auxState.sensors.statusLight.active) {
-                rgbPLEDValues[i] = (RGB(gamepad->auxState.sensors.statusLight.color.red, gamepad->auxState.sensors.statusLight.color.green, gamepad->auxState.sensors.statusLight.color.blue)).value(neopico->GetFormat(), brightness);
+                rgbPLEDValues[i] = (RGB(gamepad->auxState.sensors.statusLight.color.red, gamepad->auxState.sensors.statusLight.color.green, gamepad->auxState.sensors.statusLight.color.blue)).scaledValue(neopico->GetFormat(), brightness);
             } else {
-                rgbPLEDValues[i] = ((RGB)ledOptions.pledColor).value(neopico->GetFormat(), brightness);
+                rgbPLEDValues[i] = ((RGB)ledOptions.pledColor).scaledValue(neopico->GetFormat(), brightness);
             }
             frame[pledIndexes[i]] = rgbPLEDValues[i];
         }
@@ -310,9 +343,8 @@ void NeoPicoLEDAddon::process()
     // Turbo LED is a separate RGB that is on if turbo is on, and off if its off
     if ( turboOptions.turboLedType == PLED_TYPE_RGB ) { // RGB or PWM?
         if ( gamepad->auxState.turbo.activity == 1) { // Turbo is on (active sensor)
-            if (turboOptions.turboLedIndex >= 0 && turboOptions.turboLedIndex < 100) { // Double check index value
-                float brightness = as.GetBrightnessX();
-                frame[turboOptions.turboLedIndex] = ((RGB)turboOptions.turboLedColor).value(neopico->GetFormat(), brightness);
+            if (turboOptions.turboLedIndex >= 0 && turboOptions.turboLedIndex < (int32_t)frame.size()) { // Double check index value
+                frame[turboOptions.turboLedIndex] = ((RGB)turboOptions.turboLedColor).scaledValue(neopico->GetFormat(), as.GetBrightnessScale());
             }
         }
     }
@@ -321,15 +353,15 @@ void NeoPicoLEDAddon::process()
     if ( ledOptions.caseRGBType == CASE_RGB_TYPE_STATIC &&
         ledOptions.caseRGBIndex >= 0 &&
         ledOptions.caseRGBCount > 0 ) {
-        float brightness = as.GetBrightnessX();
-        uint32_t colorVal = ((RGB)ledOptions.caseRGBColor).value(neopico->GetFormat(), brightness);
-        for(int i = 0; i < ledOptions.caseRGBCount; i++) {
+        uint32_t colorVal = ((RGB)ledOptions.caseRGBColor).scaledValue(neopico->GetFormat(), as.GetBrightnessScale());
+        for(int i = 0; i < ledOptions.caseRGBCount && (ledOptions.caseRGBIndex+i) < (int32_t)frame.size(); i++) {
             frame[ledOptions.caseRGBIndex+i] = colorVal;
         }
     }
 
-    neopico->SetFrame(frame);
-    neopico->Show();
+    neopico->SetFrame(frame.data());
+    if (!neopico->Show())
+        frameDirty = true; // the strip was still latching, send this frame on the next run
     AnimationStore.save();
 
     this->nextRunTime = make_timeout_time_ms(NeoPicoLEDAddon::intervalMS);
@@ -635,9 +667,26 @@ void NeoPicoLEDAddon::configureLEDs()
         ledCount += ledOptions.caseRGBCount;
     }
 
+    // The frame covers every LED that can be addressed, even past the counted ones
+    uint16_t frameSize = std::max<uint16_t>(ledCount, matrix.getFrameSize());
+    if (ledOptions.pledType == PLED_TYPE_RGB) {
+        int32_t pledIndexes[] = { ledOptions.pledIndex1, ledOptions.pledIndex2, ledOptions.pledIndex3, ledOptions.pledIndex4 };
+        for (int i = 0; i < PLED_COUNT; i++)
+            frameSize = std::max<int32_t>(frameSize, pledIndexes[i] + 1);
+    }
+    if (turboOptions.turboLedType == PLED_TYPE_RGB)
+        frameSize = std::max<int32_t>(frameSize, turboOptions.turboLedIndex + 1);
+    if (ledOptions.caseRGBType == CASE_RGB_TYPE_STATIC && ledOptions.caseRGBIndex >= 0)
+        frameSize = std::max<int32_t>(frameSize, ledOptions.caseRGBIndex + ledOptions.caseRGBCount);
+    frame.assign(frameSize, 0);
+
     // Remove the old neopico (config can call this)
     delete neopico;
-    neopico = new NeoPico(ledOptions.dataPin, ledCount, static_cast<LEDFormat>(ledOptions.ledFormat));
+    // PIO USB host starts after the add-ons and streams on its own DMA channel, keep off it
+    uint32_t reservedDMAChannels = 0;
+    if (PeripheralManager::getInstance().isUSBEnabled(0))
+        reservedDMAChannels = 1u << PeripheralManager::getInstance().getUSB(0)->getController()->tx_ch;
+    neopico = new NeoPico(ledOptions.dataPin, frameSize, static_cast<LEDFormat>(ledOptions.ledFormat), reservedDMAChannels);
     neopico->Off();
 
     Animation::format = static_cast<LEDFormat>(ledOptions.ledFormat);
@@ -647,6 +696,7 @@ void NeoPicoLEDAddon::configureLEDs()
     as.SetOptions(animationOptions);
     as.SetMatrix(matrix);
     as.SetMode(as.options.baseAnimationIndex);
+    frameDirty = true;
 }
 
 AnimationHotkey animationHotkeys(Gamepad *gamepad)
@@ -143,6 +143,14 @@ void PlayerLEDAddon::process()
 	}
 }
 
+absolute_time_t PlayerLEDAddon::nextDeadline()
+{
+	// RGB player LEDs are drawn by the NeoPico add-on
+	if (Storage::getInstance().getLedOptions().pledType != PLED_TYPE_PWM)
+		return at_the_end_of_time;
+	return make_timeout_time_ms(PLED_PWM_INTERVAL_MS);
+}
+
 void PWMPlayerLEDs::setup()
 {
 	pwm_config config = pwm_get_default_config();
@@ -2,6 +2,7 @@
 #include "storagemanager.h"
 #include "system.h"
 #include "helper.h"
+#include "taskmanager.h"
 #include "config.pb.h"
 #include "device/usbd.h"
 
@@ -60,10 +61,15 @@ void PlayerNumAddon::process()
 
 void PlayerNumAddon::handleLED(int num) {
     if ( playerNum != num ) {
+        // Stagger the reconnects by player number without stalling core0 until then.
+        //  Without a free task slot nothing would ever reconnect us, reboot right away instead.
+        int task = TaskManager::getInstance().addOneShotTask("player reboot", 2000 * 1000 * playerNum, []() {
+            System::reboot(System::BootMode::GAMEPAD);
+        });
+        if ( task < 0 ) {
+            System::reboot(System::BootMode::GAMEPAD);
+        }
         tud_disconnect();
-        sleep_ms(2000 * playerNum);
-        System::reboot(System::BootMode::GAMEPAD);
-    } else {
-        assigned = 1;
     }
+    assigned = 1;
 }
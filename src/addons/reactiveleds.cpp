@@ -37,8 +37,11 @@ void ReactiveLEDAddon::setup() {
             pwm_set_enabled(pwm_gpio_to_slice_num(ledPins[led].pinNumber), true);
 
             ledPins[led].lastUpdate = to_ms_since_boot(get_absolute_time());
+            ledPins[led].buttonMask = getButtonMask(ledPins[led].action);
 
             setLEDByMode(ledPins[led], false);
+            if (isFading(ledPins[led]))
+                fadingLEDs |= (1U << led);
         }
     }
 }
@@ -46,33 +49,73 @@ void ReactiveLEDAddon::setup() {
 void ReactiveLEDAddon::process() {
     Gamepad * gamepad = Storage::getInstance().GetProcessedGamepad();
 
+    uint32_t buttonState = (gamepad->state.dpad << 16) | gamepad->state.buttons;
+    uint32_t buttonChanges = buttonState ^ lastButtonState;
+    lastButtonState = buttonState;
+
+    // Static LEDs only need touching when their button changes; fades keep stepping until they settle
+    if (buttonChanges == 0 && fadingLEDs == 0)
+        return;
+
     uint32_t currUpdate = to_ms_since_boot(get_absolute_time());
 
     for (uint8_t led = 0; led < REACTIVE_LED_COUNT; led++) {
-        if (isValidPin(ledPins[led].pinNumber) && ledPins[led].action != GpioAction::NONE) {
-            ledPins[led].currUpdate = currUpdate;
-            switch (ledPins[led].action) {
-                case BUTTON_PRESS_UP: setLEDByMode(ledPins[led], gamepad->pressedDpad(GAMEPAD_MASK_UP)); break;
-                case BUTTON_PRESS_DOWN: setLEDByMode(ledPins[led], gamepad->pressedDpad(GAMEPAD_MASK_DOWN)); break;
-                case BUTTON_PRESS_LEFT: setLEDByMode(ledPins[led], gamepad->pressedDpad(GAMEPAD_MASK_LEFT)); break;
-                case BUTTON_PRESS_RIGHT: setLEDByMode(ledPins[led], gamepad->pressedDpad(GAMEPAD_MASK_RIGHT)); break;
-                case BUTTON_PRESS_B1: setLEDByMode(ledPins[led], gamepad->pressedButton(GAMEPAD_MASK_B1)); break;
-                case BUTTON_PRESS_B2: setLEDByMode(ledPins[led], gamepad->pressedButton(GAMEPAD_MASK_B2)); break;
-                case BUTTON_PRESS_B3: setLEDByMode(ledPins[led], gamepad->pressedButton(GAMEPAD_MASK_B3)); break;
-                case BUTTON_PRESS_B4: setLEDByMode(ledPins[led], gamepad->pressedButton(GAMEPAD_MASK_B4)); break;
-                case BUTTON_PRESS_L1: setLEDByMode(ledPins[led], gamepad->pressedButton(GAMEPAD_MASK_L1)); break;
-                case BUTTON_PRESS_R1: setLEDByMode(ledPins[led], gamepad->pressedButton(GAMEPAD_MASK_R1)); break;
-                case BUTTON_PRESS_L2: setLEDByMode(ledPins[led], gamepad->pressedButton(GAMEPAD_MASK_L2)); break;
-                case BUTTON_PRESS_R2: setLEDByMode(ledPins[led], gamepad->pressedButton(GAMEPAD_MASK_R2)); break;
-                case BUTTON_PRESS_S1: setLEDByMode(ledPins[led], gamepad->pressedButton(GAMEPAD_MASK_S1)); break;
-                case BUTTON_PRESS_S2: setLEDByMode(ledPins[led], gamepad->pressedButton(GAMEPAD_MASK_S2)); break;
-                case BUTTON_PRESS_A1: setLEDByMode(ledPins[led], gamepad->pressedButton(GAMEPAD_MASK_A1)); break;
-                case BUTTON_PRESS_A2: setLEDByMode(ledPins[led], gamepad->pressedButton(GAMEPAD_MASK_A2)); break;
-                case BUTTON_PRESS_L3: setLEDByMode(ledPins[led], gamepad->pressedButton(GAMEPAD_MASK_L3)); break;
-                case BUTTON_PRESS_R3: setLEDByMode(ledPins[led], gamepad->pressedButton(GAMEPAD_MASK_R3)); break;
-                default: break;
-            }
-        }
+        if (ledPins[led].buttonMask == 0)
+            continue;
+
+        if (!(buttonChanges & ledPins[led].buttonMask) && !(fadingLEDs & (1U << led)))
+            continue;
+
+        ledPins[led].currUpdate = currUpdate;
+        setLEDByMode(ledPins[led], buttonState & ledPins[led].buttonMask);
+
+        if (isFading(ledPins[led]))
+            fadingLEDs |= (1U << led);
+        else
+            fadingLEDs &= ~(1U << led);
+    }
+}
+
+absolute_time_t ReactiveLEDAddon::nextDeadline() {
+    // Button changes wake Core1, so only running fades need a deadline
+    if (fadingLEDs == 0)
+        return at_the_end_of_time;
+    return make_timeout_time_ms(REACTIVE_LED_DELAY);
+}
+
+bool ReactiveLEDAddon::isFading(const ReactiveLEDPinState &ledState) {
+    switch (ledState.currState ? ledState.modeDown : ledState.modeUp) {
+        case ReactiveLEDMode::REACTIVE_LED_FADE_IN:
+            return ledState.value < REACTIVE_LED_MAX_BRIGHTNESS;
+        case ReactiveLEDMode::REACTIVE_LED_FADE_OUT:
+            return ledState.value > 0;
+        default:
+            return false;
+    }
+}
+
+uint32_t ReactiveLEDAddon::getButtonMask(GpioAction action) {
+    // same layout as the (dpad << 16) | buttons state word used in process()
+    switch (action) {
+        case BUTTON_PRESS_UP: return GAMEPAD_MASK_UP << 16;
+        case BUTTON_PRESS_DOWN: return GAMEPAD_MASK_DOWN << 16;
+        case BUTTON_PRESS_LEFT: return GAMEPAD_MASK_LEFT << 16;
+        case BUTTON_PRESS_RIGHT: return GAMEPAD_MASK_RIGHT << 16;
+        case BUTTON_PRESS_B1: return GAMEPAD_MASK_B1;
+        case BUTTON_PRESS_B2: return GAMEPAD_MASK_B2;
+        case BUTTON_PRESS_B3: return GAMEPAD_MASK_B3;
+        case BUTTON_PRESS_B4: return GAMEPAD_MASK_B4;
+        case BUTTON_PRESS_L1: return GAMEPAD_MASK_L1;
+        case BUTTON_PRESS_R1: return GAMEPAD_MASK_R1;
+        case BUTTON_PRESS_L2: return GAMEPAD_MASK_L2;
+        case BUTTON_PRESS_R2: return GAMEPAD_MASK_R2;
+        case BUTTON_PRESS_S1: return GAMEPAD_MASK_S1;
+        case BUTTON_PRESS_S2: return GAMEPAD_MASK_S2;
+        case BUTTON_PRESS_A1: return GAMEPAD_MASK_A1;
+        case BUTTON_PRESS_A2: return GAMEPAD_MASK_A2;
+        case BUTTON_PRESS_L3: return GAMEPAD_MASK_L3;
+        case BUTTON_PRESS_R3: return GAMEPAD_MASK_R3;
+        default: return 0;
     }
 }
 
@@ -108,7 +151,10 @@ void ReactiveLEDAddon::setLEDByMode(ReactiveLEDPinState &ledState, bool pressed)
             break;
     }
 
-    pwm_set_gpio_level(ledState.pinNumber, ledState.value);
+    if (ledState.value != ledState.lastValue) {
+        pwm_set_gpio_level(ledState.pinNumber, ledState.value);
+        ledState.lastValue = ledState.value;
+    }
 
     ledState.prevState = pressed;
 }
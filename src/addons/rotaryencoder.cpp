@@ -1,6 +1,7 @@
 #include "addons/rotaryencoder.h"
 
 #include "eventmanager.h"
+#include "peripheralmanager.h"
 #include "storagemanager.h"
 #include "GPEncoderEvent.h"
 #include "types.h"
@@ -9,6 +10,8 @@
 #include "helper.h"
 #include "config.pb.h"
 
+#include "generated/quadrature_encoder.pio.h"
+
 bool RotaryEncoderInput::available() {
     const RotaryOptions& options = Storage::getInstance().getAddonOptions().rotaryOptions;
     return options.enabled;
@@ -44,7 +47,7 @@ void RotaryEncoderInput::setup()
     for (uint8_t i = 0; i < MAX_ENCODERS; i++) {
         encoderValues[i] = 0;
    
-        if (encoderMap[i].enabled) {
+        if (encoderMap[i].enabled && !setupHardwareDecoder(i)) {
             gpio_init(encoderMap[i].pinA);             // Initialize pin
             gpio_set_dir(encoderMap[i].pinA, GPIO_IN); // Set as INPUT
             gpio_pull_up(encoderMap[i].pinA);          // Set as PULLUP
@@ -73,14 +76,22 @@ void RotaryEncoderInput::process()
 
     for (uint8_t i = 0; i < MAX_ENCODERS; i++) {
         if (encoderMap[i].enabled) {
+            uint32_t encoderIncrement = (ENCODER_RADIUS / (encoderMap[i].pulsesPerRevolution / (ENCODER_PRECISION * encoderMap[i].multiplier)));
+
+            if (encoderState[i].sm != -1) {
+                // the state machine counts every edge, the software decoder below only two per cycle
+                int32_t count = quadrature_encoder_get_count(encoderPio, encoderState[i].sm) >> 1;
+                encoderValues[i] += (count - encoderState[i].count) * encoderState[i].direction * (int32_t)encoderIncrement;
+                encoderState[i].count = count;
+                continue;
+            }
+
             uint32_t lastUpdate = now - encoderState[i].updateTime;
 
             if (lastUpdate >= encoderState[i].delay) {
                 bool pinAValue = gpio_get(encoderMap[i].pinA);
                 bool pinBValue = gpio_get(encoderMap[i].pinB);
 
-                uint32_t encoderIncrement = (ENCODER_RADIUS / (encoderMap[i].pulsesPerRevolution / (ENCODER_PRECISION * encoderMap[i].multiplier)));
-
                 if (encoderState[i].pinA != pinAValue || encoderState[i].pinB != pinBValue) {
                     if ((encoderState[i].pinA == encoderState[i].prevA) && (encoderState[i].pinB == encoderState[i].prevB)) {
                         if ((encoderState[i].pinA && !encoderState[i].pinB && pinBValue) || (!encoderState[i].pinA && encoderState[i].pinB && !pinBValue)) {
@@ -213,6 +224,57 @@ int8_t RotaryEncoderInput::mapEncoderValueDPad(int8_t index, int32_t encoderValu
     }
 }
 
+// PIO USB host loads its TX and RX programs on core1 after the add-ons are set up,
+// so the blocks it is configured for have to be left alone
+bool RotaryEncoderInput::isUSBHostPIO(PIO pio) {
+    if (!PeripheralManager::getInstance().isUSBEnabled(0)) return false;
+
+    const pio_usb_configuration_t* usbConfig = PeripheralManager::getInstance().getUSB(0)->getController();
+    uint pioIndex = pio_get_index(pio);
+    return (usbConfig->pio_tx_num == pioIndex) || (usbConfig->pio_rx_num == pioIndex);
+}
+
+bool RotaryEncoderInput::setupHardwareDecoder(uint8_t index) {
+    // the decoder samples both phases with a single IN, so the pins have to be adjacent
+    uint8_t basePin;
+    if (encoderMap[index].pinB == encoderMap[index].pinA + 1) {
+        basePin = encoderMap[index].pinA;
+        encoderState[index].direction = -1;
+    } else if (encoderMap[index].pinA == encoderMap[index].pinB + 1) {
+        basePin = encoderMap[index].pinB;
+        encoderState[index].direction = 1;
+    } else {
+        return false;
+    }
+
+    if (encoderPio == nullptr) {
+        // the program is a jump table and has to sit at offset 0
+        PIO candidates[] = { pio1, pio0 };
+        for (PIO pio : candidates) {
+            if (isUSBHostPIO(pio)) continue;
+            if (pio_can_add_program_at_offset(pio, &quadrature_encoder_program, 0)) {
+                pio_add_program_at_offset(pio, &quadrature_encoder_program, 0);
+                encoderPio = pio;
+                break;
+            }
+        }
+        if (encoderPio == nullptr) return false;
+    }
+
+    // NeoPico drives sm 0 of pio0 without claiming it
+    for (uint sm = (encoderPio == pio0) ? 1 : 0; sm < NUM_PIO_STATE_MACHINES; sm++) {
+        if (!pio_sm_is_claimed(encoderPio, sm)) {
+            pio_sm_claim(encoderPio, sm);
+            quadrature_encoder_program_init(encoderPio, sm, basePin, 0);
+            encoderState[index].sm = sm;
+            encoderState[index].count = 0;
+            return true;
+        }
+    }
+
+    return false;
+}
+
 int32_t RotaryEncoderInput::map(int32_t x, int32_t in_min, int32_t in_max, int32_t out_min, int32_t out_max) {
     return (x - in_min) * (out_max - out_min) / (in_max - in_min) + out_min;
 }
@@ -1,8 +1,10 @@
 #include "addons/snes_input.h"
 #include "drivermanager.h"
+#include "peripheralmanager.h"
 #include "storagemanager.h"
 #include "hardware/gpio.h"
 #include "helper.h"
+#include "taskmanager.h"
 
 bool SNESpadInput::available() {
     const SNESOptions& snesOptions = Storage::getInstance().getAddonOptions().snesOptions;
@@ -15,24 +17,44 @@ bool SNESpadInput::available() {
 
 void SNESpadInput::setup() {
     const SNESOptions& snesOptions = Storage::getInstance().getAddonOptions().snesOptions;
-    nextTimer = getMillis();
 
 #if SNES_PAD_DEBUG==true
     stdio_init_all();
 #endif
 
-    uIntervalMS = 0;
-
     snes = new SNESpad(
         snesOptions.clockPin,
         snesOptions.latchPin,
         snesOptions.dataPin);
+
+    // PIO USB host loads its TX and RX programs on core1 after the add-ons are set up
+    if (PeripheralManager::getInstance().isUSBEnabled(0)) {
+        const pio_usb_configuration_t* usbConfig = PeripheralManager::getInstance().getUSB(0)->getController();
+        snes->reservePIO(usbConfig->pio_tx_num);
+        snes->reservePIO(usbConfig->pio_rx_num);
+    }
     snes->begin();
     snes->start();
 
     // Run during setup to catch boot selection mode
+    poll();
+
+    TaskManager::getInstance().addPeriodicTask("snes", SNES_PAD_POLL_INTERVAL_US, [this]() { poll(); });
+}
+
+void SNESpadInput::poll() {
     snes->poll();
 
+    uint16_t joystickMid = GAMEPAD_JOYSTICK_MID;
+    if ( DriverManager::getInstance().getDriver() != nullptr ) {
+        joystickMid = DriverManager::getInstance().getDriver()->GetJoystickMidValue();
+    }
+
+    leftX = joystickMid;
+    leftY = joystickMid;
+    rightX = joystickMid;
+    rightY = joystickMid;
+
     if (snes->type == SNES_PAD_BASIC) {
         buttonA = snes->buttonA;
         buttonB = snes->buttonB;
@@ -77,73 +99,11 @@ void SNESpadInput::setup() {
 
         leftX = map(snes->mouseX,0,255,GAMEPAD_JOYSTICK_MIN,GAMEPAD_JOYSTICK_MAX);
         leftY = map(snes->mouseY,0,255,GAMEPAD_JOYSTICK_MIN,GAMEPAD_JOYSTICK_MAX);
+
     }
 }
 
 void SNESpadInput::process() {
-    if (nextTimer < getMillis()) {
-        snes->poll();
-
-        uint16_t joystickMid = GAMEPAD_JOYSTICK_MID;
-        if ( DriverManager::getInstance().getDriver() != nullptr ) {
-            joystickMid = DriverManager::getInstance().getDriver()->GetJoystickMidValue();
-        }
-
-        leftX = joystickMid;
-        leftY = joystickMid;
-        rightX = joystickMid;
-        rightY = joystickMid;
-
-        if (snes->type == SNES_PAD_BASIC) {
-            buttonA = snes->buttonA;
-            buttonB = snes->buttonB;
-            buttonX = snes->buttonX;
-            buttonY = snes->buttonY;
-            buttonL = snes->buttonL;
-            buttonR = snes->buttonR;
-            dpadUp = snes->directionUp;
-            dpadDown = snes->directionDown;
-            dpadLeft = snes->directionLeft;
-            dpadRight = snes->directionRight;
-            buttonSelect = snes->buttonSelect;
-            buttonStart = snes->buttonStart;
-
-        } else if (snes->type == SNES_PAD_NES) {
-            buttonA = snes->buttonA;
-            buttonB = snes->buttonB;
-            buttonX = false;
-            buttonY = false;
-            buttonL = false;
-            buttonR = false;
-            dpadUp = snes->directionUp;
-            dpadDown = snes->directionDown;
-            dpadLeft = snes->directionLeft;
-            dpadRight = snes->directionRight;
-            buttonSelect = snes->buttonSelect;
-            buttonStart = snes->buttonStart;
-
-        } else if (snes->type == SNES_PAD_MOUSE){
-            buttonA = snes->buttonA;
-            buttonB = snes->buttonB;
-            buttonX = false;
-            buttonY = false;
-            buttonL = false;
-            buttonR = false;
-            dpadUp = false;
-            dpadDown = false;
-            dpadLeft = false;
-            dpadRight = false;
-            buttonSelect = false;
-            buttonStart = false;
-
-            leftX = map(snes->mouseX,0,255,GAMEPAD_JOYSTICK_MIN,GAMEPAD_JOYSTICK_MAX);
-            leftY = map(snes->mouseY,0,255,GAMEPAD_JOYSTICK_MIN,GAMEPAD_JOYSTICK_MAX);
-
-        }
-
-        nextTimer = getMillis() + uIntervalMS;
-    }
-
     Gamepad * gamepad = Storage::getInstance().GetGamepad();
 
     gamepad->state.lx = leftX;
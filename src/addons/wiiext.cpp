@@ -3,8 +3,11 @@
 #include "storagemanager.h"
 #include "hardware/gpio.h"
 #include "helper.h"
+#include "taskmanager.h"
 #include "config.pb.h"
 
+#include <algorithm>
+
 bool WiiExtensionInput::available() {
     const WiiOptions& options = Storage::getInstance().getAddonOptions().wiiOptions;
     if (options.enabled) {
@@ -24,15 +27,13 @@ bool WiiExtensionInput::available() {
 
 void WiiExtensionInput::setup() {
     const WiiOptions& options = Storage::getInstance().getAddonOptions().wiiOptions;
-    nextTimer = getMillis();
 
 #if WII_EXTENSION_DEBUG==true
     stdio_init_all();
 #endif
 
-    uIntervalMS = 0;
-
-    currentConfig = NULL;
+    decoder.extensionType = WII_EXTENSION_NONE;
+    decoder.joystickMid = GAMEPAD_JOYSTICK_MID;
     
     //wii = new WiiExtensionDevice(
     //    i2c,
@@ -46,239 +47,308 @@ void WiiExtensionInput::setup() {
     wii->poll();
 
     update();
+
+    TaskManager::getInstance().addPeriodicTask("wii", WII_EXTENSION_POLL_INTERVAL_US, [this]() {
+        wii->poll();
+        update();
+    });
 }
 
 void WiiExtensionInput::process() {
-    if (nextTimer < getMillis()) {
-        wii->poll();
+    if (decoder.extensionType == WII_EXTENSION_NONE)
+        return;
 
-        update();
-              
-        nextTimer = getMillis() + uIntervalMS;
+    Gamepad * gamepad = Storage::getInstance().GetGamepad();
+    ExtensionBase * controller = wii->getController();
+
+    for (uint8_t i = 0; i < decoder.buttonCount; i++) {
+        const WiiButtonDecode& button = decoder.buttons[i];
+        if (controller->buttons[button.source]) {
+            gamepad->state.buttons |= button.buttonMask;
+            gamepad->state.dpad |= button.dpadMask;
+        }
     }
 
-    if (currentConfig != NULL) {
-        queueAnalogChange(WiiAnalogs::WII_ANALOG_LEFT_X, leftX, lastLeftX);
-        queueAnalogChange(WiiAnalogs::WII_ANALOG_LEFT_Y, leftY, lastLeftY);
-        queueAnalogChange(WiiAnalogs::WII_ANALOG_RIGHT_X, rightX, lastRightX);
-        queueAnalogChange(WiiAnalogs::WII_ANALOG_RIGHT_Y, rightY, lastRightY);
-        queueAnalogChange(WiiAnalogs::WII_ANALOG_LEFT_TRIGGER, triggerLeft, lastTriggerLeft);
-        queueAnalogChange(WiiAnalogs::WII_ANALOG_RIGHT_TRIGGER, triggerRight, lastTriggerRight);
-        updateAnalogState();
-
-        setButtonState(buttonC, WiiButtons::WII_BUTTON_C);
-        setButtonState(buttonZ, WiiButtons::WII_BUTTON_Z);
-
-        setButtonState(buttonA, WiiButtons::WII_BUTTON_A);
-        setButtonState(buttonB, WiiButtons::WII_BUTTON_B);
-        setButtonState(buttonX, WiiButtons::WII_BUTTON_X);
-        setButtonState(buttonY, WiiButtons::WII_BUTTON_Y);
-        setButtonState(buttonL, WiiButtons::WII_BUTTON_L);
-        setButtonState(buttonZL, WiiButtons::WII_BUTTON_ZL);
-        setButtonState(buttonR, WiiButtons::WII_BUTTON_R);
-        setButtonState(buttonZR, WiiButtons::WII_BUTTON_ZR);
-        setButtonState(buttonSelect, WiiButtons::WII_BUTTON_MINUS);
-        setButtonState(buttonStart, WiiButtons::WII_BUTTON_PLUS);
-        setButtonState(buttonHome, WiiButtons::WII_BUTTON_HOME);
-
-        setButtonState(dpadUp, WiiButtons::WII_BUTTON_UP);
-        setButtonState(dpadDown, WiiButtons::WII_BUTTON_DOWN);
-        setButtonState(dpadLeft, WiiButtons::WII_BUTTON_LEFT);
-        setButtonState(dpadRight, WiiButtons::WII_BUTTON_RIGHT);
-
-        updateMotionState();
-
-        if (lastLeftX != leftX) lastLeftX = leftX;
-        if (lastLeftY != leftY) lastLeftY = leftY;
-        if (lastRightX != rightX) lastRightX = rightX;
-        if (lastRightY != rightY) lastRightY = rightY;
-        if (lastTriggerLeft != triggerLeft) lastTriggerLeft = triggerLeft;
-        if (lastTriggerRight != triggerRight) lastTriggerRight = triggerRight;
+    int32_t axes[WII_ANALOG_TYPE_COUNT] = {0};
+    for (uint8_t i = 0; i < decoder.axisCount; i++) {
+        const WiiAxisDecode& axis = decoder.axes[i];
+        int32_t sum = 0;
+        for (uint8_t a = axis.first; a < (axis.first + axis.count); a++) {
+            const WiiAnalogDecode& analog = decoder.analogs[a];
+            sum += ((int32_t)controller->analogState[analog.source] * analog.multiplier + analog.offset) >> WII_ANALOG_SCALE_SHIFT;
+        }
+        int32_t average = sum / axis.count;
+
+        if (axis.target == WII_ANALOG_TYPE_DPAD_X) {
+            if (average < axis.low) gamepad->state.dpad |= GAMEPAD_MASK_LEFT;
+            if (average > axis.high) gamepad->state.dpad |= GAMEPAD_MASK_RIGHT;
+        } else if (axis.target == WII_ANALOG_TYPE_DPAD_Y) {
+            if (average < axis.low) gamepad->state.dpad |= GAMEPAD_MASK_UP;
+            if (average > axis.high) gamepad->state.dpad |= GAMEPAD_MASK_DOWN;
+        } else {
+            int32_t scaled = (uint32_t)average * axis.scale / axis.inputRange;
+            axes[axis.target] += std::clamp(axis.negative ? (axis.base - scaled) : (axis.base + scaled), axis.low, axis.high);
+        }
     }
-}
 
-uint16_t WiiExtensionInput::map(uint16_t x, uint16_t in_min, uint16_t in_max, uint16_t out_min, uint16_t out_max) {
-    return (x - in_min) * (out_max - out_min) / (in_max - in_min) + out_min;
+    // axes driven by several config types add up and stop at the ends of the axis
+    gamepad->hasAnalogTriggers = decoder.hasAnalogTriggers;
+    if (decoder.axisMask & (1 << WII_ANALOG_TYPE_LEFT_STICK_X))
+        gamepad->state.lx = std::clamp<int32_t>(decoder.joystickMid + axes[WII_ANALOG_TYPE_LEFT_STICK_X], GAMEPAD_JOYSTICK_MIN, GAMEPAD_JOYSTICK_MAX);
+    if (decoder.axisMask & (1 << WII_ANALOG_TYPE_LEFT_STICK_Y))
+        gamepad->state.ly = std::clamp<int32_t>(decoder.joystickMid + axes[WII_ANALOG_TYPE_LEFT_STICK_Y], GAMEPAD_JOYSTICK_MIN, GAMEPAD_JOYSTICK_MAX);
+    if (decoder.axisMask & (1 << WII_ANALOG_TYPE_RIGHT_STICK_X))
+        gamepad->state.rx = std::clamp<int32_t>(decoder.joystickMid + axes[WII_ANALOG_TYPE_RIGHT_STICK_X], GAMEPAD_JOYSTICK_MIN, GAMEPAD_JOYSTICK_MAX);
+    if (decoder.axisMask & (1 << WII_ANALOG_TYPE_RIGHT_STICK_Y))
+        gamepad->state.ry = std::clamp<int32_t>(decoder.joystickMid + axes[WII_ANALOG_TYPE_RIGHT_STICK_Y], GAMEPAD_JOYSTICK_MIN, GAMEPAD_JOYSTICK_MAX);
+    if (decoder.axisMask & (1 << WII_ANALOG_TYPE_LEFT_TRIGGER))
+        gamepad->state.lt = std::clamp<int32_t>(GAMEPAD_TRIGGER_MID + axes[WII_ANALOG_TYPE_LEFT_TRIGGER], GAMEPAD_TRIGGER_MIN, GAMEPAD_TRIGGER_MAX);
+    if (decoder.axisMask & (1 << WII_ANALOG_TYPE_RIGHT_TRIGGER))
+        gamepad->state.rt = std::clamp<int32_t>(GAMEPAD_TRIGGER_MID + axes[WII_ANALOG_TYPE_RIGHT_TRIGGER], GAMEPAD_TRIGGER_MIN, GAMEPAD_TRIGGER_MAX);
+
+    updateMotionState(gamepad, controller);
 }
 
-uint16_t WiiExtensionInput::bounds(uint16_t x, uint16_t out_min, uint16_t out_max) {
-    if (x > out_max) x = out_max;
-    if (x < out_min) x = out_min;
-    return x;
+void WiiExtensionInput::update() {
+    uint16_t joystickMid = GAMEPAD_JOYSTICK_MID;
+    if ( DriverManager::getInstance().getDriver() != nullptr ) {
+        joystickMid = DriverManager::getInstance().getDriver()->GetJoystickMidValue();
+    }
+
+    // the driver is set up after the add-ons, so its center can change after the first compile
+    if ((wii->extensionType != decoder.extensionType) || (joystickMid != decoder.joystickMid)) {
+        compileDecoder(wii->extensionType, joystickMid);
+    }
 }
 
-void WiiExtensionInput::update() {
-    if (wii->extensionType != WII_EXTENSION_NONE) {
-        uint16_t joystickMid = GAMEPAD_JOYSTICK_MID;
-        if ( DriverManager::getInstance().getDriver() != nullptr ) {
-            joystickMid = DriverManager::getInstance().getDriver()->GetJoystickMidValue();
+// Builds the button and analog tables of one extension type, so process() only has
+// to test, shift and add per poll. Extension analogs are read straight from the
+// library's analogState[]; which one feeds each config slot depends on the type.
+void WiiExtensionInput::compileDecoder(int8_t extensionType, uint16_t joystickMid) {
+    decoder.extensionType = extensionType;
+    decoder.joystickMid = joystickMid;
+    decoder.buttonCount = 0;
+    decoder.analogCount = 0;
+    decoder.axisCount = 0;
+    decoder.axisMask = 0;
+    decoder.hasAnalogTriggers = false;
+    decoder.hasAccelerometer = false;
+    decoder.hasGyroscope = false;
+    decoder.hasTouch = false;
+
+    if (extensionType == WII_EXTENSION_NONE)
+        return;
+
+    // Classic Pro and Motion Plus report like the controller they extend
+    uint16_t configType = extensionType;
+    if (extensionType == WII_EXTENSION_CLASSIC_PRO) {
+        configType = WII_EXTENSION_CLASSIC;
+    } else if (extensionType == WII_EXTENSION_MOTION_PLUS) {
+        configType = WII_EXTENSION_NUNCHUCK;
+    }
+    static const WiiExtensionConfig noConfig;
+    auto configEntry = extensionConfigs.find(configType);
+    const WiiExtensionConfig& config = (configEntry != extensionConfigs.end()) ? configEntry->second : noConfig;
+
+    // each extension button sets what its own config entry maps it to
+    for (const auto& [extensionButton, value] : config.buttonMap) {
+        if ((extensionButton >= WiiButtons::WII_MAX_BUTTONS) || (value == 0))
+            continue;
+
+        WiiButtonDecode& button = decoder.buttons[decoder.buttonCount++];
+        button.source = extensionButton;
+        if (value > GAMEPAD_MASK_A2) {
+            button.buttonMask = 0;
+            button.dpadMask = (value >> 16) & GAMEPAD_MASK_DPAD;
+        } else {
+            button.buttonMask = value;
+            button.dpadMask = 0;
         }
-        currentConfig = &extensionConfigs[wii->extensionType];
-
-        //for (const auto& [extensionButton, value] : currentConfig->buttonMap) {
-        //    WII_SET_MASK(buttonState, wii->getController()->buttons[extensionButton], value);
-        //}
-
-        isAnalogTriggers = false;
-        isAccelerometer = false;
-        isGyroscope = false;
-
-        if (wii->extensionType == WII_EXTENSION_NUNCHUCK) {
-            buttonZ = wii->getController()->buttons[WiiButtons::WII_BUTTON_Z];
-            buttonC = wii->getController()->buttons[WiiButtons::WII_BUTTON_C];
-
-            leftX = map(wii->getController()->analogState[WiiAnalogs::WII_ANALOG_LEFT_X],0,WII_ANALOG_PRECISION_3,GAMEPAD_JOYSTICK_MIN,GAMEPAD_JOYSTICK_MAX);
-            leftY = map(wii->getController()->analogState[WiiAnalogs::WII_ANALOG_LEFT_Y],WII_ANALOG_PRECISION_3,0,GAMEPAD_JOYSTICK_MIN,GAMEPAD_JOYSTICK_MAX);
-            rightX = joystickMid;
-            rightY = joystickMid;
-
-            accelerometerX = wii->getController()->motionState[WiiMotions::WII_ACCELEROMETER_X];
-            accelerometerY = wii->getController()->motionState[WiiMotions::WII_ACCELEROMETER_Y];
-            accelerometerZ = wii->getController()->motionState[WiiMotions::WII_ACCELEROMETER_Z];
-            isAccelerometer = true;
-
-            triggerLeft = 0;
-            triggerRight = 0;
-        } else if ((wii->extensionType == WII_EXTENSION_CLASSIC) || (wii->extensionType == WII_EXTENSION_CLASSIC_PRO)) {
-            buttonA = wii->getController()->buttons[WiiButtons::WII_BUTTON_A];
-            buttonB = wii->getController()->buttons[WiiButtons::WII_BUTTON_B];
-            buttonX = wii->getController()->buttons[WiiButtons::WII_BUTTON_X];
-            buttonY = wii->getController()->buttons[WiiButtons::WII_BUTTON_Y];
-            buttonL = wii->getController()->buttons[WiiButtons::WII_BUTTON_L];
-            buttonZL = wii->getController()->buttons[WiiButtons::WII_BUTTON_ZL];
-            buttonR = wii->getController()->buttons[WiiButtons::WII_BUTTON_R];
-            buttonZR = wii->getController()->buttons[WiiButtons::WII_BUTTON_ZR];
-            buttonSelect = wii->getController()->buttons[WiiButtons::WII_BUTTON_MINUS];
-            buttonStart = wii->getController()->buttons[WiiButtons::WII_BUTTON_PLUS];
-            buttonHome = wii->getController()->buttons[WiiButtons::WII_BUTTON_HOME];
-            dpadUp = wii->getController()->buttons[WiiButtons::WII_BUTTON_UP];
-            dpadDown = wii->getController()->buttons[WiiButtons::WII_BUTTON_DOWN];
-            dpadLeft = wii->getController()->buttons[WiiButtons::WII_BUTTON_LEFT];
-            dpadRight = wii->getController()->buttons[WiiButtons::WII_BUTTON_RIGHT];
-
-            if (wii->extensionType == WII_EXTENSION_CLASSIC) {
-                triggerLeft  = wii->getController()->analogState[WiiAnalogs::WII_ANALOG_LEFT_TRIGGER];
-                triggerRight = wii->getController()->analogState[WiiAnalogs::WII_ANALOG_RIGHT_TRIGGER];
-                isAnalogTriggers = true;
+    }
+
+    // extension analog behind each config slot, -1 when this type has none
+    int8_t sources[WiiAnalogs::WII_ANALOG_CALIBRATION_PRECISION] = {-1, -1, -1, -1, -1, -1};
+    switch (extensionType) {
+        case WII_EXTENSION_NUNCHUCK:
+        case WII_EXTENSION_MOTION_PLUS:
+            sources[WiiAnalogs::WII_ANALOG_LEFT_X] = WiiAnalogs::WII_ANALOG_LEFT_X;
+            sources[WiiAnalogs::WII_ANALOG_LEFT_Y] = WiiAnalogs::WII_ANALOG_LEFT_Y;
+            decoder.hasAccelerometer = true;
+            decoder.hasGyroscope = (extensionType == WII_EXTENSION_MOTION_PLUS);
+            break;
+        case WII_EXTENSION_CLASSIC:
+        case WII_EXTENSION_CLASSIC_PRO:
+            sources[WiiAnalogs::WII_ANALOG_LEFT_X] = WiiAnalogs::WII_ANALOG_LEFT_X;
+            sources[WiiAnalogs::WII_ANALOG_LEFT_Y] = WiiAnalogs::WII_ANALOG_LEFT_Y;
+            sources[WiiAnalogs::WII_ANALOG_RIGHT_X] = WiiAnalogs::WII_ANALOG_RIGHT_X;
+            sources[WiiAnalogs::WII_ANALOG_RIGHT_Y] = WiiAnalogs::WII_ANALOG_RIGHT_Y;
+            if (extensionType == WII_EXTENSION_CLASSIC) {
+                sources[WiiAnalogs::WII_ANALOG_LEFT_TRIGGER] = WiiAnalogs::WII_ANALOG_LEFT_TRIGGER;
+                sources[WiiAnalogs::WII_ANALOG_RIGHT_TRIGGER] = WiiAnalogs::WII_ANALOG_RIGHT_TRIGGER;
+                decoder.hasAnalogTriggers = true;
             }
+            break;
+        case WII_EXTENSION_GUITAR:
+            sources[WiiAnalogs::WII_ANALOG_LEFT_X] = WiiAnalogs::WII_ANALOG_LEFT_X;
+            sources[WiiAnalogs::WII_ANALOG_LEFT_Y] = WiiAnalogs::WII_ANALOG_LEFT_Y;
+            // whammy bar
+            sources[WiiAnalogs::WII_ANALOG_RIGHT_X] = WiiAnalogs::WII_ANALOG_RIGHT_X;
+            decoder.hasAnalogTriggers = true;
+            break;
+        case WII_EXTENSION_DRUMS:
+            sources[WiiAnalogs::WII_ANALOG_LEFT_X] = WiiAnalogs::WII_ANALOG_LEFT_X;
+            sources[WiiAnalogs::WII_ANALOG_LEFT_Y] = WiiAnalogs::WII_ANALOG_LEFT_Y;
+            decoder.hasAnalogTriggers = true;
+            break;
+        case WII_EXTENSION_TURNTABLE:
+            sources[WiiAnalogs::WII_ANALOG_LEFT_X] = WiiAnalogs::WII_ANALOG_LEFT_X;
+            sources[WiiAnalogs::WII_ANALOG_LEFT_Y] = WiiAnalogs::WII_ANALOG_LEFT_Y;
+            sources[WiiAnalogs::WII_ANALOG_RIGHT_X] = TurntableAnalogs::TURNTABLE_RIGHT;
+            sources[WiiAnalogs::WII_ANALOG_RIGHT_Y] = TurntableAnalogs::TURNTABLE_LEFT;
+            sources[WiiAnalogs::WII_ANALOG_LEFT_TRIGGER] = TurntableAnalogs::TURNTABLE_EFFECTS;
+            sources[WiiAnalogs::WII_ANALOG_RIGHT_TRIGGER] = TurntableAnalogs::TURNTABLE_CROSSFADE;
+            decoder.hasAnalogTriggers = true;
+            break;
+        case WII_EXTENSION_DRAWSOME:
+        case WII_EXTENSION_UDRAW:
+            decoder.hasTouch = true;
+            break;
+        default:
+            break;
+    }
+
+    uint16_t axisTypes[WiiAnalogs::WII_ANALOG_CALIBRATION_PRECISION];
+    for (uint8_t slot = 0; slot < WiiAnalogs::WII_ANALOG_CALIBRATION_PRECISION; slot++) {
+        axisTypes[slot] = WII_ANALOG_TYPE_NONE;
+        if (sources[slot] < 0)
+            continue;
 
-            leftX = map(wii->getController()->analogState[WiiAnalogs::WII_ANALOG_LEFT_X],0,WII_ANALOG_PRECISION_3,GAMEPAD_JOYSTICK_MIN,GAMEPAD_JOYSTICK_MAX);
-            leftY = map(wii->getController()->analogState[WiiAnalogs::WII_ANALOG_LEFT_Y],WII_ANALOG_PRECISION_3,0,GAMEPAD_JOYSTICK_MIN,GAMEPAD_JOYSTICK_MAX);
-            rightX = map(wii->getController()->analogState[WiiAnalogs::WII_ANALOG_RIGHT_X],0,WII_ANALOG_PRECISION_3,GAMEPAD_JOYSTICK_MIN,GAMEPAD_JOYSTICK_MAX);
-            rightY = map(wii->getController()->analogState[WiiAnalogs::WII_ANALOG_RIGHT_Y],WII_ANALOG_PRECISION_3,0,GAMEPAD_JOYSTICK_MIN,GAMEPAD_JOYSTICK_MAX);
-        } else if (wii->extensionType == WII_EXTENSION_GUITAR) {
-            buttonSelect = wii->getController()->buttons[WiiButtons::WII_BUTTON_MINUS];
-            buttonStart = wii->getController()->buttons[WiiButtons::WII_BUTTON_PLUS];
-
-            dpadUp = wii->getController()->buttons[WiiButtons::WII_BUTTON_UP];
-            dpadDown = wii->getController()->buttons[WiiButtons::WII_BUTTON_DOWN];
-
-            buttonB = wii->getController()->buttons[GuitarButtons::GUITAR_GREEN];
-            buttonA = wii->getController()->buttons[GuitarButtons::GUITAR_RED];
-            buttonX = wii->getController()->buttons[GuitarButtons::GUITAR_YELLOW];
-            buttonY = wii->getController()->buttons[GuitarButtons::GUITAR_BLUE];
-            buttonZL = wii->getController()->buttons[GuitarButtons::GUITAR_ORANGE];
-
-            // whammy currently maps to Joy2X in addition to the raw whammy value
-            whammyBar = wii->getController()->analogState[WiiAnalogs::WII_ANALOG_RIGHT_X];
-            buttonR = wii->getController()->buttons[GuitarButtons::GUITAR_PEDAL];
-
-            leftX = map(wii->getController()->analogState[WiiAnalogs::WII_ANALOG_LEFT_X],0,WII_ANALOG_PRECISION_3,GAMEPAD_JOYSTICK_MIN,GAMEPAD_JOYSTICK_MAX);
-            leftY = map(wii->getController()->analogState[WiiAnalogs::WII_ANALOG_LEFT_Y],WII_ANALOG_PRECISION_3,0,GAMEPAD_JOYSTICK_MIN,GAMEPAD_JOYSTICK_MAX);
-            rightX = map(wii->getController()->analogState[WiiAnalogs::WII_ANALOG_RIGHT_X],0,WII_ANALOG_PRECISION_3,GAMEPAD_JOYSTICK_MIN,GAMEPAD_JOYSTICK_MAX);
-            rightY = joystickMid;
-
-            triggerLeft = 0;
-            triggerRight = 0;
-
-            isAnalogTriggers = true;
-        } else if (wii->extensionType == WII_EXTENSION_TAIKO) {
-            buttonL = wii->getController()->buttons[TaikoButtons::TATA_KAT_LEFT];
-            buttonR = wii->getController()->buttons[TaikoButtons::TATA_KAT_RIGHT];
-
-            dpadLeft = wii->getController()->buttons[TaikoButtons::TATA_DON_LEFT];
-            buttonA = wii->getController()->buttons[TaikoButtons::TATA_DON_RIGHT];
-        } else if (wii->extensionType == WII_EXTENSION_DRUMS) {
-            buttonSelect = wii->getController()->buttons[WiiButtons::WII_BUTTON_MINUS];
-            buttonStart = wii->getController()->buttons[WiiButtons::WII_BUTTON_PLUS];
-
-            buttonB = wii->getController()->buttons[DrumButtons::DRUM_RED];
-            buttonA = wii->getController()->buttons[DrumButtons::DRUM_GREEN];
-            buttonX = wii->getController()->buttons[DrumButtons::DRUM_YELLOW];
-            buttonY = wii->getController()->buttons[DrumButtons::DRUM_BLUE];
-            buttonL = wii->getController()->buttons[DrumButtons::DRUM_ORANGE];
-            buttonZR = wii->getController()->buttons[DrumButtons::DRUM_PEDAL];
-
-            leftX = map(wii->getController()->analogState[WiiAnalogs::WII_ANALOG_LEFT_X],0,WII_ANALOG_PRECISION_3,GAMEPAD_JOYSTICK_MIN,GAMEPAD_JOYSTICK_MAX);
-            leftY = map(wii->getController()->analogState[WiiAnalogs::WII_ANALOG_LEFT_Y],WII_ANALOG_PRECISION_3,0,GAMEPAD_JOYSTICK_MIN,GAMEPAD_JOYSTICK_MAX);
-            rightX = joystickMid;
-            rightY = joystickMid;
-
-            triggerLeft = 0;
-            triggerRight = 0;
-
-            isAnalogTriggers = true;
-        } else if (wii->extensionType == WII_EXTENSION_TURNTABLE) {
-            buttonSelect = wii->getController()->buttons[WiiButtons::WII_BUTTON_MINUS];
-            buttonStart = wii->getController()->buttons[WiiButtons::WII_BUTTON_PLUS];
-
-            dpadLeft = wii->getController()->buttons[TurntableButtons::TURNTABLE_LEFT_GREEN];
-            dpadUp = wii->getController()->buttons[TurntableButtons::TURNTABLE_LEFT_RED];
-            dpadRight = wii->getController()->buttons[TurntableButtons::TURNTABLE_LEFT_BLUE];
-
-            buttonY = wii->getController()->buttons[TurntableButtons::TURNTABLE_RIGHT_GREEN];
-            buttonX = wii->getController()->buttons[TurntableButtons::TURNTABLE_RIGHT_RED];
-            buttonA = wii->getController()->buttons[TurntableButtons::TURNTABLE_RIGHT_BLUE];
-
-            buttonZR = wii->getController()->buttons[TurntableButtons::TURNTABLE_EUPHORIA];
-
-            leftX = map(wii->getController()->analogState[WiiAnalogs::WII_ANALOG_LEFT_X],0,WII_ANALOG_PRECISION_3,GAMEPAD_JOYSTICK_MIN,GAMEPAD_JOYSTICK_MAX);
-            leftY = map(wii->getController()->analogState[WiiAnalogs::WII_ANALOG_LEFT_Y],WII_ANALOG_PRECISION_3,0,GAMEPAD_JOYSTICK_MIN,GAMEPAD_JOYSTICK_MAX);
-            rightX = map(wii->getController()->analogState[TurntableAnalogs::TURNTABLE_RIGHT],0,WII_ANALOG_PRECISION_3,GAMEPAD_JOYSTICK_MIN,GAMEPAD_JOYSTICK_MAX);
-            rightY = map(wii->getController()->analogState[TurntableAnalogs::TURNTABLE_LEFT],WII_ANALOG_PRECISION_3,0,GAMEPAD_JOYSTICK_MIN,GAMEPAD_JOYSTICK_MAX);
-
-            triggerLeft  = wii->getController()->analogState[TurntableAnalogs::TURNTABLE_EFFECTS];
-            triggerRight = wii->getController()->analogState[TurntableAnalogs::TURNTABLE_CROSSFADE];
-
-            isAnalogTriggers = true;
-        } else if ((wii->extensionType == WII_EXTENSION_DRAWSOME) || (wii->extensionType == WII_EXTENSION_UDRAW)) {
-            buttonA = wii->getController()->buttons[WiiButtons::WII_BUTTON_A];
-            buttonL = wii->getController()->buttons[WiiButtons::WII_BUTTON_L];
-            buttonR = wii->getController()->buttons[WiiButtons::WII_BUTTON_R];
-
-            touchX = wii->getController()->motionState[WiiMotions::WII_TOUCH_X];
-            touchY = wii->getController()->motionState[WiiMotions::WII_TOUCH_Y];
-            touchZ = wii->getController()->motionState[WiiMotions::WII_TOUCH_Z];
-            touchPressed = wii->getController()->motionState[WiiMotions::WII_TOUCH_PRESSED];
-
-            isTouch = true;
-        } else if (wii->extensionType == WII_EXTENSION_MOTION_PLUS) {
-            currentConfig = &extensionConfigs[WII_EXTENSION_NUNCHUCK];
-            
-            gyroscopeX = wii->getController()->motionState[WiiMotions::WII_GYROSCOPE_YAW];
-            gyroscopeY = wii->getController()->motionState[WiiMotions::WII_GYROSCOPE_ROLL];
-            gyroscopeZ = wii->getController()->motionState[WiiMotions::WII_GYROSCOPE_PITCH];
-            isGyroscope = true;
-
-            // add logic to know if an attachment is detected. for now, just stream it.
-            buttonZ = wii->getController()->buttons[WiiButtons::WII_BUTTON_Z];
-            buttonC = wii->getController()->buttons[WiiButtons::WII_BUTTON_C];
-
-            leftX = map(wii->getController()->analogState[WiiAnalogs::WII_ANALOG_LEFT_X],0,WII_ANALOG_PRECISION_3,GAMEPAD_JOYSTICK_MIN,GAMEPAD_JOYSTICK_MAX);
-            leftY = map(wii->getController()->analogState[WiiAnalogs::WII_ANALOG_LEFT_Y],WII_ANALOG_PRECISION_3,0,GAMEPAD_JOYSTICK_MIN,GAMEPAD_JOYSTICK_MAX);
-            rightX = joystickMid;
-            rightY = joystickMid;
-
-            accelerometerX = wii->getController()->motionState[WiiMotions::WII_ACCELEROMETER_X];
-            accelerometerY = wii->getController()->motionState[WiiMotions::WII_ACCELEROMETER_Y];
-            accelerometerZ = wii->getController()->motionState[WiiMotions::WII_ACCELEROMETER_Z];
-            isAccelerometer = true;
+        auto analog = config.analogMap.find(slot);
+        if ((analog != config.analogMap.end()) && (analog->second.axisType < WII_ANALOG_TYPE_COUNT))
+            axisTypes[slot] = analog->second.axisType;
+    }
+
+    // slots that share an axis type are averaged, their analogs are kept together in analogs[]
+    for (uint16_t axisType = WII_ANALOG_TYPE_NONE + 1; axisType < WII_ANALOG_TYPE_COUNT; axisType++) {
+        WiiAxisDecode& axis = decoder.axes[decoder.axisCount];
+        axis.first = decoder.analogCount;
+        axis.count = 0;
+        bool isTriggerInput = false;
+
+        for (uint8_t slot = 0; slot < WiiAnalogs::WII_ANALOG_CALIBRATION_PRECISION; slot++) {
+            if (axisTypes[slot] != axisType)
+                continue;
+
+            bool isTrigger = (slot == WiiAnalogs::WII_ANALOG_LEFT_TRIGGER) || (slot == WiiAnalogs::WII_ANALOG_RIGHT_TRIGGER);
+            bool isInverted = (slot == WiiAnalogs::WII_ANALOG_LEFT_Y) || (slot == WiiAnalogs::WII_ANALOG_RIGHT_Y);
+            if (axis.count == 0)
+                isTriggerInput = isTrigger;
+
+            // sticks span WII_ANALOG_PRECISION_3 steps, which the shift divides out
+            WiiAnalogDecode& analog = decoder.analogs[decoder.analogCount++];
+            analog.source = sources[slot];
+            if (isTrigger) {
+                analog.multiplier = 1 << WII_ANALOG_SCALE_SHIFT;
+                analog.offset = 0;
+            } else if (isInverted) {
+                analog.multiplier = -GAMEPAD_JOYSTICK_MAX;
+                analog.offset = WII_ANALOG_PRECISION_3 * GAMEPAD_JOYSTICK_MAX;
+            } else {
+                analog.multiplier = GAMEPAD_JOYSTICK_MAX;
+                analog.offset = 0;
+            }
+            axis.count++;
         }
-    } else {
-        currentConfig = NULL;
+
+        if (axis.count == 0)
+            continue;
+
+        setAxisDecode(axis, axisType, isTriggerInput);
+        decoder.axisCount++;
     }
 }
 
+// Maps the average of an axis type's analogs, in the range of its first analog, to the
+// target axis. Half axes spread the whole input over one side of the stick.
+void WiiExtensionInput::setAxisDecode(WiiAxisDecode& axis, uint16_t axisType, bool isTriggerInput) {
+    uint16_t joystickMid = decoder.joystickMid;
+    int32_t inputMid = isTriggerInput ? GAMEPAD_TRIGGER_MID : joystickMid;
+    uint32_t inputMax = isTriggerInput ? GAMEPAD_TRIGGER_MAX : GAMEPAD_JOYSTICK_MAX;
+
+    axis.target = axisType;
+    axis.negative = false;
+    axis.scale = 1;
+    axis.inputRange = 1;
+    axis.base = 0;
+    axis.low = 0;
+    axis.high = inputMax;
+
+    switch (axisType) {
+        case WII_ANALOG_TYPE_DPAD_X:
+        case WII_ANALOG_TYPE_DPAD_Y:
+            // thresholds in the input's own range, not relative to any axis
+            axis.low = inputMid / 2;
+            axis.high = inputMid + (inputMid / 2);
+            return;
+        case WII_ANALOG_TYPE_LEFT_TRIGGER:
+        case WII_ANALOG_TYPE_RIGHT_TRIGGER:
+            axis.scale = GAMEPAD_TRIGGER_MAX;
+            axis.inputRange = inputMax;
+            break;
+        case WII_ANALOG_TYPE_LEFT_STICK_X_PLUS:
+        case WII_ANALOG_TYPE_LEFT_STICK_Y_PLUS:
+        case WII_ANALOG_TYPE_RIGHT_STICK_X_PLUS:
+        case WII_ANALOG_TYPE_RIGHT_STICK_Y_PLUS:
+            axis.scale = GAMEPAD_JOYSTICK_MAX - joystickMid;
+            axis.inputRange = inputMax;
+            axis.base = joystickMid;
+            axis.low = joystickMid;
+            axis.high = GAMEPAD_JOYSTICK_MAX;
+            break;
+        case WII_ANALOG_TYPE_LEFT_STICK_X_MINUS:
+        case WII_ANALOG_TYPE_LEFT_STICK_Y_MINUS:
+        case WII_ANALOG_TYPE_RIGHT_STICK_X_MINUS:
+        case WII_ANALOG_TYPE_RIGHT_STICK_Y_MINUS:
+            axis.negative = true;
+            axis.scale = joystickMid;
+            axis.inputRange = inputMax;
+            axis.base = joystickMid;
+            axis.low = GAMEPAD_JOYSTICK_MIN;
+            axis.high = joystickMid;
+            break;
+        default:
+            break;
+    }
+
+    switch (axisType) {
+        case WII_ANALOG_TYPE_LEFT_STICK_X_PLUS:
+        case WII_ANALOG_TYPE_LEFT_STICK_X_MINUS:
+            axis.target = WII_ANALOG_TYPE_LEFT_STICK_X;
+            break;
+        case WII_ANALOG_TYPE_LEFT_STICK_Y_PLUS:
+        case WII_ANALOG_TYPE_LEFT_STICK_Y_MINUS:
+            axis.target = WII_ANALOG_TYPE_LEFT_STICK_Y;
+            break;
+        case WII_ANALOG_TYPE_RIGHT_STICK_X_PLUS:
+        case WII_ANALOG_TYPE_RIGHT_STICK_X_MINUS:
+            axis.target = WII_ANALOG_TYPE_RIGHT_STICK_X;
+            break;
+        case WII_ANALOG_TYPE_RIGHT_STICK_Y_PLUS:
+        case WII_ANALOG_TYPE_RIGHT_STICK_Y_MINUS:
+            axis.target = WII_ANALOG_TYPE_RIGHT_STICK_Y;
+            break;
+        default:
+            break;
+    }
+
+    // axes driven by several types add up their offsets from the center
+    int32_t center = ((axis.target == WII_ANALOG_TYPE_LEFT_TRIGGER) || (axis.target == WII_ANALOG_TYPE_RIGHT_TRIGGER)) ? GAMEPAD_TRIGGER_MID : joystickMid;
+    axis.base -= center;
+    axis.low -= center;
+    axis.high -= center;
+    decoder.axisMask |= (1 << axis.target);
+}
+
 void WiiExtensionInput::setControllerButton(uint16_t controllerID, uint16_t buttonID, uint32_t buttonMask) {
     extensionConfigs[controllerID].buttonMap[buttonID] = buttonMask;
 }
@@ -371,259 +441,28 @@ void WiiExtensionInput::reloadConfig() {
     setControllerAnalog(WII_EXTENSION_TURNTABLE, WiiAnalogs::WII_ANALOG_RIGHT_TRIGGER, wiiOptions.controllers.turntable.fader.axisType);
 }
 
-void WiiExtensionInput::setButtonState(bool buttonState, uint16_t buttonMask) {
-    Gamepad * gamepad = Storage::getInstance().GetGamepad();
-
-    if (buttonState) {
-        if (currentConfig->buttonMap[buttonMask] > GAMEPAD_MASK_A2) {
-            if (((currentConfig->buttonMap[buttonMask] >> 16) & GAMEPAD_MASK_UP) == GAMEPAD_MASK_UP) gamepad->state.dpad    |= ((currentConfig->buttonMap[buttonMask] >> 16) & GAMEPAD_MASK_UP);
-            if (((currentConfig->buttonMap[buttonMask] >> 16) & GAMEPAD_MASK_DOWN) == GAMEPAD_MASK_DOWN) gamepad->state.dpad    |= ((currentConfig->buttonMap[buttonMask] >> 16) & GAMEPAD_MASK_DOWN);
-            if (((currentConfig->buttonMap[buttonMask] >> 16) & GAMEPAD_MASK_LEFT) == GAMEPAD_MASK_LEFT) gamepad->state.dpad    |= ((currentConfig->buttonMap[buttonMask] >> 16) & GAMEPAD_MASK_LEFT);
-            if (((currentConfig->buttonMap[buttonMask] >> 16) & GAMEPAD_MASK_RIGHT) == GAMEPAD_MASK_RIGHT) gamepad->state.dpad    |= ((currentConfig->buttonMap[buttonMask] >> 16) & GAMEPAD_MASK_RIGHT);
-        } else {
-            gamepad->state.buttons |= currentConfig->buttonMap[buttonMask];
-        }
-    }
-}
-
-void WiiExtensionInput::queueAnalogChange(uint16_t analogInput, uint16_t analogValue, uint16_t lastAnalogValue) {
-    if (analogInput != lastAnalogValue) analogChanges[currentConfig->analogMap[analogInput].axisType].push_back({analogInput, analogValue});
-}
-
-void WiiExtensionInput::updateAnalogState() {
-    Gamepad * gamepad = Storage::getInstance().GetGamepad();
-    gamepad->hasAnalogTriggers = isAnalogTriggers;
-
-    uint16_t joystickMid = GAMEPAD_JOYSTICK_MID;
-    if ( DriverManager::getInstance().getDriver() != nullptr ) {
-        joystickMid = DriverManager::getInstance().getDriver()->GetJoystickMidValue();
-    }
-
-    uint16_t axisType;
-    uint16_t analogInput;
-    uint16_t analogValue;
-
-    uint16_t axisToChange;
-    uint16_t adjustedValue;
-
-    uint16_t minValue = GAMEPAD_JOYSTICK_MIN;
-    uint16_t midValue = joystickMid;
-    uint16_t maxValue = GAMEPAD_JOYSTICK_MAX;
-
-    std::map<uint16_t, std::vector<uint16_t>> axesOfChange = {
-        {WII_ANALOG_TYPE_LEFT_STICK_X,{}},
-        {WII_ANALOG_TYPE_LEFT_STICK_Y,{}},
-        {WII_ANALOG_TYPE_RIGHT_STICK_X,{}},
-        {WII_ANALOG_TYPE_RIGHT_STICK_Y,{}},
-        {WII_ANALOG_TYPE_LEFT_TRIGGER,{}},
-        {WII_ANALOG_TYPE_RIGHT_TRIGGER,{}}
-    };
-
-    for (auto currChange = analogChanges.begin(); currChange != analogChanges.end(); ++currChange) {
-        if (!currChange->second.empty()) {
-            // this analog type has changes. get the last one, use it, and clear the list.            
-            axisType = currChange->first;
-            analogInput = currChange->second.front().analogInput;
-            analogValue = getAverage(currChange->second);
-            currChange->second.clear();
-
-            axisToChange = WII_ANALOG_TYPE_NONE;
-            adjustedValue = 0;
-
-            if (!isAnalogTriggers && ((analogInput == WiiAnalogs::WII_ANALOG_LEFT_TRIGGER) || (analogInput == WiiAnalogs::WII_ANALOG_RIGHT_TRIGGER))) continue;
-
-            // define ranges
-            switch (analogInput) {
-                case WiiAnalogs::WII_ANALOG_LEFT_X:
-                case WiiAnalogs::WII_ANALOG_LEFT_Y:
-                case WiiAnalogs::WII_ANALOG_RIGHT_X:
-                case WiiAnalogs::WII_ANALOG_RIGHT_Y:
-                    minValue = GAMEPAD_JOYSTICK_MIN;
-                    midValue = joystickMid;
-                    maxValue = GAMEPAD_JOYSTICK_MAX;
-                    break;
-                case WiiAnalogs::WII_ANALOG_LEFT_TRIGGER:
-                case WiiAnalogs::WII_ANALOG_RIGHT_TRIGGER:
-                    minValue = GAMEPAD_TRIGGER_MIN;
-                    midValue = GAMEPAD_TRIGGER_MID;
-                    maxValue = GAMEPAD_TRIGGER_MAX;
-                    break;
-            }
-
-            switch (axisType) {
-                case WII_ANALOG_TYPE_LEFT_STICK_X:
-                    axisToChange = WII_ANALOG_TYPE_LEFT_STICK_X;
-                    adjustedValue = bounds(analogValue,minValue,maxValue);
-                    break;
-                case WII_ANALOG_TYPE_LEFT_STICK_Y:
-                    axisToChange = WII_ANALOG_TYPE_LEFT_STICK_Y;
-                    adjustedValue = bounds(analogValue,minValue,maxValue);
-                    break;
-                case WII_ANALOG_TYPE_RIGHT_STICK_X:
-                    axisToChange = WII_ANALOG_TYPE_RIGHT_STICK_X;
-                    adjustedValue = bounds(analogValue,minValue,maxValue);
-                    break;
-                case WII_ANALOG_TYPE_RIGHT_STICK_Y:
-                    axisToChange = WII_ANALOG_TYPE_RIGHT_STICK_Y;
-                    adjustedValue = bounds(analogValue,minValue,maxValue);
-                    break;
-                case WII_ANALOG_TYPE_DPAD_X:
-                    if (analogValue < midValue/2) gamepad->state.dpad |= GAMEPAD_MASK_LEFT;
-                    if (analogValue > midValue+(midValue/2)) gamepad->state.dpad |= GAMEPAD_MASK_RIGHT;
-                    break;
-                case WII_ANALOG_TYPE_DPAD_Y:
-                    if (analogValue < midValue/2) gamepad->state.dpad |= GAMEPAD_MASK_UP;
-                    if (analogValue > midValue+(midValue/2)) gamepad->state.dpad |= GAMEPAD_MASK_DOWN;
-                    break;
-                case WII_ANALOG_TYPE_LEFT_TRIGGER:
-                    axisToChange = WII_ANALOG_TYPE_LEFT_TRIGGER;
-                    adjustedValue = map(analogValue,minValue,maxValue,GAMEPAD_TRIGGER_MIN,GAMEPAD_TRIGGER_MAX);
-                    break;
-                case WII_ANALOG_TYPE_RIGHT_TRIGGER:
-                    axisToChange = WII_ANALOG_TYPE_RIGHT_TRIGGER;
-                    adjustedValue = map(analogValue,minValue,maxValue,GAMEPAD_TRIGGER_MIN,GAMEPAD_TRIGGER_MAX);
-                    break;
-                // advanced types
-                case WII_ANALOG_TYPE_LEFT_STICK_X_PLUS:
-                    axisToChange = WII_ANALOG_TYPE_LEFT_STICK_X;
-                    adjustedValue = map(analogValue,minValue,maxValue,joystickMid,GAMEPAD_JOYSTICK_MAX);
-                    minValue = joystickMid;
-                    maxValue = GAMEPAD_JOYSTICK_MAX;
-                    break;
-                case WII_ANALOG_TYPE_LEFT_STICK_X_MINUS:
-                    axisToChange = WII_ANALOG_TYPE_LEFT_STICK_X;
-                    adjustedValue = map(analogValue,minValue,maxValue,joystickMid,GAMEPAD_JOYSTICK_MIN);
-                    minValue = GAMEPAD_JOYSTICK_MIN;
-                    maxValue = joystickMid;
-                    break;
-                case WII_ANALOG_TYPE_LEFT_STICK_Y_PLUS:
-                    axisToChange = WII_ANALOG_TYPE_LEFT_STICK_Y;
-                    adjustedValue = map(analogValue,minValue,maxValue,joystickMid,GAMEPAD_JOYSTICK_MAX);
-                    minValue = joystickMid;
-                    maxValue = GAMEPAD_JOYSTICK_MAX;
-                    break;
-                case WII_ANALOG_TYPE_LEFT_STICK_Y_MINUS:
-                    axisToChange = WII_ANALOG_TYPE_LEFT_STICK_Y;
-                    adjustedValue = map(analogValue,minValue,maxValue,joystickMid,GAMEPAD_JOYSTICK_MIN);
-                    minValue = GAMEPAD_JOYSTICK_MIN;
-                    maxValue = joystickMid;
-                    break;
-                case WII_ANALOG_TYPE_RIGHT_STICK_X_PLUS:
-                    axisToChange = WII_ANALOG_TYPE_RIGHT_STICK_X;
-                    adjustedValue = map(analogValue,minValue,maxValue,joystickMid,GAMEPAD_JOYSTICK_MAX);
-                    minValue = joystickMid;
-                    maxValue = GAMEPAD_JOYSTICK_MAX;
-                    break;
-                case WII_ANALOG_TYPE_RIGHT_STICK_X_MINUS:
-                    axisToChange = WII_ANALOG_TYPE_RIGHT_STICK_X;
-                    adjustedValue = map(analogValue,minValue,maxValue,joystickMid,GAMEPAD_JOYSTICK_MIN);
-                    minValue = GAMEPAD_JOYSTICK_MIN;
-                    maxValue = joystickMid;
-                    break;
-                case WII_ANALOG_TYPE_RIGHT_STICK_Y_PLUS:
-                    axisToChange = WII_ANALOG_TYPE_RIGHT_STICK_Y;
-                    adjustedValue = map(analogValue,minValue,maxValue,joystickMid,GAMEPAD_JOYSTICK_MAX);
-                    minValue = joystickMid;
-                    maxValue = GAMEPAD_JOYSTICK_MAX;
-                    break;
-                case WII_ANALOG_TYPE_RIGHT_STICK_Y_MINUS:
-                    axisToChange = WII_ANALOG_TYPE_RIGHT_STICK_Y;
-                    adjustedValue = map(analogValue,minValue,maxValue,joystickMid,GAMEPAD_JOYSTICK_MIN);
-                    minValue = GAMEPAD_JOYSTICK_MIN;
-                    maxValue = joystickMid;
-                    break;
-            }
-
-            if (axisToChange != WII_ANALOG_TYPE_NONE) axesOfChange[axisToChange].push_back(bounds(adjustedValue,minValue,maxValue));
-        }
-    }
-
-    for (auto currAxis = axesOfChange.begin(); currAxis != axesOfChange.end(); ++currAxis) {
-        if (!currAxis->second.empty()) {
-            axisType = currAxis->first;
-
-            switch (axisType) {
-                case WII_ANALOG_TYPE_LEFT_STICK_X:
-                    gamepad->state.lx = getDelta(currAxis->second, joystickMid);
-                    break;
-                case WII_ANALOG_TYPE_LEFT_STICK_Y:
-                    gamepad->state.ly = getDelta(currAxis->second, joystickMid);
-                    break;
-                case WII_ANALOG_TYPE_RIGHT_STICK_X:
-                    gamepad->state.rx = getDelta(currAxis->second, joystickMid);
-                    break;
-                case WII_ANALOG_TYPE_RIGHT_STICK_Y:
-                    gamepad->state.ry = getDelta(currAxis->second, joystickMid);
-                    break;
-                case WII_ANALOG_TYPE_LEFT_TRIGGER:
-                    gamepad->state.lt = getDelta(currAxis->second, GAMEPAD_TRIGGER_MID);
-                    break;
-                case WII_ANALOG_TYPE_RIGHT_TRIGGER:
-                    gamepad->state.rt = getDelta(currAxis->second, GAMEPAD_TRIGGER_MID);
-                    break;
-            }
-        }
-    }
-}
-
-void WiiExtensionInput::updateMotionState() {
-    Gamepad * gamepad = Storage::getInstance().GetGamepad();
-
-    gamepad->auxState.sensors.accelerometer.enabled = isAccelerometer;
-    if (isAccelerometer) {
-        gamepad->auxState.sensors.accelerometer.x = accelerometerX;
-        gamepad->auxState.sensors.accelerometer.y = accelerometerY;
-        gamepad->auxState.sensors.accelerometer.z = accelerometerZ;
+void WiiExtensionInput::updateMotionState(Gamepad * gamepad, ExtensionBase * controller) {
+    gamepad->auxState.sensors.accelerometer.enabled = decoder.hasAccelerometer;
+    if (decoder.hasAccelerometer) {
+        gamepad->auxState.sensors.accelerometer.x = controller->motionState[WiiMotions::WII_ACCELEROMETER_X];
+        gamepad->auxState.sensors.accelerometer.y = controller->motionState[WiiMotions::WII_ACCELEROMETER_Y];
+        gamepad->auxState.sensors.accelerometer.z = controller->motionState[WiiMotions::WII_ACCELEROMETER_Z];
         gamepad->auxState.sensors.accelerometer.active = true;
     }
 
-    gamepad->auxState.sensors.gyroscope.enabled = isGyroscope;
-    if (isGyroscope) {
-        gamepad->auxState.sensors.gyroscope.x = gyroscopeX;
-        gamepad->auxState.sensors.gyroscope.y = gyroscopeY;
-        gamepad->auxState.sensors.gyroscope.z = gyroscopeZ;
+    gamepad->auxState.sensors.gyroscope.enabled = decoder.hasGyroscope;
+    if (decoder.hasGyroscope) {
+        gamepad->auxState.sensors.gyroscope.x = controller->motionState[WiiMotions::WII_GYROSCOPE_YAW];
+        gamepad->auxState.sensors.gyroscope.y = controller->motionState[WiiMotions::WII_GYROSCOPE_ROLL];
+        gamepad->auxState.sensors.gyroscope.z = controller->motionState[WiiMotions::WII_GYROSCOPE_PITCH];
         gamepad->auxState.sensors.gyroscope.active = true;
     }
 
-    gamepad->auxState.sensors.touchpad[0].enabled = isTouch;
-    if (isTouch) {
-        gamepad->auxState.sensors.touchpad[0].x = touchX;
-        gamepad->auxState.sensors.touchpad[0].y = touchY;
-        gamepad->auxState.sensors.touchpad[0].z = touchZ;
-        gamepad->auxState.sensors.touchpad[0].active = touchPressed;
-    }
-}
-
-uint16_t WiiExtensionInput::getAverage(std::vector<WiiAnalogChange> const& changes) {
-    uint16_t values = 0;
-
-    if (changes.empty()) {
-        return 0;
-    }
-
-    for (auto currVal = changes.begin(); currVal != changes.end(); ++currVal) {
-        values += currVal->analogValue;
+    gamepad->auxState.sensors.touchpad[0].enabled = decoder.hasTouch;
+    if (decoder.hasTouch) {
+        gamepad->auxState.sensors.touchpad[0].x = controller->motionState[WiiMotions::WII_TOUCH_X];
+        gamepad->auxState.sensors.touchpad[0].y = controller->motionState[WiiMotions::WII_TOUCH_Y];
+        gamepad->auxState.sensors.touchpad[0].z = controller->motionState[WiiMotions::WII_TOUCH_Z];
+        gamepad->auxState.sensors.touchpad[0].active = controller->motionState[WiiMotions::WII_TOUCH_PRESSED];
     }
-
-    return values / changes.size();
-}
-
-uint16_t WiiExtensionInput::getDelta(std::vector<uint16_t> const& changes, uint16_t baseValue) {
-    uint16_t value = baseValue;
-
-    if (changes.empty()) {
-        return baseValue;
-    }
-
-    for (auto currVal = changes.begin(); currVal != changes.end(); ++currVal) {
-        if (*currVal != baseValue) {
-            if (*currVal < baseValue) {
-                value -= (baseValue - *currVal);
-            } else if (*currVal > baseValue) {
-                value += (*currVal - baseValue);
-            }
-        }
-    }
-
-    return value;
 }
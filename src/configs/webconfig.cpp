@@ -1,6 +1,7 @@
 #include "configs/webconfig.h"
 #include "config.pb.h"
 #include "configs/base64.h"
+#include "configs/webconfig_routes.h"
 
 #include "storagemanager.h"
 #include "configmanager.h"
@@ -9,6 +10,7 @@
 #include "peripheralmanager.h"
 #include "AnimationStorage.hpp"
 #include "system.h"
+#include "taskmanager.h"
 #include "config_utils.h"
 #include "types.h"
 #include "version.h"
@@ -42,8 +44,6 @@ using namespace std;
 
 extern struct fsdata_file file__index_html[];
 
-const static char* spaPaths[] = { "/backup", "/display-config", "/led-config", "/pin-mapping", "/settings", "/reset-settings", "/add-ons", "/custom-theme", "/macro", "/peripheral-mapping" };
-const static char* excludePaths[] = { "/css", "/images", "/js", "/static" };
 const static uint32_t rebootDelayMs = 500;
 static string http_post_uri;
 static char http_post_payload[LWIP_HTTPD_POST_MAX_PAYLOAD_LEN];
@@ -251,9 +251,11 @@ struct DataAndStatusCode
 };
 
 // **** WEB SERVER Overrides and Special Functionality ****
+// Every response gets its own buffer, owned by the fs_file and released in fs_close_custom,
+// so a request on another connection cannot overwrite a response that is still being sent
 int set_file_data(fs_file* file, const DataAndStatusCode& dataAndStatusCode)
 {
-    static string returnData;
+    string* returnData = new string();
 
     const char* statusCodeStr = "";
     switch (dataAndStatusCode.statusCode)
@@ -263,25 +265,25 @@ int set_file_data(fs_file* file, const DataAndStatusCode& dataAndStatusCode)
         case HttpStatusCode::_500: statusCodeStr = "500 Internal Server Error"; break;
     }
 
-    returnData.clear();
-    returnData.append("HTTP/1.0 ");
-    returnData.append(statusCodeStr);
-    returnData.append("\r\n");
-    returnData.append(
+    returnData->append("HTTP/1.1 ");
+    returnData->append(statusCodeStr);
+    returnData->append("\r\n");
+    returnData->append(
         "Server: GP2040-CE " GP2040VERSION "\r\n"
         "Content-Type: application/json\r\n"
         "Access-Control-Allow-Origin: *\r\n"
         "Content-Length: "
     );
-    returnData.append(std::to_string(dataAndStatusCode.data.length()));
-    returnData.append("\r\n\r\n");
-    returnData.append(dataAndStatusCode.data);
+    returnData->append(std::to_string(dataAndStatusCode.data.length()));
+    returnData->append("\r\n\r\n");
+    returnData->append(dataAndStatusCode.data);
 
-    file->data = returnData.c_str();
-    file->len = returnData.size();
+    file->data = returnData->c_str();
+    file->len = returnData->size();
     file->index = file->len;
-    file->http_header_included = file->http_header_included;
-    file->pextension = NULL;
+    // Complete header with an exact Content-Length, so httpd could keep the connection alive
+    file->http_header_included = FS_FILE_FLAGS_HEADER_INCLUDED | FS_FILE_FLAGS_HEADER_PERSISTENT;
+    file->pextension = returnData;
 
     return 1;
 }
@@ -1560,6 +1562,7 @@ std::string setAddonOptions()
 
     AnalogADS1219Options& analogADS1219Options = Storage::getInstance().getAddonOptions().analogADS1219Options;
     docToValue(analogADS1219Options.enabled, doc, "I2CAnalog1219InputEnabled");
+    docToPin(analogADS1219Options.drdyPin, doc, "I2CAnalog1219DrdyPin");
 
     PlayerNumberOptions& playerNumberOptions = Storage::getInstance().getAddonOptions().playerNumberOptions;
     docToValue(playerNumberOptions.number, doc, "playerNumber");
@@ -1970,6 +1973,7 @@ std::string getAddonOptions()
 
     const AnalogADS1219Options& analogADS1219Options = Storage::getInstance().getAddonOptions().analogADS1219Options;
     writeDoc(doc, "I2CAnalog1219InputEnabled", analogADS1219Options.enabled);
+    writeDoc(doc, "I2CAnalog1219DrdyPin", cleanPin(analogADS1219Options.drdyPin));
 
     const PlayerNumberOptions& playerNumberOptions = Storage::getInstance().getAddonOptions().playerNumberOptions;
     writeDoc(doc, "playerNumber", playerNumberOptions.number);
@@ -2200,6 +2204,54 @@ std::string getMemoryReport()
     return serialize_json(doc);
 }
 
+void addBootTimeline(DynamicJsonDocument& doc, const char* key, const System::BootTimeline& timeline)
+{
+    auto cores = doc.createNestedArray(key);
+    for (uint8_t core = 0; core < 2; core++) {
+        auto entries = cores.createNestedArray();
+        for (uint8_t i = 0; i < timeline.count[core] && i < BOOT_TIMELINE_MAX_ENTRIES; i++) {
+            auto entry = entries.createNestedObject();
+            entry["label"] = (const char*)timeline.entries[core][i].label;
+            entry["us"] = timeline.entries[core][i].timeUs;
+        }
+    }
+}
+
+// Per core boot steps of this (web config) boot and of the boot before it
+std::string getBootTimeline()
+{
+    DynamicJsonDocument doc(LWIP_HTTPD_POST_MAX_PAYLOAD_LEN);
+    addBootTimeline(doc, "current", System::getBootTimeline(false));
+    addBootTimeline(doc, "previous", System::getBootTimeline(true));
+    return serialize_json(doc);
+}
+
+void addTaskStats(DynamicJsonDocument& doc, const char* key, const TaskStatsTable& table)
+{
+    auto cores = doc.createNestedArray(key);
+    for (uint8_t core = 0; core < 2; core++) {
+        auto tasks = cores.createNestedArray();
+        for (uint8_t i = 0; i < table.count[core] && i < TASK_MANAGER_MAX_TASKS; i++) {
+            const TaskStats& stats = table.tasks[core][i];
+            auto task = tasks.createNestedObject();
+            task["name"] = (const char*)stats.name;
+            task["periodUs"] = stats.periodUs;
+            task["runs"] = stats.runs;
+            task["misses"] = stats.misses;
+            task["maxLateUs"] = stats.maxLateUs;
+        }
+    }
+}
+
+// Per core scheduled task counters of this (web config) boot and of the boot before it
+std::string getTaskStats()
+{
+    DynamicJsonDocument doc(LWIP_HTTPD_POST_MAX_PAYLOAD_LEN);
+    addTaskStats(doc, "current", TaskManager::getInstance().getStats(false));
+    addTaskStats(doc, "previous", TaskManager::getInstance().getStats(true));
+    return serialize_json(doc);
+}
+
 static bool _abortGetHeldPins = false;
 
 std::string getHeldPins()
@@ -2347,7 +2399,32 @@ std::string reboot()
 }
 
 typedef std::string (*HandlerFuncPtr)();
-static const std::pair<const char*, HandlerFuncPtr> handlerFuncs[] =
+typedef DataAndStatusCode (*HandlerFuncStatusCodePtr)();
+
+enum class RouteType : uint8_t
+{
+    HANDLER,
+    HANDLER_WITH_STATUS_CODE,
+    EXCLUDE,
+    SPA,
+};
+
+struct Route
+{
+    constexpr Route(const char* path, HandlerFuncPtr handler) :
+        path(path), type(RouteType::HANDLER), handler(handler), handlerWithStatusCode(nullptr) {}
+    constexpr Route(const char* path, HandlerFuncStatusCodePtr handler) :
+        path(path), type(RouteType::HANDLER_WITH_STATUS_CODE), handler(nullptr), handlerWithStatusCode(handler) {}
+    constexpr Route(const char* path, RouteType type) :
+        path(path), type(type), handler(nullptr), handlerWithStatusCode(nullptr) {}
+
+    const char* path;
+    RouteType type;
+    HandlerFuncPtr handler;
+    HandlerFuncStatusCodePtr handlerWithStatusCode;
+};
+
+static constexpr Route routes[] =
 {
     { "/api/setDisplayOptions", setDisplayOptions },
     { "/api/setPreviewDisplayOptions", setPreviewDisplayOptions },
@@ -2386,6 +2463,8 @@ static const std::pair<const char*, HandlerFuncPtr> handlerFuncs[] =
     { "/api/getSplashImage", getSplashImage },
     { "/api/getFirmwareVersion", getFirmwareVersion },
     { "/api/getMemoryReport", getMemoryReport },
+    { "/api/getBootTimeline", getBootTimeline },
+    { "/api/getTaskStats", getTaskStats },
     { "/api/getHeldPins", getHeldPins },
     { "/api/abortGetHeldPins", abortGetHeldPins },
     { "/api/getUsedPins", getUsedPins },
@@ -2393,40 +2472,41 @@ static const std::pair<const char*, HandlerFuncPtr> handlerFuncs[] =
 #if !defined(NDEBUG)
     { "/api/echo", echo },
 #endif
-};
-
-typedef DataAndStatusCode (*HandlerFuncStatusCodePtr)();
-static const std::pair<const char*, HandlerFuncStatusCodePtr> handlerFuncsWithStatusCode[] =
-{
     { "/api/setConfig", setConfig },
+    // Static asset directories are served from fsdata, never by the SPA fallback
+    { "/css", RouteType::EXCLUDE },
+    { "/images", RouteType::EXCLUDE },
+    { "/js", RouteType::EXCLUDE },
+    { "/static", RouteType::EXCLUDE },
+    // Client side routes of the SPA, all of them are answered with index.html
+    { "/backup", RouteType::SPA },
+    { "/display-config", RouteType::SPA },
+    { "/led-config", RouteType::SPA },
+    { "/pin-mapping", RouteType::SPA },
+    { "/settings", RouteType::SPA },
+    { "/reset-settings", RouteType::SPA },
+    { "/add-ons", RouteType::SPA },
+    { "/custom-theme", RouteType::SPA },
+    { "/macro", RouteType::SPA },
+    { "/peripheral-mapping", RouteType::SPA },
 };
 
+static constexpr auto routeTable = makeRouteTable(routes);
+static_assert(routeTable.valid, "No collision free seed found for the webconfig route table");
+
 int fs_open_custom(struct fs_file *file, const char *name)
 {
-    for (const auto& handlerFunc : handlerFuncs)
-    {
-        if (strcmp(handlerFunc.first, name) == 0)
-        {
-            return set_file_data(file, handlerFunc.second());
-        }
-    }
-
-    for (const auto& handlerFunc : handlerFuncsWithStatusCode)
-    {
-        if (strcmp(handlerFunc.first, name) == 0)
-        {
-            return set_file_data(file, handlerFunc.second());
-        }
-    }
-
-    for (const char* excludePath : excludePaths)
-        if (strcmp(excludePath, name) == 0)
-            return 0;
+    const Route* route = findRoute(routeTable, routes, name);
+    if (route == nullptr)
+        return 0;
 
-    for (const char* spaPath : spaPaths)
+    switch (route->type)
     {
-        if (strcmp(spaPath, name) == 0)
-        {
+        case RouteType::HANDLER:
+            return set_file_data(file, route->handler());
+        case RouteType::HANDLER_WITH_STATUS_CODE:
+            return set_file_data(file, route->handlerWithStatusCode());
+        case RouteType::SPA:
             file->data = (const char *)file__index_html[0].data;
             file->len = file__index_html[0].len;
             file->index = file__index_html[0].len;
@@ -2434,17 +2514,17 @@ int fs_open_custom(struct fs_file *file, const char *name)
             file->pextension = NULL;
             file->is_custom_file = 0;
             return 1;
-        }
+        case RouteType::EXCLUDE:
+        default:
+            return 0;
     }
-
-    return 0;
 }
 
 void fs_close_custom(struct fs_file *file)
 {
     if (file && file->is_custom_file && file->pextension)
     {
-        mem_free(file->pextension);
+        delete static_cast<string*>(file->pextension);
         file->pextension = NULL;
     }
 }
@@ -5,7 +5,6 @@ void GPButton::draw() {
     // new style button:
     uint16_t baseX = this->x;
     uint16_t baseY = this->y;
-    Mask_t pinValues = ~gpio_get_all();
 
     // scale to viewport
     double scaleX = this->getScaleX();
@@ -29,9 +28,66 @@ void GPButton::draw() {
         baseY = ((this->y) * scaleY + this->getViewport().top);
     }
 
+    uint16_t state = getPressed();
+    bool turbo = getTurbo();
+
+    // base
+    if (this->_shape == GP_SHAPE_ELLIPSE) {
+        uint16_t scaledSize = (uint16_t)((double)this->_sizeX * scaleX);
+        uint16_t baseRadius = (uint16_t)scaledSize;
+        uint16_t turboRadius = (uint16_t)scaledSize * GP_BUTTON_TURBO_SCALE;
+
+        getRenderer()->drawEllipse(baseX, baseY, baseRadius, baseRadius, this->strokeColor, state);
+        if (turbo) {
+            getRenderer()->drawEllipse(baseX, baseY, turboRadius, turboRadius, 1, 0);
+        }
+    } else if (this->_shape == GP_SHAPE_SQUARE) {
+        uint16_t sizeX = (this->_sizeX) * scaleX + this->getViewport().left;
+        uint16_t sizeY = (this->_sizeY) * scaleY + this->getViewport().top;
+        uint16_t width = sizeX - baseX;
+        uint16_t height = sizeY - baseY;
+        uint16_t turboW = (uint16_t)round(width * GP_BUTTON_TURBO_SCALE);
+        uint16_t turboH = (uint16_t)round(height * GP_BUTTON_TURBO_SCALE);
+        uint16_t turboX = baseX + (width - turboW) / 2;
+        uint16_t turboY = baseY + (height - turboH) / 2;
+
+        getRenderer()->drawRectangle(baseX, baseY, sizeX+offsetX, sizeY, this->strokeColor, state, this->_angle);
+        if (turbo) {
+            getRenderer()->drawRectangle(turboX, turboY, turboX+turboW, turboY+turboH, 1, 0, this->_angle);
+        }
+    } else if (this->_shape == GP_SHAPE_LINE) {
+        getRenderer()->drawLine(baseX, baseY, this->_sizeX, this->_sizeY, this->strokeColor, 0);
+    } else if (this->_shape == GP_SHAPE_POLYGON) {
+        uint16_t scaledSize = (uint16_t)((double)this->_sizeX * scaleX);
+        uint16_t baseRadius = (uint16_t)scaledSize;
+        uint16_t turboRadius = (uint16_t)scaledSize * GP_BUTTON_TURBO_SCALE;
+
+        getRenderer()->drawPolygon(baseX, baseY, baseRadius, this->_sizeY, this->strokeColor, state, this->_angle);
+        if (turbo) {
+            getRenderer()->drawPolygon(baseX, baseY, turboRadius, this->_sizeY, 1, 0, this->_angle);
+        }
+    } else if (this->_shape == GP_SHAPE_ARC) {
+        uint16_t scaledSize = (uint16_t)((double)this->_sizeX * scaleX);
+        uint16_t baseRadius = (uint16_t)scaledSize;
+        uint16_t turboRadius = (uint16_t)scaledSize * GP_BUTTON_TURBO_SCALE;
+
+        getRenderer()->drawArc(baseX, baseY, baseRadius, baseRadius, this->strokeColor, state, this->_angle, this->_angleEnd, this->_closed);
+        if (turbo) {
+            getRenderer()->drawArc(baseX, baseY, turboRadius, turboRadius, 1, 0, this->_angle, this->_angleEnd, this->_closed);
+        }
+    }
+}
+
+bool GPButton::getStateKey(uint32_t& key) {
+    key = (getPressed() ? 0x01 : 0x00) | (getTurbo() ? 0x02 : 0x00);
+    return true;
+}
+
+bool GPButton::getPressed() {
+    Mask_t pinValues = ~gpio_get_all();
+
     bool pinState = false;
     bool buttonState = false;
-    uint16_t state = 0;
     int16_t setPin = -1;
     int32_t maskedPins = 0;
     bool useMask = false;
@@ -105,51 +161,9 @@ void GPButton::draw() {
         }
     }
 
-    state = (buttonState ? pinState : 0);
-
-    // base
-    if (this->_shape == GP_SHAPE_ELLIPSE) {
-        uint16_t scaledSize = (uint16_t)((double)this->_sizeX * scaleX);
-        uint16_t baseRadius = (uint16_t)scaledSize;
-        uint16_t turboRadius = (uint16_t)scaledSize * GP_BUTTON_TURBO_SCALE;
-
-        getRenderer()->drawEllipse(baseX, baseY, baseRadius, baseRadius, this->strokeColor, state);
-        if (this->_inputType == GP_ELEMENT_BTN_BUTTON && (getGamepad()->turboState.buttons & this->_inputMask)) {
-            getRenderer()->drawEllipse(baseX, baseY, turboRadius, turboRadius, 1, 0);
-        }
-    } else if (this->_shape == GP_SHAPE_SQUARE) {
-        uint16_t sizeX = (this->_sizeX) * scaleX + this->getViewport().left;
-        uint16_t sizeY = (this->_sizeY) * scaleY + this->getViewport().top;
-        uint16_t width = sizeX - baseX;
-        uint16_t height = sizeY - baseY;
-        uint16_t turboW = (uint16_t)round(width * GP_BUTTON_TURBO_SCALE);
-        uint16_t turboH = (uint16_t)round(height * GP_BUTTON_TURBO_SCALE);
-        uint16_t turboX = baseX + (width - turboW) / 2;
-        uint16_t turboY = baseY + (height - turboH) / 2;
-
-        getRenderer()->drawRectangle(baseX, baseY, sizeX+offsetX, sizeY, this->strokeColor, state, this->_angle);
-        if (this->_inputType == GP_ELEMENT_BTN_BUTTON && (getGamepad()->turboState.buttons & this->_inputMask)) {
-            getRenderer()->drawRectangle(turboX, turboY, turboX+turboW, turboY+turboH, 1, 0, this->_angle);
-        }
-    } else if (this->_shape == GP_SHAPE_LINE) {
-        getRenderer()->drawLine(baseX, baseY, this->_sizeX, this->_sizeY, this->strokeColor, 0);
-    } else if (this->_shape == GP_SHAPE_POLYGON) {
-        uint16_t scaledSize = (uint16_t)((double)this->_sizeX * scaleX);
-        uint16_t baseRadius = (uint16_t)scaledSize;
-        uint16_t turboRadius = (uint16_t)scaledSize * GP_BUTTON_TURBO_SCALE;
-
-        getRenderer()->drawPolygon(baseX, baseY, baseRadius, this->_sizeY, this->strokeColor, state, this->_angle);
-        if (this->_inputType == GP_ELEMENT_BTN_BUTTON && (getGamepad()->turboState.buttons & this->_inputMask)) {
-            getRenderer()->drawPolygon(baseX, baseY, turboRadius, this->_sizeY, 1, 0, this->_angle);
-        }
-    } else if (this->_shape == GP_SHAPE_ARC) {
-        uint16_t scaledSize = (uint16_t)((double)this->_sizeX * scaleX);
-        uint16_t baseRadius = (uint16_t)scaledSize;
-        uint16_t turboRadius = (uint16_t)scaledSize * GP_BUTTON_TURBO_SCALE;
+    return (buttonState ? pinState : false);
+}
 
-        getRenderer()->drawArc(baseX, baseY, baseRadius, baseRadius, this->strokeColor, state, this->_angle, this->_angleEnd, this->_closed);
-        if (this->_inputType == GP_ELEMENT_BTN_BUTTON && (getGamepad()->turboState.buttons & this->_inputMask)) {
-            getRenderer()->drawArc(baseX, baseY, turboRadius, turboRadius, 1, 0, this->_angle, this->_angleEnd, this->_closed);
-        }
-    }
+bool GPButton::getTurbo() {
+    return (this->_inputType == GP_ELEMENT_BTN_BUTTON) && (getGamepad()->turboState.buttons & this->_inputMask);
 }
@@ -39,10 +39,11 @@ void GPLever::draw() {
 
     if (this->_inputType == DPAD_MODE_DIGITAL) {
         // dpad
-        bool upState    = (this->_upMask > -1 ? getProcessedGamepad()->pressedButton((uint16_t)this->_upMask) : getProcessedGamepad()->pressedUp());
-        bool leftState  = (this->_leftMask > -1 ? getProcessedGamepad()->pressedButton((uint16_t)this->_leftMask) : getProcessedGamepad()->pressedLeft());
-        bool downState  = (this->_downMask > -1 ? getProcessedGamepad()->pressedButton((uint16_t)this->_downMask) : getProcessedGamepad()->pressedDown());
-        bool rightState = (this->_rightMask > -1 ? getProcessedGamepad()->pressedButton((uint16_t)this->_rightMask) : getProcessedGamepad()->pressedRight());
+        uint8_t directions = getDirections();
+        bool upState    = (directions & GAMEPAD_MASK_UP);
+        bool leftState  = (directions & GAMEPAD_MASK_LEFT);
+        bool downState  = (directions & GAMEPAD_MASK_DOWN);
+        bool rightState = (directions & GAMEPAD_MASK_RIGHT);
         if (upState != downState) {
             leverY -= upState ? leverRadius : -leverRadius;
         }
@@ -51,8 +52,8 @@ void GPLever::draw() {
         }
     } else {
         // analog
-        uint16_t analogX = map((this->_inputType == DPAD_MODE_LEFT_ANALOG ? getProcessedGamepad()->state.lx : getProcessedGamepad()->state.rx), 0, 0xFFFF, 0, 100);
-        uint16_t analogY = map((this->_inputType == DPAD_MODE_LEFT_ANALOG ? getProcessedGamepad()->state.ly : getProcessedGamepad()->state.ry), 0, 0xFFFF, 0, 100);
+        uint16_t analogX, analogY;
+        getAnalog(analogX, analogY);
 
         uint16_t minX = std::max(0,(baseX - baseRadius));
         uint16_t maxX = std::min((baseX + baseRadius),128);
@@ -104,9 +105,36 @@ void GPLever::draw() {
     getRenderer()->drawEllipse(leverX, leverY, leverRadius, leverRadius, this->strokeColor, 1);
 }
 
+bool GPLever::getStateKey(uint32_t& key) {
+    // only the inputs the lever shows: four direction bits, or the stick at display resolution
+    if (this->_inputType == DPAD_MODE_DIGITAL) {
+        key = getDirections();
+    } else {
+        uint16_t analogX, analogY;
+        getAnalog(analogX, analogY);
+        key = (analogX << 8) | analogY;
+    }
+    return true;
+}
+
+uint8_t GPLever::getDirections() {
+    uint8_t directions = 0;
+    if (this->_upMask > -1 ? getProcessedGamepad()->pressedButton((uint16_t)this->_upMask) : getProcessedGamepad()->pressedUp()) directions |= GAMEPAD_MASK_UP;
+    if (this->_downMask > -1 ? getProcessedGamepad()->pressedButton((uint16_t)this->_downMask) : getProcessedGamepad()->pressedDown()) directions |= GAMEPAD_MASK_DOWN;
+    if (this->_leftMask > -1 ? getProcessedGamepad()->pressedButton((uint16_t)this->_leftMask) : getProcessedGamepad()->pressedLeft()) directions |= GAMEPAD_MASK_LEFT;
+    if (this->_rightMask > -1 ? getProcessedGamepad()->pressedButton((uint16_t)this->_rightMask) : getProcessedGamepad()->pressedRight()) directions |= GAMEPAD_MASK_RIGHT;
+    return directions;
+}
+
+void GPLever::getAnalog(uint16_t& analogX, uint16_t& analogY) {
+    analogX = map((this->_inputType == DPAD_MODE_LEFT_ANALOG ? getProcessedGamepad()->state.lx : getProcessedGamepad()->state.rx), 0, 0xFFFF, 0, 100);
+    analogY = map((this->_inputType == DPAD_MODE_LEFT_ANALOG ? getProcessedGamepad()->state.ly : getProcessedGamepad()->state.ry), 0, 0xFFFF, 0, 100);
+}
+
 void GPLever::setDirectionMasks(int32_t upMask, int32_t downMask, int32_t leftMask, int32_t rightMask) {
     this->_upMask = upMask;
     this->_downMask = downMask;
     this->_leftMask = leftMask;
     this->_rightMask = rightMask;
+    invalidate();
 }
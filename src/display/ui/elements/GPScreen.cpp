@@ -1,19 +1,46 @@
 #include "GPScreen.h"
 
+#include <algorithm>
+
 const bool prioritySort(GPWidget * a, GPWidget * b) {
     return a->getPriority() > b->getPriority();
 }
 
 void GPScreen::draw() {
-    getRenderer()->clearScreen();
+    GPGFX_DisplayBase* driver = getRenderer()->getDriver();
+    uint8_t* frameBuffer = driver->getFrameBuffer();
+    uint16_t frameSize = driver->getFrameBufferSize();
+
+    // every widget is polled so the keys stay current, even once a redraw is already known
+    bool redraw = !widgetLayerValid;
+    bool ordered = true;
+    for (size_t i = 0; i < displayList.size(); i++) {
+        if (displayList[i]->refreshState()) redraw = true;
+        if ((i > 0) && (displayList[i-1]->getPriority() < displayList[i]->getPriority())) ordered = false;
+    }
+
+    // priorities only change through setPriority, so the list is re-sorted only when one did
+    if (!ordered) {
+        std::stable_sort(displayList.begin(), displayList.end(), prioritySort);
+    }
 
-    // draw the display list
-    if ( displayList.size() > 0 ) {
-        std::sort(displayList.begin(), displayList.end(), prioritySort);
+    if (redraw || (frameBuffer == nullptr)) {
+        getRenderer()->clearScreen();
+
+        // draw the display list
         for(std::vector<GPWidget*>::iterator it = displayList.begin(); it != displayList.end(); ++it) {
             (*it)->draw();
         }
+
+        if (frameBuffer != nullptr) {
+            widgetLayer.assign(frameBuffer, frameBuffer + frameSize);
+            widgetLayerValid = true;
+        }
+    } else {
+        // nothing the widgets show has changed, start from their last rendering
+        memcpy(frameBuffer, widgetLayer.data(), frameSize);
     }
+
     drawScreen();
     getRenderer()->render();
 }
@@ -23,4 +50,7 @@ void GPScreen::clear() {
         displayList.clear();
         displayList.shrink_to_fit();
     }
+    widgetLayer.clear();
+    widgetLayer.shrink_to_fit();
+    widgetLayerValid = false;
 }
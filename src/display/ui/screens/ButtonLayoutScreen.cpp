@@ -19,8 +19,9 @@ void ButtonLayoutScreen::init() {
     EventManager::getInstance().registerEventHandler(GP_EVENT_USBHOST_UNMOUNT, GPEVENT_CALLBACK(this->handleUSB(event)));
     
     footer = "";
-    historyString = "";
-    inputHistory.clear();
+    footer.reserve(INPUT_HISTORY_MAX_LENGTH);
+    historyLineLength = 0;
+    lastInput = 0;
 
     setViewport((isInputHistoryEnabled ? 8 : 0), 0, (isInputHistoryEnabled ? 56 : getRenderer()->getDriver()->getMetrics()->height), getRenderer()->getDriver()->getMetrics()->width);
 
@@ -335,10 +336,8 @@ GPWidget* ButtonLayoutScreen::pushElement(GPButtonLayout element) {
 }
 
 void ButtonLayoutScreen::processInputHistory() {
-	std::deque<std::string> pressed;
-
 	// Get key states
-	std::array<bool, INPUT_HISTORY_MAX_INPUTS> currentInput = {
+	const bool currentStates[INPUT_HISTORY_MAX_INPUTS] = {
 
 		pressedUp(),
 		pressedDown(),
@@ -366,57 +365,61 @@ void ButtonLayoutScreen::processInputHistory() {
 		getProcessedGamepad()->pressedA2(),
 	};
 
-	uint8_t mode = ((displayModeLookup.count(getGamepad()->getOptions().inputMode) > 0) ? displayModeLookup.at(getGamepad()->getOptions().inputMode) : 0);
-
-	// Check if any new keys have been pressed
-	if (lastInput != currentInput) {
-		// Iterate through array
-		for (uint8_t x=0; x<INPUT_HISTORY_MAX_INPUTS; x++) {
-			// Add any pressed keys to deque
-			std::string inputChar(displayNames[mode][x]);
-			if (currentInput[x] && (inputChar != "")) pressed.push_back(inputChar);
-		}
-		// Update the last keypress array
-		lastInput = currentInput;
+	uint32_t currentInput = 0;
+	for (uint8_t x=0; x<INPUT_HISTORY_MAX_INPUTS; x++) {
+		if (currentStates[x]) currentInput |= (1U << x);
 	}
 
-	if (pressed.size() > 0) {
-		std::string newInput;
-		for(const auto &s : pressed) {
-				if(!newInput.empty())
-						newInput += "+";
-				newInput += s;
-		}
-
-		inputHistory.push_back(newInput);
-	}
+	// Only a change in the pressed set adds an entry
+	if (lastInput == currentInput) return;
+	lastInput = currentInput;
 
-	if (inputHistory.size() > (inputHistoryLength / 2) + 1) {
-		inputHistory.pop_front();
-	}
+	uint8_t mode = ((displayModeLookup.count(getGamepad()->getOptions().inputMode) > 0) ? displayModeLookup.at(getGamepad()->getOptions().inputMode) : 0);
 
-	std::string ret;
+	// Join the glyphs of everything held, e.g. "B+A"
+	char entry[INPUT_HISTORY_MAX_INPUTS * 4];
+	uint8_t entryLength = 0;
+	for (uint8_t x=0; x<INPUT_HISTORY_MAX_INPUTS; x++) {
+		const char* inputChar = displayNames[mode][x];
+		if (!(currentInput & (1U << x)) || (inputChar[0] == '\0')) continue;
 
-	for (auto it = inputHistory.crbegin(); it != inputHistory.crend(); ++it) {
-		std::string newRet = ret;
-		if (!newRet.empty())
-			newRet = " " + newRet;
+		if (entryLength > 0) entry[entryLength++] = '+';
+		while (*inputChar != '\0') entry[entryLength++] = *inputChar++;
+	}
 
-		newRet = *it + newRet;
-		ret = newRet;
+	if (entryLength > 0) {
+		appendInputHistory(entry, entryLength);
+	}
+}
 
-		if (ret.size() >= inputHistoryLength) {
-			break;
+void ButtonLayoutScreen::appendInputHistory(const char* entry, uint8_t entryLength) {
+	uint8_t lineLimit = MIN(inputHistoryLength, (size_t)INPUT_HISTORY_MAX_LENGTH);
+	uint8_t separator = (historyLineLength > 0) ? 1 : 0;
+	uint16_t newLength = historyLineLength + separator + entryLength;
+
+	// Only the newest entry is rendered; older glyphs just shift left off the line
+	if (newLength > lineLimit) {
+		uint16_t drop = newLength - lineLimit;
+		if (drop >= (uint16_t)(historyLineLength + separator)) {
+			entry += drop - (historyLineLength + separator);
+			entryLength -= drop - (historyLineLength + separator);
+			historyLineLength = 0;
+			separator = 0;
+		} else if (drop >= historyLineLength) {
+			separator -= drop - historyLineLength;
+			historyLineLength = 0;
+		} else {
+			memmove(historyLine, historyLine + drop, historyLineLength - drop);
+			historyLineLength -= drop;
 		}
 	}
 
-	if(ret.size() >= inputHistoryLength) {
-		historyString = ret.substr(ret.size() - inputHistoryLength);
-	} else {
-		historyString = ret;
-	}
+	if (separator > 0) historyLine[historyLineLength++] = ' ';
+	memcpy(historyLine + historyLineLength, entry, entryLength);
+	historyLineLength += entryLength;
 
-    footer = historyString;
+	// footer keeps the capacity reserved in init, so this never allocates
+	footer.assign(historyLine, historyLineLength);
 }
 
 bool ButtonLayoutScreen::compareCustomLayouts()
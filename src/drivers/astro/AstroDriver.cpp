@@ -2,6 +2,8 @@
 #include "drivers/shared/driverhelper.h"
 
 void AstroDriver::initialize() {
+	reportLatchEnabled = true;
+
 	astroReport = {
 		.id = 1,
 		.notuse1 = 0x7f,
@@ -65,6 +67,7 @@ void AstroDriver::process(Gamepad * gamepad) {
 		// HID ready + report sent, copy previous report
 		if (tud_hid_ready() && tud_hid_report(0, report, report_size) == true ) {
 			memcpy(last_report, report, report_size);
+			reportSent();
 		}
 	}
 }
@@ -2,6 +2,8 @@
 #include "drivers/shared/driverhelper.h"
 
 void EgretDriver::initialize() {
+	reportLatchEnabled = true;
+
 	egretReport = {
 		.buttons = 0,
 		.lx = EGRET_JOYSTICK_MID,
@@ -58,6 +60,7 @@ void EgretDriver::process(Gamepad * gamepad) {
 		// HID ready + report sent, copy previous report
 		if (tud_hid_ready() && tud_hid_report(0, report, report_size) == true ) {
 			memcpy(last_report, report, report_size);
+			reportSent();
 		}
 	}
 }
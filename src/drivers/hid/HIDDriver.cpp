@@ -14,6 +14,8 @@ static bool hid_control_xfer_cb(uint8_t rhport, uint8_t stage, tusb_control_requ
 }
 
 void HIDDriver::initialize() {
+	reportLatchEnabled = true;
+
 	hidReport = {
 		.buttons = 0,
 		.direction = HID_HAT_NOTHING,
@@ -104,6 +106,7 @@ void HIDDriver::process(Gamepad * gamepad) {
 		// HID ready + report sent, copy previous report
 		if (tud_hid_ready() && tud_hid_report(0, report, report_size) == true ) {
 			memcpy(last_report, report, report_size);
+			reportSent();
 		}
 	}
 }
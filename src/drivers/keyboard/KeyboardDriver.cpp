@@ -6,6 +6,8 @@
 #include "eventmanager.h"
 
 void KeyboardDriver::initialize() {
+	reportLatchEnabled = true;
+
 	keyboardReport = {
 		.keycode = { 0 },
 		.multimedia = 0
@@ -120,6 +122,7 @@ void KeyboardDriver::process(Gamepad * gamepad) {
 		if (tud_hid_ready()) {
 			if ( tud_hid_report(keyboardReport.reportId, keyboard_report_payload, keyboard_report_size) ) {
 				memcpy(last_report, keyboard_report_payload, keyboard_report_size);
+				reportSent();
 				last_report_size = keyboard_report_size;
 
                 // Adjust volume on success
@@ -2,6 +2,8 @@
 #include "drivers/shared/driverhelper.h"
 
 void MDMiniDriver::initialize() {
+	reportLatchEnabled = true;
+
 	mdminiReport = {
 		.id = 0x01,
 		.notuse1 = 0x7f,
@@ -56,6 +58,7 @@ void MDMiniDriver::process(Gamepad * gamepad) {
 		// HID ready + report sent, copy previous report
 		if (tud_hid_ready() && tud_hid_report(0, report, report_size) == true ) {
 			memcpy(last_report, report, report_size);
+			reportSent();
 		}
 	}
 }
@@ -2,6 +2,8 @@
 #include "drivers/shared/driverhelper.h"
 
 void NeoGeoDriver::initialize() {
+	reportLatchEnabled = true;
+
 	neogeoReport = {
 		.buttons = 0,
 		.hat = 0xf,
@@ -77,6 +79,7 @@ void NeoGeoDriver::process(Gamepad * gamepad) {
 		// HID ready + report sent, copy previous report
 		if (tud_hid_ready() && tud_hid_report(0, report, report_size) == true ) {
 			memcpy(last_report, report, report_size);
+			reportSent();
 		}
 	}
 }
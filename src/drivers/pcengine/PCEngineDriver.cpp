@@ -2,6 +2,8 @@
 #include "drivers/shared/driverhelper.h"
 
 void PCEngineDriver::initialize() {
+	reportLatchEnabled = true;
+
 	pcengineReport = {
 		.buttons = 0,
 		.hat = 0xf,
@@ -57,6 +59,7 @@ void PCEngineDriver::process(Gamepad * gamepad) {
 		// HID ready + report sent, copy previous report
 		if (tud_hid_ready() && tud_hid_report(0, report, report_size) == true ) {
 			memcpy(last_report, report, report_size);
+			reportSent();
 		}
 	}
 }
@@ -10,6 +10,8 @@
 #include "pico/rand.h"
 
 void PS3Driver::initialize() {
+    reportLatchEnabled = true;
+
     ps3Report = {
         .reportID = 1,
         .reserved = 0,
@@ -140,6 +142,7 @@ void PS3Driver::process(Gamepad * gamepad) {
         // HID ready + report sent, copy previous report
         if (tud_hid_ready() && tud_hid_report(0, report, report_size) == true ) {
             memcpy(last_report, report, report_size);
+            reportSent();
         }
     }
 
@@ -14,6 +14,8 @@
 #include "mbedtls/rsa.h"
 #include "mbedtls/sha256.h"
 
+#include "hardware/sync.h"
+
 #define NEW_CONFIG_MPI(name, buf, size) \
     mbedtls_mpi_uint *bytes ## name = new mbedtls_mpi_uint[size / sizeof(mbedtls_mpi_uint)]; \
     mbedtls_mpi name = { .s=1, .n=size / sizeof(mbedtls_mpi_uint), .p=bytes ## name }; \
@@ -73,6 +75,11 @@ void PS4Auth::process() {
 // Init if we're in ps4 key mode
 void PS4Auth::keyModeInitialize() {
     ps4AuthData.valid_rsa = false;
+    ps4AuthData.nonce_received = 0;
+    ps4AuthData.nonce_hashing = 0;
+    ps4AuthData.nonce_pages_hashed = 0;
+    mbedtls_sha256_init(&ps4AuthData.nonce_sha256);
+    mbedtls_sha256_starts_ret(&ps4AuthData.nonce_sha256, 0);
     const PS4Options& options = Storage::getInstance().getAddonOptions().ps4Options;
     NEW_CONFIG_MPI(N, options.rsaN.bytes, options.rsaN.size)
     NEW_CONFIG_MPI(E, options.rsaE.bytes, options.rsaE.size)
@@ -88,10 +95,90 @@ void PS4Auth::keyModeInitialize() {
     DELETE_CONFIG_MPI(P)
     DELETE_CONFIG_MPI(Q)
 
+    if (ps4AuthData.valid_rsa) {
+        // mbedtls_rsa_complete() already derived the CRT parameters (DP, DQ, QP). The Montgomery
+        // R^2 values for N, P and Q are only cached on first use, fill them now with an x^1 so the
+        // first signature doesn't pay for them while the console waits.
+        mbedtls_mpi one, unused;
+        mbedtls_mpi_init(&one);
+        mbedtls_mpi_init(&unused);
+        mbedtls_mpi_lset(&one, 1);
+        mbedtls_mpi_exp_mod(&unused, &one, &one, &ps4AuthData.rsa_context.N, &ps4AuthData.rsa_context.RN);
+        mbedtls_mpi_exp_mod(&unused, &one, &one, &ps4AuthData.rsa_context.P, &ps4AuthData.rsa_context.RP);
+        mbedtls_mpi_exp_mod(&unused, &one, &one, &ps4AuthData.rsa_context.Q, &ps4AuthData.rsa_context.RQ);
+        mbedtls_mpi_free(&one);
+        mbedtls_mpi_free(&unused);
+
+        // Everything after the nonce signature never changes, build it once
+        size_t offset = 256;
+        memcpy(&ps4AuthData.ps4_auth_buffer[offset], options.serial.bytes, 16);
+        offset += 16;
+        mbedtls_rsa_export_raw(
+            &ps4AuthData.rsa_context,
+            &ps4AuthData.ps4_auth_buffer[offset], 256,
+            nullptr, 0,
+            nullptr, 0,
+            nullptr, 0,
+            &ps4AuthData.ps4_auth_buffer[offset+256], 256
+        );
+        offset += 512;
+        memcpy(&ps4AuthData.ps4_auth_buffer[offset], options.signature.bytes, 256);
+        offset += 256;
+        memset(&ps4AuthData.ps4_auth_buffer[offset], 0, 24);
+    }
+
     // Reset our random seed
     srand(0);
 }
 
+// Key mode: called by core0 (set report) after a nonce page was stored in ps4_auth_buffer.
+//  Only publishes the page, hashing happens on core1 in keyModeHashNonce().
+void PS4Auth::nonceReceived(uint8_t nonce_page) {
+    if (authType != InputModeAuthType::INPUT_MODE_AUTH_TYPE_KEYS || !ps4AuthData.valid_rsa) {
+        return;
+    }
+
+    uint16_t received = ps4AuthData.nonce_received;
+    uint8_t nonce = received >> 8;
+    uint8_t pages = received & 0xFF;
+    if ( nonce_page == 0 ) { // new nonce
+        nonce++;
+        pages = 0;
+    }
+    // Pages arrive in order 0-4, anything else falls back to hashing the full nonce when signing
+    pages = ( nonce_page == pages && pages < 5 ) ? pages + 1 : 0xFF;
+
+    __dmb(); // the page is in ps4_auth_buffer before core1 can see it counted
+    ps4AuthData.nonce_received = (nonce << 8) | pages;
+}
+
+// Key mode (core1): hash the nonce pages received since the last pass
+//  Returns true once all 5 pages of the current nonce are in nonce_sha256
+bool PS4Auth::keyModeHashNonce() {
+    uint16_t received = ps4AuthData.nonce_received;
+    __dmb(); // pages counted in received are visible from here on
+    uint8_t nonce = received >> 8;
+    uint8_t pages = received & 0xFF;
+
+    if ( nonce != ps4AuthData.nonce_hashing ) {
+        ps4AuthData.nonce_hashing = nonce;
+        ps4AuthData.nonce_pages_hashed = 0;
+        mbedtls_sha256_starts_ret(&ps4AuthData.nonce_sha256, 0);
+    }
+    if ( pages > 5 ) {
+        return false;
+    }
+
+    // 256 byte nonce, 4 56-byte pages, 1 32-byte page
+    while ( ps4AuthData.nonce_pages_hashed < pages ) {
+        uint8_t page = ps4AuthData.nonce_pages_hashed;
+        mbedtls_sha256_update_ret(&ps4AuthData.nonce_sha256, &ps4AuthData.ps4_auth_buffer[page*56],
+            (page == 4) ? 32 : 56);
+        ps4AuthData.nonce_pages_hashed++;
+    }
+    return ps4AuthData.nonce_pages_hashed == 5;
+}
+
 // Process if we are using ps4 keys
 void PS4Auth::keyModeProcess() {
     // Do not run if RSA is invalid
@@ -99,38 +186,33 @@ void PS4Auth::keyModeProcess() {
         return;
     }
 
+    // Hash nonce pages while the console is still sending the rest
+    bool nonceHashed = keyModeHashNonce();
+
     // Check to see if the PS4 Authentication needs work
     if ( ps4AuthData.passthrough_state == GPAuthState::send_auth_console_to_dongle ) {
-        const PS4Options& options = Storage::getInstance().getAddonOptions().ps4Options;
         int rss_error = 0;
-        uint8_t hashed_nonce[32];
-        // Sign our nonce into hashed_nonce
-        if ( mbedtls_sha256_ret(ps4AuthData.ps4_auth_buffer, 256, hashed_nonce, 0) < 0 ) {
+        __dmb(); // core0 changes the state after publishing the last page
+        // Pick up the last page if this pass missed it
+        if ( !nonceHashed ) {
+            nonceHashed = keyModeHashNonce();
+        }
+        if ( nonceHashed ) {
+            ps4AuthData.nonce_pages_hashed = 0xFF; // digest taken, a failure below rehashes in full
+            if ( mbedtls_sha256_finish_ret(&ps4AuthData.nonce_sha256, ps4AuthData.hashed_nonce) != 0 ) {
+                return;
+            }
+        } else if ( mbedtls_sha256_ret(ps4AuthData.ps4_auth_buffer, 256, ps4AuthData.hashed_nonce, 0) < 0 ) {
             return;
         }
+        // Sign our nonce, the rest of the auth buffer was filled in at initialization
         rss_error = mbedtls_rsa_rsassa_pss_sign(&ps4AuthData.rsa_context, rng, nullptr,
                 MBEDTLS_RSA_PRIVATE, MBEDTLS_MD_SHA256,
-                32, hashed_nonce,
+                32, ps4AuthData.hashed_nonce,
                 ps4AuthData.ps4_auth_buffer);
         if ( rss_error < 0 ) {
             return; // If we could not sign with our key, return (error)
         }
-        // copy the parts into our authentication buffer
-        size_t offset = 256;
-        memcpy(&ps4AuthData.ps4_auth_buffer[offset], options.serial.bytes, 16);
-        offset += 16;
-        mbedtls_rsa_export_raw(
-            &ps4AuthData.rsa_context,
-            &ps4AuthData.ps4_auth_buffer[offset], 256,
-            nullptr, 0,
-            nullptr, 0,
-            nullptr, 0,
-            &ps4AuthData.ps4_auth_buffer[offset+256], 256
-        );
-        offset += 512;
-        memcpy(&ps4AuthData.ps4_auth_buffer[offset], options.signature.bytes, 256);
-        offset += 256;
-        memset(&ps4AuthData.ps4_auth_buffer[offset], 0, 24);
         ps4AuthData.passthrough_state = GPAuthState::send_auth_dongle_to_console;
     }
 }
@@ -59,6 +59,8 @@ static constexpr uint8_t output_0xf3[] = {
 };
 
 void PS4Driver::initialize() {
+    reportLatchEnabled = true;
+
     Gamepad * gamepad = Storage::getInstance().GetGamepad();
     const GamepadOptions & options = gamepad->getOptions();
 
@@ -280,6 +282,7 @@ void PS4Driver::process(Gamepad * gamepad) {
         // HID ready + report sent, copy previous report
         if (tud_hid_ready() && tud_hid_report(0, report, report_size) == true ) {
             memcpy(last_report, report, report_size);
+            reportSent();
         }
         // keep track of our last successful report, for keepalive purposes
         last_report_timer = now;
@@ -466,6 +469,10 @@ void PS4Driver::set_report(uint8_t report_id, hid_report_type_t report_type, uin
         } else if (report_id == PS4AuthReport::PS4_SET_USB_BT_CONTROL) {
             // 
         } else if (report_id == PS4AuthReport::PS4_SET_AUTH_PAYLOAD) {
+            // Do nothing if we do not have host authentication data or a driver to run on
+            if ( ps4AuthData == nullptr || ps4AuthDriver == nullptr) {
+                return;
+            }
             uint8_t sendBuffer[64];
             uint8_t nonce_id;
             uint8_t nonce_page;
@@ -486,10 +493,12 @@ void PS4Driver::set_report(uint8_t report_id, hid_report_type_t report_type, uin
             nonce_page = buffer[1];
             if ( nonce_page == 4 ) {    // Nonce page 4 : 32 bytes
                 memcpy(&ps4AuthData->ps4_auth_buffer[nonce_page*56], &sendBuffer[4], 32);
+                ps4AuthDriver->nonceReceived(nonce_page);
                 ps4AuthData->nonce_id = nonce_id;
                 ps4AuthData->passthrough_state = GPAuthState::send_auth_console_to_dongle;
             } else {                    // Nonce page 0-3 : 56 bytes
                 memcpy(&ps4AuthData->ps4_auth_buffer[nonce_page*56], &sendBuffer[4], 56);
+                ps4AuthDriver->nonceReceived(nonce_page);
             }
             if ( nonce_page == 0 ) { // Set our passthrough state on first nonce
                 cur_nonce_id = nonce_id; // update current nonce ID
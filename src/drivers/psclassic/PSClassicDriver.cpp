@@ -2,6 +2,8 @@
 #include "drivers/shared/driverhelper.h"
 
 void PSClassicDriver::initialize() {
+	reportLatchEnabled = true;
+
 	psClassicReport = {
 		.buttons = 0x0014
 	};
@@ -58,6 +60,7 @@ void PSClassicDriver::process(Gamepad * gamepad) {
 		// HID ready + report sent, copy previous report
 		if (tud_hid_ready() && tud_hid_report(0, report, report_size) == true ) {
 			memcpy(last_report, report, report_size);
+			reportSent();
 		}
 	}
 }
@@ -28,6 +28,8 @@
 
 // Default Constructor
 XGIPProtocol::XGIPProtocol() {
+    reassemblyBuffer = nullptr;
+    reassemblyBufferSize = 0;
     reset();
 }
 
@@ -46,12 +48,18 @@ void XGIPProtocol::reset() {
     numberOfChunksSent = 0;     // How many actual chunks have we sent?
     chunkEnded = false;         // Are we at the end of the chunk?
     isValidPacket = false;      // Is this a valid packet?
-    memset(data, 0, 1024);
+    data = nullptr;             // We don't own any data, just forget about it
     dataLength = 0;             // Set data length to 0
     memset(packet, 0, sizeof(packet)); // Set our packet to 0
     packetLength = 0;           // Set packet length to 0
 }
 
+// Reassembly buffer survives reset(), it belongs to whoever consumes the incoming data
+void XGIPProtocol::setReassemblyBuffer(uint8_t * buffer, uint16_t size) {
+    reassemblyBuffer = buffer;
+    reassemblyBufferSize = size;
+}
+
 // Parse incoming packet
 bool XGIPProtocol::parse(const uint8_t * buffer, uint16_t len) {
     // Do we have enough room for a header? No, this isn't valid
@@ -111,6 +119,7 @@ bool XGIPProtocol::parse(const uint8_t * buffer, uint16_t len) {
 
                 // Set our chunk received to the header length
                 totalChunkReceived = header.length;
+                data = reassemblyBuffer;
             } else {
                 totalChunkReceived += header.length; // not actual data length, but chunk value
             }
@@ -118,16 +127,27 @@ bool XGIPProtocol::parse(const uint8_t * buffer, uint16_t len) {
             if ( header.length > GIP_MAX_CHUNK_SIZE ) { // if length is greater than 0x3A (bigger than 64 bytes), we know it is | 0x80 so we can ^ 0x80 and get the real length
                 copyLength ^= 0x80;  // packet length is set to length | 0x80 (0xBA instead of 0x3A)
             }
-            memcpy(&data[actualDataReceived], &buffer[6], copyLength); // 
+            if ( (uint32_t)copyLength + 6 > len ) { // chunk claims more than we received
+                isValidPacket = false;
+                return false;
+            }
+            if ( reassemblyBuffer != nullptr ) {
+                if ( (uint32_t)actualDataReceived + copyLength > reassemblyBufferSize ) {
+                    isValidPacket = false;
+                    return false;
+                }
+                memcpy(&reassemblyBuffer[actualDataReceived], &buffer[6], copyLength);
+            }
             actualDataReceived += copyLength;
             numberOfChunksSent++; // count our chunks for the ACK
             isValidPacket = true;
         } else {
             reset();
             memcpy((void*)&header, buffer, sizeof(GipHeader_t));
-            if ( header.length > 0 ) {
-                memcpy(data, &buffer[4], header.length); // copy incoming data
+            if ( header.length > len - sizeof(GipHeader_t) ) { // never read past what we received
+                header.length = len - sizeof(GipHeader_t);
             }
+            data = &buffer[4]; // read in place from the endpoint buffer
             actualDataReceived = header.length;
             dataLength = actualDataReceived;
             isValidPacket = true;
@@ -163,25 +183,32 @@ bool XGIPProtocol::setData(const uint8_t * buffer, uint16_t len) {
     if ( len > 0x3000) { // arbitrary but this should cover us if something bad happens
         return false;
     }
-    memcpy(data, buffer, len);
+    data = buffer;
     dataLength = len;
     return true;
 }
 
 // Generate XGIP Packet for output
 uint8_t * XGIPProtocol::generatePacket() {
+    return generatePacket(packet);
+}
+
+// Generate XGIP Packet straight into the caller's buffer (at least 64 bytes)
+uint8_t * XGIPProtocol::generatePacket(uint8_t * buffer) {
     if ( header.chunked == 0 ) { // Simple data packet does not require chunk logic
         header.length = (uint8_t)dataLength;
-        memcpy(packet, &header, sizeof(GipHeader_t));
-        memcpy((void*)&packet[4], data, dataLength);
+        memcpy(buffer, &header, sizeof(GipHeader_t));
+        if ( dataLength > 0 ) {
+            memcpy((void*)&buffer[4], data, dataLength);
+        }
         packetLength = sizeof(GipHeader_t) + dataLength;
     } else { // Are we a chunk?
         if ( numberOfChunksSent > 0 && totalDataSent == dataLength ) { // General Final Chunk Packet (End-Packet)
             header.needsAck = 0;
             header.length = 0;
-            memcpy(packet, &header, sizeof(GipHeader_t));
-            packet[4] = totalChunkLength & 0x00FF;
-            packet[5] = (totalChunkLength & 0xFF00) >> 8;
+            memcpy(buffer, &header, sizeof(GipHeader_t));
+            buffer[4] = totalChunkLength & 0x00FF;
+            buffer[5] = (totalChunkLength & 0xFF00) >> 8;
             packetLength = sizeof(GipHeader_t) + 2;
             chunkEnded = true;
         } else {
@@ -253,8 +280,8 @@ uint8_t * XGIPProtocol::generatePacket() {
             }
 
             // Copy our header and data to the packet
-            memcpy(packet, &header, sizeof(GipHeader_t));
-            memcpy((void*)&packet[6], &data[totalDataSent], dataToSend);
+            memcpy(buffer, &header, sizeof(GipHeader_t));
+            memcpy((void*)&buffer[6], &data[totalDataSent], dataToSend);
 
             // Set our packet length
             packetLength = sizeof(GipHeader_t) + 2 + dataToSend;
@@ -270,12 +297,12 @@ uint8_t * XGIPProtocol::generatePacket() {
 
             // Place value in right-byte if our chunk value is < 0x100
             if ( chunkValue < 0x100 ) {
-                packet[4] = 0x00;
-                packet[5] = (uint8_t) chunkValue;
+                buffer[4] = 0x00;
+                buffer[5] = (uint8_t) chunkValue;
             // Split appropriately
             } else {
-                packet[4] = chunkValue & 0x00FF;
-                packet[5] = (chunkValue & 0xFF00) >> 8;
+                buffer[4] = chunkValue & 0x00FF;
+                buffer[5] = (chunkValue & 0xFF00) >> 8;
             }
 
             // XGIP Hashing: If we're sending over 0x80, + ( data to send + 0x100 )
@@ -292,34 +319,38 @@ uint8_t * XGIPProtocol::generatePacket() {
             numberOfChunksSent++;        // Number of Chunks sent so far
         }
     }
-    return packet;
+    return buffer;
 }
 
 uint8_t * XGIPProtocol::generateAckPacket() { // Generate output packet
-    packet[0] = 0x01;
-    packet[1] = 0x20;
-    packet[2] = header.sequence;
-    packet[3] = 0x09;
-    packet[4] = 0x00;
-    packet[5] = header.command;
-    packet[6] = 0x20;
+    return generateAckPacket(packet);
+}
+
+uint8_t * XGIPProtocol::generateAckPacket(uint8_t * buffer) { // Generate output packet into the caller's buffer
+    buffer[0] = 0x01;
+    buffer[1] = 0x20;
+    buffer[2] = header.sequence;
+    buffer[3] = 0x09;
+    buffer[4] = 0x00;
+    buffer[5] = header.command;
+    buffer[6] = 0x20;
 
     // we have to keep track of # of chunks because data received for ACK is +2 for size of chunk
     uint16_t dataReceived = actualDataReceived;
-    packet[7] = dataReceived & 0x00FF;
-    packet[8] = (dataReceived & 0xFF00) >> 8;
-    packet[9] = 0x00;
-    packet[10] = 0x00;
+    buffer[7] = dataReceived & 0x00FF;
+    buffer[8] = (dataReceived & 0xFF00) >> 8;
+    buffer[9] = 0x00;
+    buffer[10] = 0x00;
     if ( header.chunked == true ) { // Are we a chunk?
         uint16_t left = dataLength - dataReceived;
-        packet[11] = left & 0x00FF;
-        packet[12] = (left & 0xFF00) >> 8;
+        buffer[11] = left & 0x00FF;
+        buffer[12] = (left & 0xFF00) >> 8;
     } else {
-        packet[11] = 0;
-        packet[12] = 0;
+        buffer[11] = 0;
+        buffer[12] = 0;
     }
     packetLength = 13;
-    return packet;
+    return buffer;
 }
 
 // Get last generated output packet length
@@ -348,7 +379,7 @@ uint8_t XGIPProtocol::getSequence() {
 }
 
 // Get data from a packet or packet-chunk
-uint8_t * XGIPProtocol::getData() {
+const uint8_t * XGIPProtocol::getData() {
     return data;
 }
 
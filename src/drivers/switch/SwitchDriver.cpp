@@ -2,6 +2,8 @@
 #include "drivers/shared/driverhelper.h"
 
 void SwitchDriver::initialize() {
+	reportLatchEnabled = true;
+
 	switchReport = {
 		.buttons = 0,
 		.hat = SWITCH_HAT_NOTHING,
@@ -71,6 +73,7 @@ void SwitchDriver::process(Gamepad * gamepad) {
 		// HID ready + report sent, copy previous report
 		if (tud_hid_ready() && tud_hid_report(0, report, report_size) == true ) {
 			memcpy(last_report, report, report_size);
+			reportSent();
 		}
 	}
 }
@@ -18,25 +18,49 @@ static uint8_t xb1_rumble_on[] = {0x00, 0x0f, 0x00, 0x00, 0x00, 0x00, 0xff, 0x00
 static uint8_t xb1_led_on[] = {0x00, 0x01, 0x14}; // 0x01 - LED on, 0x14 - Brightness
 
 // Report Queue for big report sizes from dongle
-#include <queue>
+//  Fixed size ring drained by process(). Reports are spaced REPORT_QUEUE_INTERVAL apart,
+//  measured from the completion of the last OUT transfer, so nothing ever sleeps here.
+//  Nothing is queued without room for it: console chunks leave REPORT_QUEUE_RECEIVE_MAX
+//  free for the dongle, and a dongle packet is only parsed when all it can queue fits.
+#define REPORT_QUEUE_SIZE 16
+#define REPORT_QUEUE_INTERVAL 15
+
+// Most reports one dongle packet queues: its ack and the four power-on reports
+#define REPORT_QUEUE_RECEIVE_MAX 5
+
+// The dongle's first packet after power up is invalid, give it this long to boot
+#define DONGLE_BOOT_WAIT 50
+
 typedef struct {
 	uint8_t report[XBONE_ENDPOINT_SIZE];
 	uint16_t len;
 } report_queue_t;
 
-static std::queue<report_queue_t> report_queue;
-static uint32_t lastReportQueue = 0;
-#define REPORT_QUEUE_INTERVAL 15
+static report_queue_t report_queue[REPORT_QUEUE_SIZE];
+static uint8_t report_queue_head = 0;
+static uint8_t report_queue_count = 0;
+static bool report_in_flight = false;
+static absolute_time_t next_report_time = nil_time;  // earliest time the next queued report may go out
+
+// Dongle auth chunks are reassembled here and only copied into dongleBuffer once complete
+static uint8_t dongleChunkBuffer[GIP_MAX_DATA_SIZE];
+
+// Console auth message being forwarded to the dongle. consoleBuffer belongs to core0, which
+//  rewrites it from its USB callback, so the message is copied out when it is handed over
+//  instead of being chunked from consoleBuffer across several process() passes.
+static uint8_t consoleForwardBuffer[GIP_MAX_DATA_SIZE];
 
 void XBOneAuthUSBListener::setup() {
     xboxOneAuthData = nullptr;
     xbone_dev_addr = 0;
     xbone_instance = 0;
+    mounted = false;
 }
 
 void XBOneAuthUSBListener::setAuthData(XboxOneAuthData * authData ) {
     xboxOneAuthData = authData;
     xboxOneAuthData->dongle_ready = false;
+    incomingXGIP.setReassemblyBuffer(dongleChunkBuffer, sizeof(dongleChunkBuffer));
 }
 
 void XBOneAuthUSBListener::process() {
@@ -51,13 +75,16 @@ void XBOneAuthUSBListener::process() {
         outgoingXGIP.reset();
         outgoingXGIP.setAttributes(xboxOneAuthData->consoleBuffer.type,
             xboxOneAuthData->consoleBuffer.sequence, 1, isChunked, needsAck);
-        outgoingXGIP.setData(xboxOneAuthData->consoleBuffer.data, xboxOneAuthData->consoleBuffer.length);
+        memcpy(consoleForwardBuffer, xboxOneAuthData->consoleBuffer.data, xboxOneAuthData->consoleBuffer.length);
+        outgoingXGIP.setData(consoleForwardBuffer, xboxOneAuthData->consoleBuffer.length);
         xboxOneAuthData->consoleBuffer.reset();
         xboxOneAuthData->xboneState = GPAuthState::wait_auth_console_to_dongle;
     }
 
     // Process waiting (always on first frame)
-    if ( xboxOneAuthData->xboneState == GPAuthState::wait_auth_console_to_dongle) {
+    //  Generating a chunk advances the XGIP state, so only do it when it can be queued
+    if ( xboxOneAuthData->xboneState == GPAuthState::wait_auth_console_to_dongle &&
+            report_queue_count < REPORT_QUEUE_SIZE - REPORT_QUEUE_RECEIVE_MAX ) {
         queue_host_report(outgoingXGIP.generatePacket(), outgoingXGIP.getPacketLength());
         if ( outgoingXGIP.getChunked() == false || outgoingXGIP.endOfChunk() == true) {
             xboxOneAuthData->xboneState = GPAuthState::auth_idle_state;
@@ -75,6 +102,9 @@ void XBOneAuthUSBListener::xmount(uint8_t dev_addr, uint8_t instance, uint8_t co
         xbone_instance = instance;
         incomingXGIP.reset();
         outgoingXGIP.reset();
+        report_queue_head = report_queue_count = 0;
+        report_in_flight = false;
+        next_report_time = nil_time;
         mounted = true;
     }
 }
@@ -83,7 +113,8 @@ void XBOneAuthUSBListener::unmount(uint8_t dev_addr) {
     if ( dev_addr == xbone_dev_addr ) {
         // Do not reset dongle_ready on unmount (Magic-X will remount but still be ready)
         mounted = false;
-        while (!report_queue.empty()) report_queue.pop();
+        report_queue_head = report_queue_count = 0;
+        report_in_flight = false;
         incomingXGIP.reset();
         outgoingXGIP.reset();
         xboxOneAuthData->dongle_ready = false; // not ready for auth if we unmounted
@@ -95,9 +126,16 @@ void XBOneAuthUSBListener::report_received(uint8_t dev_addr, uint8_t instance, u
         return;
     }
 
+    // Parsing advances the XGIP state, drop the packet before that if its replies may not fit.
+    //  Without our ack the dongle sends it again.
+    if ( report_queue_count > REPORT_QUEUE_SIZE - REPORT_QUEUE_RECEIVE_MAX ) {
+        return;
+    }
+
     incomingXGIP.parse(report, len);
     if ( incomingXGIP.validate() == false ) {
-        sleep_ms(50); // First packet is invalid, drop and wait for dongle to boot
+        // First packet is invalid, drop it and hold our reports until the dongle has booted
+        next_report_time = make_timeout_time_ms(DONGLE_BOOT_WAIT);
         incomingXGIP.reset();
         return;
     }
@@ -155,21 +193,36 @@ void XBOneAuthUSBListener::report_received(uint8_t dev_addr, uint8_t instance, u
     };
 }
 
+void XBOneAuthUSBListener::report_sent(uint8_t dev_addr, uint8_t instance, uint8_t const* report, uint16_t len) {
+    if ( dev_addr != xbone_dev_addr || instance != xbone_instance ) {
+        return;
+    }
+    report_in_flight = false;
+    absolute_time_t paced = make_timeout_time_ms(REPORT_QUEUE_INTERVAL);
+    if ( absolute_time_diff_us(next_report_time, paced) > 0 ) { // keep a longer dongle boot wait
+        next_report_time = paced;
+    }
+}
+
 void XBOneAuthUSBListener::queue_host_report(void* report, uint16_t len) {
-    report_queue_t new_queue;
-    memcpy(new_queue.report, report, len);
-    new_queue.len = len;
-    report_queue.push(new_queue);
+    if ( report_queue_count == REPORT_QUEUE_SIZE ) {
+        return;
+    }
+    report_queue_t * item = &report_queue[(report_queue_head + report_queue_count) % REPORT_QUEUE_SIZE];
+    memcpy(item->report, report, len);
+    item->len = len;
+    report_queue_count++;
 }
 
+// A busy endpoint leaves the report queued for the next pass instead of stalling Core1
 void XBOneAuthUSBListener::process_report_queue() {
-    uint32_t now = to_ms_since_boot(get_absolute_time());
-    if ( mounted == true && !report_queue.empty() && (now - lastReportQueue) > REPORT_QUEUE_INTERVAL  ) {
-        if ( tuh_xinput_send_report(xbone_dev_addr, xbone_instance, report_queue.front().report, report_queue.front().len) ) {
-			report_queue.pop();
-            lastReportQueue = now; // last time we checked report queue
-        } else {
-            sleep_ms(REPORT_QUEUE_INTERVAL);
-        }
-	}
+    if ( mounted == false || report_queue_count == 0 || report_in_flight || !time_reached(next_report_time) ) {
+        return;
+    }
+    report_queue_t * item = &report_queue[report_queue_head];
+    if ( tuh_xinput_send_report(xbone_dev_addr, xbone_instance, item->report, item->len) ) {
+        report_queue_head = (report_queue_head + 1) % REPORT_QUEUE_SIZE;
+        report_queue_count--;
+        report_in_flight = true;
+    }
 }
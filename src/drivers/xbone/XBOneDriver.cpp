@@ -22,7 +22,10 @@
 #define DESC_EXTENDED_PROPERTIES_DESCRIPTOR 0x0005
 #define REQ_GET_XGIP_HEADER 0x90
 
-// Check report queue every 35 milliseconds
+// Space control packets 35 milliseconds apart, measured from the completion of the last one.
+//  The driver always left this gap between announce, descriptor and auth chunks, marked as
+//  required for PC/console timing. It only holds back the control lane, acks and input have
+//  their own lanes.
 static uint32_t lastReportQueue = 0;
 #define REPORT_QUEUE_INTERVAL 35
 
@@ -36,6 +39,13 @@ typedef enum {
 
 static XboxOneDriverState xboneDriverState;
 
+// Console auth chunks are reassembled here and only copied into consoleBuffer once complete
+static uint8_t consoleChunkBuffer[GIP_MAX_DATA_SIZE];
+
+// Dongle auth message being forwarded to the console. dongleBuffer is rewritten by core1
+//  whenever the dongle completes a message, so it is copied out at handoff and chunked from here.
+static uint8_t dongleForwardBuffer[GIP_MAX_DATA_SIZE];
+
 static uint8_t xb1_guide_on[] = { 0x01, 0x5b };
 static uint8_t xb1_guide_off[] = { 0x00, 0x5b };
 
@@ -92,13 +102,34 @@ static uint8_t report_led_mode;
 static uint8_t report_led_brightness;
 
 // Report Queue for big report sizes from dongle
-#include <queue>
+//  Fixed size rings, one per lane. Acks are answers the console is waiting on so they
+//  leave as soon as the IN endpoint completes, announce/descriptor/auth chunks are paced.
+//  Input has a single slot lane after them: only the newest report matters, and it goes
+//  out on the next IN completion unless a control packet is due, so neither starves.
+#define REPORT_QUEUE_SIZE 8
+
 typedef struct {
     uint8_t report[XBONE_ENDPOINT_SIZE];
     uint16_t len;
 } report_queue_t;
 
-static std::queue<report_queue_t> report_queue;
+typedef struct {
+    report_queue_t items[REPORT_QUEUE_SIZE];
+    uint8_t head;
+    uint8_t count;
+} report_lane_t;
+
+typedef enum {
+    REPORT_LANE_ACK,
+    REPORT_LANE_CONTROL,
+    REPORT_LANE_COUNT,
+    REPORT_LANE_NONE = REPORT_LANE_COUNT // IN transfer that didn't come from a ring (input, keep-alive)
+} report_lane_id_t;
+
+static report_lane_t report_lanes[REPORT_LANE_COUNT];
+static report_lane_id_t in_flight_lane = REPORT_LANE_NONE;
+static report_queue_t input_lane;
+static bool input_lane_pending = false;
 
 #define XGIP_ACK_WAIT_TIMEOUT 2000
 
@@ -116,8 +147,8 @@ typedef struct {
 
 CFG_TUSB_MEM_SECTION static xboned_interface_t _xboned_itf[CFG_TUD_XBONE];
 
-static XGIPProtocol * outgoingXGIP = nullptr;
-static XGIPProtocol * incomingXGIP = nullptr;
+static XGIPProtocol outgoingXGIP;
+static XGIPProtocol incomingXGIP;
 static XboxOneAuthData * xboxOneAuthData = nullptr;
 
 // Windows requires a Descriptor Single for Xbox One
@@ -151,8 +182,9 @@ static void xbone_reset(uint8_t rhport) {
     timer_wait_for_announce = to_ms_since_boot(get_absolute_time());
     xbox_one_powered_on = false;
     report_led_mode = 0; // 0 = OFF
-    while(!report_queue.empty())
-        report_queue.pop();
+    memset(report_lanes, 0, sizeof(report_lanes));
+    in_flight_lane = REPORT_LANE_NONE;
+    input_lane_pending = false;
 
     // close any endpoints that are open
     tu_memclr(&_xboned_itf, sizeof(_xboned_itf));
@@ -200,22 +232,99 @@ static uint16_t xbone_open(uint8_t rhport, tusb_desc_interface_t const *itf_desc
             }
 
             // Setting up XGIPs and driver state
-            if (incomingXGIP != nullptr && outgoingXGIP != nullptr ) {
-                xboneDriverState = XboxOneDriverState::READY_ANNOUNCE;
-                incomingXGIP->reset();
-                outgoingXGIP->reset();
-            }
+            xboneDriverState = XboxOneDriverState::READY_ANNOUNCE;
+            incomingXGIP.reset();
+            outgoingXGIP.reset();
         }
     }
 
     return drv_len;
 }
 
-static void queue_xbone_report(void *report, uint16_t report_size) {
-    report_queue_t item;
-    memcpy(item.report, report, report_size);
-    item.len = report_size;
-    report_queue.push(item);
+static bool report_lane_full(report_lane_id_t lane) {
+    return report_lanes[lane].count == REPORT_QUEUE_SIZE;
+}
+
+// XGIP packets are generated straight into the queue slot
+static bool queue_xbone_packet(report_lane_id_t lane, XGIPProtocol & xgip, bool ack) {
+    report_lane_t * ring = &report_lanes[lane];
+    if ( ring->count == REPORT_QUEUE_SIZE ) {
+        return false;
+    }
+    report_queue_t * item = &ring->items[(ring->head + ring->count) % REPORT_QUEUE_SIZE];
+    if ( ack == true ) {
+        xgip.generateAckPacket(item->report);
+    } else {
+        xgip.generatePacket(item->report);
+    }
+    item->len = xgip.getPacketLength();
+    ring->count++;
+    return true;
+}
+
+static xboned_interface_t * xbone_get_in_interface() {
+    for (uint8_t itf = 0; itf < TU_ARRAY_SIZE(_xboned_itf); itf++) {
+        if (_xboned_itf[itf].ep_in)
+            return &_xboned_itf[itf];
+    }
+    return nullptr;
+}
+
+// The IN endpoint is our only credit: a new transfer is started only after the last one completed
+static bool xbone_send_report(uint8_t const *report, uint16_t report_size, report_lane_id_t lane) {
+    xboned_interface_t *p_xbone = xbone_get_in_interface();
+    if ( p_xbone == nullptr || report_size > sizeof(p_xbone->epin_buf) ) {
+        return false;
+    }
+    if ( tud_ready() &&											// Is the device ready?
+        (!usbd_edpt_busy(TUD_OPT_RHPORT, p_xbone->ep_in))) // Is the IN endpoint available?
+    {
+        usbd_edpt_claim(0, p_xbone->ep_in);										// Take control of IN endpoint
+        memcpy(p_xbone->epin_buf, report, report_size);                         // Keep our copy until the transfer completes
+        usbd_edpt_xfer(0, p_xbone->ep_in, p_xbone->epin_buf, report_size); 	// Send report buffer
+        usbd_edpt_release(0, p_xbone->ep_in);										// Release control of IN endpoint
+        in_flight_lane = lane;
+
+        // we successfully sent the report
+        return true;
+    }
+    return false;
+}
+
+// Send the oldest report of a lane, it stays queued if the endpoint is still busy
+static bool send_report_lane(report_lane_id_t lane) {
+    report_lane_t * ring = &report_lanes[lane];
+    if ( ring->count == 0 ) {
+        return false;
+    }
+    report_queue_t * item = &ring->items[ring->head];
+    if ( xbone_send_report(item->report, item->len, lane) == false ) {
+        return false;
+    }
+    ring->head = (ring->head + 1) % REPORT_QUEUE_SIZE;
+    ring->count--;
+    return true;
+}
+
+static bool control_lane_due(uint32_t now) {
+    return report_lanes[REPORT_LANE_CONTROL].count > 0 && (now - lastReportQueue) > REPORT_QUEUE_INTERVAL;
+}
+
+static bool send_input_lane() {
+    if ( input_lane_pending == false ||
+            xbone_send_report(input_lane.report, input_lane.len, REPORT_LANE_NONE) == false ) {
+        return false;
+    }
+    input_lane_pending = false;
+    return true;
+}
+
+// Replaces an input report that has not gone out yet, then sends it if the endpoint is free
+static void queue_input_report(uint8_t const *report, uint16_t report_size) {
+    memcpy(input_lane.report, report, report_size);
+    input_lane.len = report_size;
+    input_lane_pending = true;
+    send_input_lane();
 }
 
 // DevCompatIDsOne sends back XGIP10 data when requested by Windows
@@ -243,8 +352,7 @@ bool xbone_vendor_control_xfer_cb(uint8_t rhport, uint8_t stage,
 bool xbone_xfer_cb(uint8_t rhport, uint8_t ep_addr, xfer_result_t result,
                      uint32_t xferred_bytes) {
     // Do nothing if we couldn't setup our auth listener
-    if ( xboxOneAuthData == nullptr || incomingXGIP == nullptr ||
-            outgoingXGIP == nullptr) {
+    if ( xboxOneAuthData == nullptr ) {
         return true;
     }
     
@@ -259,49 +367,60 @@ bool xbone_xfer_cb(uint8_t rhport, uint8_t ep_addr, xfer_result_t result,
 
     if (ep_addr == p_xbone->ep_out) {
         // Parse incoming packet and verify its valid
-        incomingXGIP->parse(p_xbone->epout_buf, xferred_bytes);
+        incomingXGIP.parse(p_xbone->epout_buf, xferred_bytes);
 
         // Setup an ack before we change anything about the incoming packet
-        if ( incomingXGIP->ackRequired() == true ) {
-            queue_xbone_report((uint8_t*)incomingXGIP->generateAckPacket(), incomingXGIP->getPacketLength());
+        if ( incomingXGIP.ackRequired() == true ) {
+            queue_xbone_packet(REPORT_LANE_ACK, incomingXGIP, true);
+            send_report_lane(REPORT_LANE_ACK);
         }
 
-        uint8_t command = incomingXGIP->getCommand();
+        uint8_t command = incomingXGIP.getCommand();
         if ( command == GIP_ACK_RESPONSE ) {
             waiting_ack = false;
         } else if ( command == GIP_DEVICE_DESCRIPTOR ) {
             // setup descriptor packet
-            outgoingXGIP->reset(); // reset if anything was in there
-            outgoingXGIP->setAttributes(GIP_DEVICE_DESCRIPTOR, incomingXGIP->getSequence(), 1, 1, 0);
-            outgoingXGIP->setData(xboxOneDescriptor, sizeof(xboxOneDescriptor));
+            outgoingXGIP.reset(); // reset if anything was in there
+            outgoingXGIP.setAttributes(GIP_DEVICE_DESCRIPTOR, incomingXGIP.getSequence(), 1, 1, 0);
+            outgoingXGIP.setData(xboxOneDescriptor, sizeof(xboxOneDescriptor));
             xboneDriverState = XboxOneDriverState::SEND_DESCRIPTOR;
         } else if ( command == GIP_POWER_MODE_DEVICE_CONFIG ) {
             // Power Mode On!
             xbox_one_powered_on = true;
         } else if ( command == GIP_CMD_LED_ON ) {
             // Set all player LEDs to on
-            report_led_mode = incomingXGIP->getData()[1]; // 1 - turn LEDs on
-            report_led_brightness = incomingXGIP->getData()[2]; // 2 - brightness (ignored for now)
+            report_led_mode = incomingXGIP.getData()[1]; // 1 - turn LEDs on
+            report_led_brightness = incomingXGIP.getData()[2]; // 2 - brightness (ignored for now)
         } else if ( command == GIP_CMD_RUMBLE ) {
             // TO-DO
         } else if ( command == GIP_AUTH || command == GIP_FINAL_AUTH) {
-            if (incomingXGIP->getDataLength() == 2 && memcmp(incomingXGIP->getData(), authReady, sizeof(authReady))==0 ) {
+            if (incomingXGIP.getDataLength() == 2 && memcmp(incomingXGIP.getData(), authReady, sizeof(authReady))==0 ) {
                 xboxOneAuthData->authCompleted = true;
                 xboneDriverState = AUTH_DONE;
             }
-            if ( (incomingXGIP->getChunked() == true && incomingXGIP->endOfChunk() == true) ||
-                    (incomingXGIP->getChunked() == false )) {
-                xboxOneAuthData->consoleBuffer.setBuffer(incomingXGIP->getData(), incomingXGIP->getDataLength(),
-                    incomingXGIP->getSequence(), incomingXGIP->getCommand());
+            if ( (incomingXGIP.getChunked() == true && incomingXGIP.endOfChunk() == true) ||
+                    (incomingXGIP.getChunked() == false )) {
+                xboxOneAuthData->consoleBuffer.setBuffer(incomingXGIP.getData(), incomingXGIP.getDataLength(),
+                    incomingXGIP.getSequence(), incomingXGIP.getCommand());
                 xboxOneAuthData->xboneState = GPAuthState::send_auth_console_to_dongle;
-                incomingXGIP->reset();
+                incomingXGIP.reset();
             }
         }
 
         TU_ASSERT(usbd_edpt_xfer(rhport, p_xbone->ep_out, p_xbone->epout_buf,
                                  sizeof(p_xbone->epout_buf)));
     } else if (ep_addr == p_xbone->ep_in) {
-        // Nothing needed
+        // Control packets are paced from the moment the console actually took them
+        if ( in_flight_lane == REPORT_LANE_CONTROL ) {
+            lastReportQueue = to_ms_since_boot(get_absolute_time());
+        }
+        in_flight_lane = REPORT_LANE_NONE;
+
+        // The next report goes out on the endpoint completion, not on the next driver pass
+        if ( send_report_lane(REPORT_LANE_ACK) == false &&
+                (control_lane_due(to_ms_since_boot(get_absolute_time())) == false || send_report_lane(REPORT_LANE_CONTROL) == false) ) {
+            send_input_lane();
+        }
     }
     return true;
 }
@@ -350,9 +469,6 @@ void XBOneDriver::initialize() {
     xb1_guide_pressed = false;
     last_report_counter = 0;
 
-    incomingXGIP = new XGIPProtocol();
-    outgoingXGIP = new XGIPProtocol();
-
     xboxOneAuthData = nullptr;
 
     xbone_led_mode = 0;
@@ -363,6 +479,7 @@ void XBOneDriver::initializeAux() {
     authDriver = new XBOneAuth();
     if ( authDriver->available() ) {
         authDriver->initialize();
+        incomingXGIP.setReassemblyBuffer(consoleChunkBuffer, sizeof(consoleChunkBuffer));
         xboxOneAuthData = ((XBOneAuth*)authDriver)->getAuthData();
     } else {
         xboxOneAuthData = nullptr;
@@ -494,23 +611,28 @@ void XBOneDriver::process(Gamepad * gamepad) {
         newInputReport.rightTrigger = gamepad->pressedR2() ? 0x03FF : 0;
     }
 
-    // We changed inputs since generating our last report, increment last report counter (but don't update until success)
+    // We changed inputs since generating our last report, queue it on the input lane
     if ( memcmp(&last_report[4], &((uint8_t*)&newInputReport)[4], sizeof(XboxOneGamepad_Data_t)-4) != 0 ) {
         xboneReportSize = sizeof(XboxOneGamepad_Data_t);
         memcpy(&xboneReport, &newInputReport, xboneReportSize);
-        xboneReport.Header.sequence = last_report_counter + 1;
-        if ( xboneReport.Header.sequence == 0 )
-            xboneReport.Header.sequence = 1;
 
-        // Successfully sent report, actually increment last report counter!
-        if ( send_xbone_usb((uint8_t*)&xboneReport, xboneReportSize) == true ) {
-            if ( memcmp(&last_report[4], &((uint8_t*)&xboneReport)[4], xboneReportSize-4) != 0) {
-                last_report_counter++;
-                if (last_report_counter == 0)
-                    last_report_counter = 1;
-                memcpy(last_report, &xboneReport, xboneReportSize);
-            }
+        // A report still waiting in the lane is replaced and keeps its sequence number
+        bool replacing = input_lane_pending;
+        if ( replacing == true ) {
+            xboneReport.Header.sequence = last_report_counter;
+        } else {
+            xboneReport.Header.sequence = last_report_counter + 1;
+            if ( xboneReport.Header.sequence == 0 )
+                xboneReport.Header.sequence = 1;
         }
+
+        queue_input_report((uint8_t*)&xboneReport, xboneReportSize);
+        if ( replacing == false ) {
+            last_report_counter++;
+            if (last_report_counter == 0)
+                last_report_counter = 1;
+        }
+        memcpy(last_report, &xboneReport, xboneReportSize);
     }
 }
 
@@ -528,26 +650,7 @@ bool XBOneDriver::getAuthSent() {
 }
 
 bool XBOneDriver::send_xbone_usb(uint8_t const *report, uint16_t report_size) {
-    uint8_t itf = 0;
-    xboned_interface_t *p_xbone = _xboned_itf;
-    for (;; itf++, p_xbone++) {
-        if (itf >= TU_ARRAY_SIZE(_xboned_itf)) {
-            return false;
-        }
-        if (p_xbone->ep_in)
-            break;
-    }
-    if ( tud_ready() &&											// Is the device ready?
-        (p_xbone->ep_in != 0) && (!usbd_edpt_busy(TUD_OPT_RHPORT, p_xbone->ep_in))) // Is the IN endpoint available?
-    {
-        usbd_edpt_claim(0, p_xbone->ep_in);										// Take control of IN endpoint
-        usbd_edpt_xfer(0, p_xbone->ep_in, (uint8_t *)report, report_size); 	// Send report buffer
-        usbd_edpt_release(0, p_xbone->ep_in);										// Release control of IN endpoint
-
-        // we successfully sent the report
-        return true;
-    }
-    return false;
+    return xbone_send_report(report, report_size, REPORT_LANE_NONE);
 }
 
 // tud_hid_get_report_cb
@@ -624,20 +727,24 @@ void XBOneDriver::update() {
     switch(xboneDriverState) {
         case READY_ANNOUNCE:
             // Xbox One announce must wait around 0.5s before sending
-            if ( now - timer_wait_for_announce > 500 ) {
+            if ( now - timer_wait_for_announce > 500 && !report_lane_full(REPORT_LANE_CONTROL) ) {
                 memcpy((void*)&announcePacket[3], &now, 3);
-                outgoingXGIP->setAttributes(GIP_ANNOUNCE, 1, 1, 0, 0);
-                outgoingXGIP->setData(announcePacket, sizeof(announcePacket));
-                queue_xbone_report(outgoingXGIP->generatePacket(), outgoingXGIP->getPacketLength());
+                outgoingXGIP.setAttributes(GIP_ANNOUNCE, 1, 1, 0, 0);
+                outgoingXGIP.setData(announcePacket, sizeof(announcePacket));
+                queue_xbone_packet(REPORT_LANE_CONTROL, outgoingXGIP, false);
                 xboneDriverState = WAIT_DESCRIPTOR_REQUEST;
             }
             break;
         case SEND_DESCRIPTOR:
-            queue_xbone_report(outgoingXGIP->generatePacket(), outgoingXGIP->getPacketLength());
-            if ( outgoingXGIP->endOfChunk() == true ) {
+            // Generating a chunk advances the XGIP state, so only do it when it can be queued
+            if ( report_lane_full(REPORT_LANE_CONTROL) ) {
+                break;
+            }
+            queue_xbone_packet(REPORT_LANE_CONTROL, outgoingXGIP, false);
+            if ( outgoingXGIP.endOfChunk() == true ) {
                 xboneDriverState = SETUP_AUTH;
             }
-            if ( outgoingXGIP->getPacketAck() == 1 ) { // ACK can happen at different chunks
+            if ( outgoingXGIP.getPacketAck() == 1 ) { // ACK can happen at different chunks
                 set_ack_wait();
             }
             break;
@@ -647,22 +754,23 @@ void XBOneDriver::update() {
                 uint16_t len = xboxOneAuthData->dongleBuffer.length;
                 uint8_t type = xboxOneAuthData->dongleBuffer.type;
                 uint8_t sequence = xboxOneAuthData->dongleBuffer.sequence;
-                uint8_t * buffer = xboxOneAuthData->dongleBuffer.data;
                 bool isChunked = (len > GIP_MAX_CHUNK_SIZE);
-                outgoingXGIP->reset();
-                outgoingXGIP->setAttributes(type, sequence, 1, isChunked, 1);
-                outgoingXGIP->setData(buffer, len);
+                memcpy(dongleForwardBuffer, xboxOneAuthData->dongleBuffer.data, len);
+                outgoingXGIP.reset();
+                outgoingXGIP.setAttributes(type, sequence, 1, isChunked, 1);
+                outgoingXGIP.setData(dongleForwardBuffer, len);
                 xboxOneAuthData->xboneState = wait_auth_dongle_to_console;
                 xboxOneAuthData->dongleBuffer.reset();
             }
             
             // Process auth dongle to console
-            if ( xboxOneAuthData->xboneState == GPAuthState::wait_auth_dongle_to_console ) {
-                queue_xbone_report(outgoingXGIP->generatePacket(), outgoingXGIP->getPacketLength());
-                if ( outgoingXGIP->getChunked() == false || outgoingXGIP->endOfChunk() == true ) {
+            if ( xboxOneAuthData->xboneState == GPAuthState::wait_auth_dongle_to_console &&
+                    !report_lane_full(REPORT_LANE_CONTROL) ) {
+                queue_xbone_packet(REPORT_LANE_CONTROL, outgoingXGIP, false);
+                if ( outgoingXGIP.getChunked() == false || outgoingXGIP.endOfChunk() == true ) {
                     xboxOneAuthData->xboneState = GPAuthState::auth_idle_state;
                 }
-                if ( outgoingXGIP->getPacketAck() == 1 ) { // ACK can happen at different chunks
+                if ( outgoingXGIP.getPacketAck() == 1 ) { // ACK can happen at different chunks
                     set_ack_wait();
                 }
             }
@@ -674,16 +782,24 @@ void XBOneDriver::update() {
 }
 
 void XBOneDriver::process_report_queue(uint32_t now) {
-    if ( !report_queue.empty() && (now - lastReportQueue) > REPORT_QUEUE_INTERVAL ) {
-        if ( send_xbone_usb(report_queue.front().report, report_queue.front().len) ) {
-            memcpy(last_report, &report_queue.front().report, report_queue.front().len);
-            report_queue.pop();
+    // Acks first, the console holds back its next packet until it sees them
+    if ( send_report_lane(REPORT_LANE_ACK) == true ) {
+        memcpy(last_report, xbone_get_in_interface()->epin_buf, sizeof(last_report));
+        return;
+    }
+
+    // THIS IS REQUIRED FOR TIMING ON PC / CONSOLE
+    //  A busy endpoint leaves the packet queued for the next pass instead of stalling the core
+    if ( control_lane_due(now) == true ) {
+        if ( send_report_lane(REPORT_LANE_CONTROL) == true ) {
+            memcpy(last_report, xbone_get_in_interface()->epin_buf, sizeof(last_report));
             lastReportQueue = now;
-        } else {
-            // THIS IS REQUIRED FOR TIMING ON PC / CONSOLE
-            sleep_ms(REPORT_QUEUE_INTERVAL); // sleep while we wait, never happens during input only auth
+            return;
         }
     }
+
+    // Then input, which never waits on the control gap
+    send_input_lane();
 }
 
 uint16_t XBOneDriver::GetJoystickMidValue() {
@@ -3,6 +3,8 @@
 #include "drivers/shared/driverhelper.h"
 
 void XboxOriginalDriver::initialize() {
+    reportLatchEnabled = true;
+
     xboxOriginalReport = {
         .dButtons = 0,
         .A = 0,
@@ -66,6 +68,7 @@ void XboxOriginalDriver::process(Gamepad * gamepad) {
 	if (memcmp(last_report, &xboxOriginalReport, sizeof(XboxOriginalReport)) != 0) {
         if ( xid_send_report(xIndex, &xboxOriginalReport, sizeof(XboxOriginalReport)) == true ) {
             memcpy(last_report, &xboxOriginalReport, sizeof(XboxOriginalReport));
+            reportSent();
         }
     }
 
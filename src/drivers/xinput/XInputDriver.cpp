@@ -124,6 +124,8 @@ static bool xinput_xfer_callback(uint8_t rhport, uint8_t ep_addr, xfer_result_t
 }
 
 void XInputDriver::initialize() {
+    reportLatchEnabled = true;
+
     xinputReport = {
         .report_id = 0,
         .report_size = XINPUT_ENDPOINT_SIZE,
@@ -226,6 +228,7 @@ void XInputDriver::process(Gamepad * gamepad) {
             usbd_edpt_xfer(0, endpoint_in, (uint8_t *)&xinputReport, sizeof(XInputReport)); // Send report buffer
             usbd_edpt_release(0, endpoint_in);								// Release control of IN endpoint
             memcpy(last_report, &xinputReport, sizeof(XInputReport)); // save if we sent it
+            reportSent();
         }
     }
 
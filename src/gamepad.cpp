@@ -260,7 +260,8 @@ void Gamepad::process()
 	}
 
 	// 4-way before SOCD, might have better history without losing any coherent functionality
-	if (options.fourWayMode ^ map48WayModeToggle) {
+	fourWayDpad = options.fourWayMode ^ map48WayModeToggle;
+	if (fourWayDpad) {
 		state.dpad = filterToFourWayMode(state.dpad);
 	}
 
@@ -44,125 +44,194 @@ uint8_t getMaskFromDirection(DpadDirection direction)
 	return dpadMasks[direction-1];
 }
 
-uint8_t updateDpad(uint8_t dpad, DpadDirection direction)
-{
-	static bool inList[] = {false, false, false, false, false}; // correspond to DpadDirection: none, up, down, left, right
-	static list<DpadDirection> dpadList;
+/*
+ * SOCD history keeps the last direction seen on each axis: bits 0-1 for
+ * up/down and bits 2-3 for left/right, each 0 = none, 1 = up/left and
+ * 2 = down/right. The dpad splits the same way, up/down in bits 0-1 and
+ * left/right in bits 2-3, so one axis can be resolved on its own.
+ */
+#define SOCD_AXIS_NONE 0
+#define SOCD_AXIS_NEG 1
+#define SOCD_AXIS_POS 2
+#define SOCD_AXIS_BOTH (SOCD_AXIS_NEG | SOCD_AXIS_POS)
 
-	if(dpad & getMaskFromDirection(direction))
-	{
-		if(!inList[direction])
-		{
-			dpadList.push_back(direction);
-			inList[direction] = true;
-		}
-	}
-	else
+#define SOCD_TABLE_MODES SOCD_MODE_BYPASS
+#define SOCD_TABLE_HISTORIES 16
+#define DPAD_VALUES 16
+
+// Resolve one axis, returns the new last direction in bits 2-3 and the output in bits 0-1
+static constexpr uint8_t resolveSOCDAxis(SOCDMode mode, SOCDRules rules, bool vertical, uint8_t last, uint8_t axis)
+{
+	switch (axis)
 	{
-		if(inList[direction])
-		{
-			dpadList.remove(direction);
-			inList[direction] = false;
-		}
-	}
+		case SOCD_AXIS_BOTH:
+			if (mode == SOCD_MODE_UP_PRIORITY && vertical)
+				return (SOCD_AXIS_NEG << 2) | SOCD_AXIS_NEG;
+			else if (mode == SOCD_MODE_SECOND_INPUT_PRIORITY && last != SOCD_AXIS_NONE)
+				return (last << 2) | ((last == SOCD_AXIS_NEG) ? SOCD_AXIS_POS : SOCD_AXIS_NEG);
+			else if (mode == SOCD_MODE_FIRST_INPUT_PRIORITY && last != SOCD_AXIS_NONE)
+				return (last << 2) | last;
+			else if (rules != SOCD_RULES_GAMEPAD && mode >= SOCD_MODE_SECOND_INPUT_PRIORITY && !vertical)
+				return (SOCD_AXIS_NONE << 2) | SOCD_AXIS_BOTH; // Dual Directional lets L+R through without history
+			else if (rules == SOCD_RULES_MIXED && mode >= SOCD_MODE_SECOND_INPUT_PRIORITY)
+				return (SOCD_AXIS_NONE << 2) | ((mode == SOCD_MODE_SECOND_INPUT_PRIORITY) ? SOCD_AXIS_NEG : SOCD_AXIS_POS);
+			else
+				return (SOCD_AXIS_NONE << 2) | SOCD_AXIS_NONE;
 
-	if(dpadList.empty()) {
-		return 0;
-	}
-	else {
-		return getMaskFromDirection(dpadList.back());
+		case SOCD_AXIS_NEG:
+		case SOCD_AXIS_POS:
+			return (axis << 2) | axis;
+
+		default:
+			return (SOCD_AXIS_NONE << 2) | SOCD_AXIS_NONE;
 	}
 }
 
-/**
- * @brief Filter diagonals out of the dpad, making the device work as a 4-way lever.
- *
- * The most recent cardinal direction wins.
- *
- * @param dpad The GameState.dpad value.
- * @return uint8_t The new dpad value.
- */
-uint8_t filterToFourWayMode(uint8_t dpad)
+// Returns the next history in the high nibble and the clean dpad in the low nibble
+static constexpr uint8_t resolveSOCD(SOCDMode mode, SOCDRules rules, uint8_t history, uint8_t dpad)
 {
-	updateDpad(dpad, DIRECTION_UP);
-	updateDpad(dpad, DIRECTION_DOWN);
-	updateDpad(dpad, DIRECTION_LEFT);
-	return updateDpad(dpad, DIRECTION_RIGHT);
+	// Dual Directional mixing in up priority and neutral ignores history and keeps only
+	// up when up and down meet
+	if (rules == SOCD_RULES_MIXED && mode < SOCD_MODE_SECOND_INPUT_PRIORITY) {
+		if ((dpad & (GAMEPAD_MASK_UP | GAMEPAD_MASK_DOWN)) == (GAMEPAD_MASK_UP | GAMEPAD_MASK_DOWN))
+			dpad = (mode == SOCD_MODE_UP_PRIORITY) ? GAMEPAD_MASK_UP : (dpad & (GAMEPAD_MASK_LEFT | GAMEPAD_MASK_RIGHT));
+		if ((dpad & (GAMEPAD_MASK_LEFT | GAMEPAD_MASK_RIGHT)) == (GAMEPAD_MASK_LEFT | GAMEPAD_MASK_RIGHT))
+			dpad &= ~(GAMEPAD_MASK_LEFT | GAMEPAD_MASK_RIGHT);
+		return (history << 4) | dpad;
+	}
+
+	uint8_t ud = resolveSOCDAxis(mode, rules, true, history & 0x03, dpad & 0x03);
+	uint8_t lr = resolveSOCDAxis(mode, rules, false, (history >> 2) & 0x03, (dpad >> 2) & 0x03);
+	uint8_t nextHistory = (ud >> 2) | ((lr >> 2) << 2);
+	uint8_t cleanDpad = (ud & 0x03) | ((lr & 0x03) << 2);
+	return (nextHistory << 4) | cleanDpad;
 }
 
-/**
- * @brief Run SOCD cleaning against a D-pad value.
- *
- * @param mode The SOCD cleaning mode.
- * @param dpad The GamepadState.dpad value.
- * @return uint8_t The clean D-pad value.
- */
-uint8_t runSOCDCleaner(SOCDMode mode, uint8_t dpad)
+struct SOCDTable
 {
-	if (mode == SOCD_MODE_BYPASS) {
-		return dpad;
+	uint8_t entries[SOCD_RULES_COUNT][SOCD_TABLE_MODES][SOCD_TABLE_HISTORIES][DPAD_VALUES] {};
+
+	constexpr SOCDTable()
+	{
+		for (uint8_t rules = 0; rules < SOCD_RULES_COUNT; rules++) {
+			for (uint8_t mode = 0; mode < SOCD_TABLE_MODES; mode++) {
+				for (uint8_t history = 0; history < SOCD_TABLE_HISTORIES; history++) {
+					for (uint8_t dpad = 0; dpad < DPAD_VALUES; dpad++) {
+						entries[rules][mode][history][dpad] = resolveSOCD((SOCDMode)mode, (SOCDRules)rules, history, dpad);
+					}
+				}
+			}
+		}
 	}
+};
 
-	static DpadDirection lastUD = DIRECTION_NONE;
-	static DpadDirection lastLR = DIRECTION_NONE;
-	uint8_t newDpad = 0;
+static constexpr SOCDTable socdTable;
 
-	switch (dpad & (GAMEPAD_MASK_UP | GAMEPAD_MASK_DOWN))
+/*
+ * 4-way history is the order the held directions were pressed in, most
+ * recent last. Directions pressed in the same frame are appended in
+ * up, down, left, right order. There are 65 such orders, and each one
+ * gets a state index the first time it is reached from the empty order.
+ */
+#define FOUR_WAY_STATES 65
+
+struct FourWayOrder
+{
+	uint8_t length = 0;
+	uint8_t directions[4] {}; // index into dpadMasks
+
+	constexpr bool operator==(const FourWayOrder & other) const
+	{
+		if (length != other.length)
+			return false;
+		for (uint8_t i = 0; i < length; i++) {
+			if (directions[i] != other.directions[i])
+				return false;
+		}
+		return true;
+	}
+
+	constexpr FourWayOrder next(uint8_t dpad) const
 	{
-		case (GAMEPAD_MASK_UP | GAMEPAD_MASK_DOWN):
-			if (mode == SOCD_MODE_UP_PRIORITY)
-			{
-				newDpad |= GAMEPAD_MASK_UP;
-				lastUD = DIRECTION_UP;
+		FourWayOrder order;
+		uint8_t held = 0;
+		for (uint8_t i = 0; i < length; i++) {
+			if (dpad & (1 << directions[i])) {
+				order.directions[order.length++] = directions[i];
+				held |= (1 << directions[i]);
 			}
-			else if (mode == SOCD_MODE_SECOND_INPUT_PRIORITY && lastUD != DIRECTION_NONE)
-				newDpad |= (lastUD == DIRECTION_UP) ? GAMEPAD_MASK_DOWN : GAMEPAD_MASK_UP;
-			else if (mode == SOCD_MODE_FIRST_INPUT_PRIORITY && lastUD != DIRECTION_NONE)
-				newDpad |= (lastUD == DIRECTION_UP) ? GAMEPAD_MASK_UP : GAMEPAD_MASK_DOWN;
-			else
-				lastUD = DIRECTION_NONE;
-			break;
+		}
+		for (uint8_t direction = 0; direction < 4; direction++) {
+			if ((dpad & (1 << direction)) && !(held & (1 << direction)))
+				order.directions[order.length++] = direction;
+		}
+		return order;
+	}
 
-		case GAMEPAD_MASK_UP:
-			newDpad |= GAMEPAD_MASK_UP;
-			lastUD = DIRECTION_UP;
-			break;
+	constexpr uint8_t output() const
+	{
+		return (length == 0) ? 0 : (1 << directions[length - 1]);
+	}
+};
 
-		case GAMEPAD_MASK_DOWN:
-			newDpad |= GAMEPAD_MASK_DOWN;
-			lastUD = DIRECTION_DOWN;
-			break;
+struct FourWayTable
+{
+	uint8_t next[FOUR_WAY_STATES][DPAD_VALUES] {};
+	uint8_t output[FOUR_WAY_STATES] {};
+	uint8_t states = 1;
 
-		default:
-			lastUD = DIRECTION_NONE;
-			break;
+	constexpr FourWayTable()
+	{
+		FourWayOrder orders[FOUR_WAY_STATES];
+		for (uint8_t state = 0; state < states; state++) {
+			output[state] = orders[state].output();
+			for (uint8_t dpad = 0; dpad < DPAD_VALUES; dpad++) {
+				FourWayOrder order = orders[state].next(dpad);
+				uint8_t index = 0;
+				while (index < states && !(orders[index] == order))
+					index++;
+				if (index == states && states < FOUR_WAY_STATES)
+					orders[states++] = order;
+				next[state][dpad] = index;
+			}
+		}
 	}
+};
 
-	switch (dpad & (GAMEPAD_MASK_LEFT | GAMEPAD_MASK_RIGHT))
-	{
-		case (GAMEPAD_MASK_LEFT | GAMEPAD_MASK_RIGHT):
-			if (mode == SOCD_MODE_SECOND_INPUT_PRIORITY && lastLR != DIRECTION_NONE)
-				newDpad |= (lastLR == DIRECTION_LEFT) ? GAMEPAD_MASK_RIGHT : GAMEPAD_MASK_LEFT;
-			else if (mode == SOCD_MODE_FIRST_INPUT_PRIORITY && lastLR != DIRECTION_NONE)
-				newDpad |= (lastLR == DIRECTION_LEFT) ? GAMEPAD_MASK_LEFT : GAMEPAD_MASK_RIGHT;
-			else
-				lastLR = DIRECTION_NONE;
-			break;
+static constexpr FourWayTable fourWayTable;
+static_assert(fourWayTable.states == FOUR_WAY_STATES, "every held-direction order needs a 4-way state");
 
-		case GAMEPAD_MASK_LEFT:
-			newDpad |= GAMEPAD_MASK_LEFT;
-			lastLR = DIRECTION_LEFT;
-			break;
+// History for the gamepad's own dpad
+static DpadHistory gamepadDpadHistory;
 
-		case GAMEPAD_MASK_RIGHT:
-			newDpad |= GAMEPAD_MASK_RIGHT;
-			lastLR = DIRECTION_RIGHT;
-			break;
+uint8_t filterToFourWayMode(uint8_t dpad)
+{
+	return filterToFourWayMode(dpad, gamepadDpadHistory);
+}
 
-		default:
-			lastLR = DIRECTION_NONE;
-			break;
+uint8_t filterToFourWayMode(uint8_t dpad, DpadHistory & history)
+{
+	history.fourWay = fourWayTable.next[history.fourWay][dpad & 0x0F];
+	return fourWayTable.output[history.fourWay];
+}
+
+uint8_t runSOCDCleaner(SOCDMode mode, uint8_t dpad)
+{
+	return runSOCDCleaner(mode, dpad, gamepadDpadHistory);
+}
+
+uint8_t runSOCDCleaner(SOCDMode mode, uint8_t dpad, DpadHistory & history, SOCDRules rules)
+{
+	if (mode == SOCD_MODE_BYPASS) {
+		return dpad;
+	}
+
+	// anything unknown cleans like neutral
+	if (mode > SOCD_MODE_BYPASS) {
+		mode = SOCD_MODE_NEUTRAL;
 	}
 
-	return newDpad;
+	uint8_t entry = socdTable.entries[rules][mode][history.socd][dpad & 0x0F];
+	history.socd = entry >> 4;
+	return entry & 0x0F;
 }
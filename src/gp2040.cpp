@@ -9,6 +9,7 @@
 #include "peripheralmanager.h"
 #include "storagemanager.h"
 #include "addonmanager.h"
+#include "taskmanager.h"
 #include "types.h"
 #include "usbhostmanager.h"
 
@@ -52,14 +53,16 @@ static absolute_time_t rebootDelayTimeout = nil_time;
 
 void GP2040::setup() {
 	Storage::getInstance().init();
+	System::markBootTimeline("storage");
 
 	PeripheralManager::getInstance().initI2C();
 	PeripheralManager::getInstance().initSPI();
 	PeripheralManager::getInstance().initUSB();
+	System::markBootTimeline("peripherals");
 
 	// Reduce CPU if USB host is enabled
 	if ( PeripheralManager::getInstance().isUSBEnabled(0) ) {
-		set_sys_clock_khz(120000, true); // Set Clock to 120MHz to avoid potential USB timing issues
+		set_sys_clock_khz(USB_HOST_SYS_CLOCK_KHZ, true); // PIO-USB needs a multiple of 12MHz
 	}
 
 	Gamepad * gamepad = new Gamepad();
@@ -90,19 +93,23 @@ void GP2040::setup() {
     bootActions.insert({GAMEPAD_MASK_R1, gamepadOptions.inputModeR1});
     bootActions.insert({GAMEPAD_MASK_R2, gamepadOptions.inputModeR2});
 
+	System::markBootTimeline("gamepad");
+
 	// Initialize our ADC (various add-ons)
 	adc_init();
 
 	// Setup Add-ons
+	//  Add-ons that scan a bus or calibrate an ADC at setup are deferred until the USB device
+	//  stack runs (setupDeferredAddons()). They do not take part in the boot action below.
 	addons.LoadUSBAddon(new KeyboardHostAddon(), CORE0_INPUT);
 	addons.LoadUSBAddon(new GamepadUSBHostAddon(), CORE0_INPUT);
 	addons.LoadAddon(new AnalogInput(), CORE0_INPUT);
 	addons.LoadAddon(new BootselButtonAddon(), CORE0_INPUT);
 	addons.LoadAddon(new DualDirectionalInput(), CORE0_INPUT);
 	addons.LoadAddon(new FocusModeAddon(), CORE0_INPUT);
-	addons.LoadAddon(new I2CAnalog1219Input(), CORE0_INPUT);
-	addons.LoadAddon(new SPIAnalog1256Input(), CORE0_INPUT);
-	addons.LoadAddon(new WiiExtensionInput(), CORE0_INPUT);
+	addons.DeferAddon(new I2CAnalog1219Input(), CORE0_INPUT);
+	addons.DeferAddon(new SPIAnalog1256Input(), CORE0_INPUT);
+	addons.DeferAddon(new WiiExtensionInput(), CORE0_INPUT);
 	addons.LoadAddon(new SNESpadInput(), CORE0_INPUT);
 	addons.LoadAddon(new PlayerNumAddon(), CORE0_USBREPORT);
 	addons.LoadAddon(new SliderSOCDInput(), CORE0_INPUT);
@@ -114,6 +121,7 @@ void GP2040::setup() {
 	addons.LoadAddon(new ReverseInput(), CORE0_INPUT);
 	addons.LoadAddon(new TurboInput(), CORE0_INPUT); // Turbo overrides button states and should be close to the end
 	addons.LoadAddon(new InputMacro(), CORE0_INPUT);
+	System::markBootTimeline("addons");
 
 	InputMode inputMode = gamepad->getOptions().inputMode;
 	const BootAction bootAction = getBootAction();
@@ -179,6 +187,7 @@ void GP2040::setup() {
 
 	// Setup USB Driver
 	DriverManager::getInstance().setup(inputMode);
+	System::markBootTimeline("driver");
 
 	// Save the changed input mode
 	if (inputMode != gamepad->getOptions().inputMode) {	
@@ -264,16 +273,32 @@ void GP2040::debounceGpioGetAll() {
 	}
 }
 
+void GP2040::startUSB() {
+	// Start the TinyUSB Device functionality
+	tud_init(TUD_OPT_RHPORT);
+	System::markBootTimeline("usb device");
+}
+
+void GP2040::serviceUSB() {
+	tud_task();
+}
+
+// Sets up the deferred add-ons one at a time, servicing USB in between so enumeration
+// carries on while they scan their buses
+void GP2040::setupDeferredAddons() {
+	while (addons.LoadDeferredAddon()) {
+		serviceUSB();
+	}
+	System::markBootTimeline("deferred addons");
+}
+
 void GP2040::run() {
 	GPDriver * inputDriver = DriverManager::getInstance().getDriver();
 	Gamepad * gamepad = Storage::getInstance().GetGamepad();
 	Gamepad * processedGamepad = Storage::getInstance().GetProcessedGamepad();
 	bool configMode = Storage::getInstance().GetConfigMode();
     GamepadState prevState;
-    
-    // Start the TinyUSB Device functionality
-    tud_init(TUD_OPT_RHPORT);
-    
+
 	while (1) { // LOOP
 		this->getReinitGamepad(gamepad);
 
@@ -297,8 +322,8 @@ void GP2040::run() {
 			continue;
 		}
 
-		// Process USB Host on Core0
-		USBHostManager::getInstance().process();
+		// Timed add-on work (extension polling etc.) that is due this pass
+		TaskManager::getInstance().process();
 
 		// Pre-Process add-ons for MPGS
 		addons.PreprocessAddons(ADDON_PROCESS::CORE0_INPUT);
@@ -313,11 +338,15 @@ void GP2040::run() {
 
 		checkProcessedState(processedGamepad->state, gamepad->state);
 
+		// Core1 idles until its next deadline, so wake it when there's new input to show
+		if (memcmp(&processedGamepad->state, &gamepad->state, sizeof(GamepadState)) != 0)
+			System::wakeCore1();
+
 		// Copy Processed Gamepad for Core1 (race condition otherwise)
 		memcpy(&processedGamepad->state, &gamepad->state, sizeof(GamepadState));
 
 		// Process Input Driver
-		inputDriver->process(gamepad);
+		inputDriver->processLatched(gamepad);
 		
 		// Process USB Report Addons
 		addons.ProcessAddons(ADDON_PROCESS::CORE0_USBREPORT);
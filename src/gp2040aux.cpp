@@ -5,6 +5,8 @@
 #include "drivermanager.h"
 #include "storagemanager.h"
 #include "usbhostmanager.h"
+#include "system.h"
+#include "taskmanager.h"
 
 #include "addons/board_led.h"  // Add-Ons
 #include "addons/buzzerspeaker.h"
@@ -16,7 +18,7 @@
 
 #include <iterator>
 
-GP2040Aux::GP2040Aux() : isReady(false), inputDriver(nullptr) {
+GP2040Aux::GP2040Aux() : isReady(false), isAuthReady(false), inputDriver(nullptr) {
 }
 
 GP2040Aux::~GP2040Aux() {
@@ -28,6 +30,7 @@ void GP2040Aux::setup() {
 	PeripheralManager::getInstance().initI2C();
 	PeripheralManager::getInstance().initSPI();
 	PeripheralManager::getInstance().initUSB();
+	System::markBootTimeline("peripherals");
 
 	// Initialize our input driver's auxilliary functions
 	inputDriver = DriverManager::getInstance().getDriver();
@@ -49,21 +52,62 @@ void GP2040Aux::setup() {
 	addons.LoadAddon(new BuzzerSpeakerAddon(), CORE1_LOOP);
 	addons.LoadAddon(new DRV8833RumbleAddon(), CORE1_LOOP);
 	addons.LoadAddon(new ReactiveLEDAddon(), CORE1_LOOP);
+	System::markBootTimeline("addons");
+
+	// Core0 holds off the USB device stack and its input loop until here: the driver's
+	// auth callbacks use what initializeAux() set up, and the add-ons above registered
+	// their event handlers, which Core0's events call into
+	isAuthReady = true;
 
 	// Initialize our USB manager
 	USBHostManager::getInstance().start();
+	System::markBootTimeline("usb host");
 
 	// Ready to sync Core0 and Core1
 	isReady = true;
 }
 
 void GP2040Aux::run() {
+	// The USB host stack lives on Core1 (PIO-USB frames run from this core's alarm IRQ),
+	// so Core0 only picks up decoded host state from the listener mailboxes
+	bool hostEnabled = !Storage::getInstance().GetConfigMode();
+	USBHostManager& usbHost = USBHostManager::getInstance();
+
 	while (1) {
+		if ( hostEnabled )
+			usbHost.process();
+
+		TaskManager::getInstance().process();
 		addons.ProcessAddons(CORE1_LOOP);
 
+		if ( hostEnabled )
+			usbHost.process();
+
 		// Run auxiliary functions for input driver on Core1
 		if ( inputDriver != nullptr ) {
 			inputDriver->processAux();
 		}
+
+		idle();
 	}
 }
+
+// Sleep in WFE until the earliest add-on deadline, a wake from Core0 or any Core1
+// interrupt (PIO-USB frames keep the host stack serviced every millisecond)
+void GP2040Aux::idle() {
+	if ( CORE1_IDLE_MAX_MS == 0 || Storage::getInstance().GetConfigMode() )
+		return;
+	if ( inputDriver != nullptr && inputDriver->hasAuxWork() )
+		return;
+
+	absolute_time_t deadline = addons.NextDeadline(CORE1_LOOP);
+	absolute_time_t taskDeadline = TaskManager::getInstance().nextDeadline();
+	if ( absolute_time_diff_us(taskDeadline, deadline) > 0 )
+		deadline = taskDeadline;
+	absolute_time_t maxIdle = make_timeout_time_ms(CORE1_IDLE_MAX_MS);
+	if ( absolute_time_diff_us(maxIdle, deadline) > 0 )
+		deadline = maxIdle;
+
+	if ( !time_reached(deadline) )
+		best_effort_wfe_or_timeout(deadline);
+}
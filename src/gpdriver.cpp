@@ -0,0 +1,85 @@
+#include "gpdriver.h"
+#include "system.h"
+
+void GPDriver::processLatched(Gamepad * gamepad) {
+    if (!reportLatchEnabled) {
+        process(gamepad);
+        return;
+    }
+
+    latchReportState(gamepad->state, gamepad->fourWayDpad);
+    process(gamepad);
+
+    gamepad->state.buttons = liveButtons;
+    gamepad->state.dpad = liveDpad;
+}
+
+// Restart the latch from the live state at send time, so an input that already moved
+// away from what was just sent still owes the host its edge
+void GPDriver::reportSent() {
+    if (!firstReportSent) {
+        firstReportSent = true;
+        System::markBootTimeline("first report");
+    }
+    sentButtons = latchedButtons;
+    sentDpad = latchedDpad;
+    restartLatch();
+}
+
+void GPDriver::restartLatch() {
+    anyButtons = allButtons = liveButtons;
+    anyDpad = allDpad = liveDpad;
+    dpadMoved = false;
+    movedDpad = 0;
+    latchDpadValue(liveDpad);
+    latchStartMs = getMillis();
+}
+
+// Whole dpad values for 4-way modes: the first direction held since the report that differs
+// from it, otherwise neutral if the dpad was released in between. The live direction follows
+// in the next report, as restartLatch() starts over from it.
+void GPDriver::latchDpadValue(uint8_t dpad) {
+    if (dpad == sentDpad)
+        return;
+    dpadMoved = true;
+    if (dpad != 0 && movedDpad == 0)
+        movedDpad = dpad;
+}
+
+// An input the host last saw released is reported pressed if it was pressed at any
+// point since that report, and one it last saw pressed is reported released if it
+// was released at any point since.
+void GPDriver::latchReportState(GamepadState & state, bool fourWayDpad) {
+    liveButtons = state.buttons;
+    liveDpad = state.dpad;
+
+    if ((getMillis() - latchStartMs) > REPORT_LATCH_TIMEOUT_MS) {
+        restartLatch();
+    }
+
+    anyButtons |= state.buttons;
+    allButtons &= state.buttons;
+    anyDpad |= state.dpad;
+    allDpad &= state.dpad;
+    latchDpadValue(state.dpad);
+
+    latchedButtons = (sentButtons & allButtons) | (~sentButtons & anyButtons);
+
+    if (fourWayDpad) {
+        // Latching each direction on its own would join a released direction with the
+        // next one into a diagonal the 4-way filter never produced
+        latchedDpad = movedDpad ? movedDpad : (dpadMoved ? 0 : sentDpad);
+    } else {
+        latchedDpad = (sentDpad & allDpad) | (~sentDpad & anyDpad);
+
+        // Never report opposing directions that SOCD cleaning kept apart, fall back to
+        // the live axis instead
+        if ((latchedDpad & (GAMEPAD_MASK_UP | GAMEPAD_MASK_DOWN)) == (GAMEPAD_MASK_UP | GAMEPAD_MASK_DOWN))
+            latchedDpad = (latchedDpad & ~(GAMEPAD_MASK_UP | GAMEPAD_MASK_DOWN)) | (state.dpad & (GAMEPAD_MASK_UP | GAMEPAD_MASK_DOWN));
+        if ((latchedDpad & (GAMEPAD_MASK_LEFT | GAMEPAD_MASK_RIGHT)) == (GAMEPAD_MASK_LEFT | GAMEPAD_MASK_RIGHT))
+            latchedDpad = (latchedDpad & ~(GAMEPAD_MASK_LEFT | GAMEPAD_MASK_RIGHT)) | (state.dpad & (GAMEPAD_MASK_LEFT | GAMEPAD_MASK_RIGHT));
+    }
+
+    state.buttons = latchedButtons;
+    state.dpad = latchedDpad;
+}
@@ -1,4 +1,5 @@
 #include "tiny_ssd1306.h"
+#include <algorithm>
 
 void GPGFX_TinySSD1306::init(GPGFX_DisplayTypeOptions options) {
     _options.displayType = options.displayType;
@@ -157,37 +158,41 @@ void GPGFX_TinySSD1306::drawPixel(uint8_t x, uint8_t y, uint32_t color) {
 	}
 }
 
-void GPGFX_TinySSD1306::drawText(uint8_t x, uint8_t y, std::string text, uint8_t invert) {
-	uint8_t spriteX, spriteY;
-	uint8_t spriteByte;
-	uint8_t spriteBit;
-	uint8_t color;
-	uint8_t currChar, glyphIndex;
-	uint8_t charOffset = 0;
-	const uint8_t* currGlyph;
+void GPGFX_TinySSD1306::drawText(uint8_t x, uint8_t y, const std::string& text, uint8_t invert) {
+	uint8_t glyphColumns = _options.font.width - 1;
+	uint8_t glyphSize = glyphColumns * (_options.font.height / 8);
+	int16_t textX = x * _options.font.width;
+	int16_t textY = y * _options.font.height;
 
     uint8_t maxTextSize = (MAX_SCREEN_WIDTH / _options.font.width);
 
 	for (uint8_t charIndex = 0; charIndex < MIN(text.size(), maxTextSize); charIndex++) {
-		currChar = text[charIndex];
-		glyphIndex = currChar - GPGFX_FONT_CHAR_OFFSET;
-		currGlyph = &_options.font.fontData[glyphIndex * ((_options.font.width - 1) * (_options.font.height/8))];
-
-		for (spriteY = 0; spriteY < _options.font.height; spriteY++) {
-			for (spriteX = 0; spriteX < _options.font.width-1; spriteX++) {
-				spriteBit = spriteY % 8;
-				spriteByte = currGlyph[spriteX];
-				color = ((spriteByte >> spriteBit) & 0x01);
-                if (invert) color = !color;
-				drawPixel(((x*_options.font.width)+spriteX)+charOffset, (y*_options.font.height)+spriteY, color);
+		uint8_t glyphIndex = text[charIndex] - GPGFX_FONT_CHAR_OFFSET;
+		const uint8_t* currGlyph = &_options.font.fontData[glyphIndex * glyphSize];
+		int16_t charX = textX + (charIndex * _options.font.width);
+
+		for (uint8_t spriteX = 0; spriteX < glyphColumns; spriteX++) {
+			uint8_t bits = currGlyph[spriteX];
+			if (invert) bits = ~bits;
+
+			// every 8 rows of the glyph repeat the column byte
+			for (uint8_t spriteY = 0; spriteY < _options.font.height; spriteY += 8) {
+				uint8_t rows = MIN(_options.font.height - spriteY, 8);
+				blitColumn(charX + spriteX, textY + spriteY, bits, (rows == 8) ? 0xFF : ((1 << rows) - 1));
 			}
 		}
-
-		charOffset += _options.font.width;
 	}
 }
 
 void GPGFX_TinySSD1306::drawLine(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint32_t color, uint8_t filled) {
+    if (y1 == y2) {
+        drawSpan(x1, x2, y1, color);
+        return;
+    } else if (x1 == x2) {
+        fillRect(x1, y1, x2, y2, color);
+        return;
+    }
+
     int dx = abs(x2 - x1);
     int dy = abs(y2 - y1);
     int stepX = (x1 < x2) ? 1 : -1;
@@ -213,43 +218,40 @@ void GPGFX_TinySSD1306::drawLine(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t
 }
 
 void GPGFX_TinySSD1306::drawArc(uint16_t x, uint16_t y, uint32_t radiusX, uint32_t radiusY, uint32_t color, uint8_t filled, double startAngle, double endAngle, uint8_t closed) {
-    // Convert degrees to radians
-    startAngle = startAngle * M_PI / 180.0;
-    endAngle = endAngle * M_PI / 180.0;
+    int32_t start = (int32_t)(startAngle * 16);
+    int32_t end = (int32_t)(endAngle * 16);
 
-    // Angle step based on the resolution you want
-    double angleStep = 0.01; // Adjust as needed for smoother arcs
+    // keep consecutive points within half a pixel of each other on the rim
+    uint32_t radius = MAX(MAX(radiusX, radiusY), 1);
+    int32_t angleStep = MAX(MIN(458 / (int32_t)radius, 9), 1);
 
-    for (double angle = startAngle; angle < endAngle; angle += angleStep) {
-        int xPos = x + static_cast<int>(radiusX * cos(angle));
-        int yPos = y + static_cast<int>(radiusY * sin(angle));
-        drawPixel(xPos, yPos, color);
-    }
+    int32_t startX = x + (int32_t)radiusX * cosFixed(start) / (1 << TRIG_SHIFT);
+    int32_t startY = y + (int32_t)radiusY * sinFixed(start) / (1 << TRIG_SHIFT);
+    int32_t endX = x + (int32_t)radiusX * cosFixed(end) / (1 << TRIG_SHIFT);
+    int32_t endY = y + (int32_t)radiusY * sinFixed(end) / (1 << TRIG_SHIFT);
 
-    // Draw the last point
-    int xPos = x + static_cast<int>(radiusX * cos(endAngle));
-    int yPos = y + static_cast<int>(radiusY * sin(endAngle));
-    drawPixel(xPos, yPos, color);
+    for (int32_t angle = start; angle < end; angle += angleStep) {
+        int32_t xPos = x + (int32_t)radiusX * cosFixed(angle) / (1 << TRIG_SHIFT);
+        int32_t yPos = y + (int32_t)radiusY * sinFixed(angle) / (1 << TRIG_SHIFT);
 
-    if (closed) {
-        drawLine(x, y, (x + static_cast<int>(radiusX * cos(startAngle))), (y + static_cast<int>(radiusY * sin(startAngle))), color, filled);
-        drawLine(x, y, (x + static_cast<int>(radiusX * cos(endAngle))), (y + static_cast<int>(radiusY * sin(endAngle))), color, filled);
+        // If filled is true, fill the arc with lines from the center to each arc point
+        if (filled) {
+            drawLine(x, y, xPos, yPos, color, filled);
+        } else {
+            drawPixel(xPos, yPos, color);
+        }
     }
 
-    // If filled is true, fill the arc
+    // Draw the last point
     if (filled) {
-        // Draw lines to fill the arc
-        for (double angle = startAngle; angle <= endAngle; angle += angleStep) {
-            int xPosStart = x;
-            int yPosStart = y;
-            int xPosEnd = x + static_cast<int>(radiusX * cos(angle));
-            int yPosEnd = y + static_cast<int>(radiusY * sin(angle));
-            // Draw line from center to arc point
-            // You may replace this with your actual line drawing function
-            //drawPixel(xPosStart, yPosStart, color);
-            //drawPixel(xPosEnd, yPosEnd, color);
-            drawLine(xPosStart, yPosStart, xPosEnd, yPosEnd, color, filled);
-        }
+        drawLine(x, y, endX, endY, color, filled);
+    } else {
+        drawPixel(endX, endY, color);
+    }
+
+    if (closed) {
+        drawLine(x, y, startX, startY, color, filled);
+        drawLine(x, y, endX, endY, color, filled);
     }
 }
 
@@ -258,22 +260,17 @@ void GPGFX_TinySSD1306::drawEllipse(uint16_t x, uint16_t y, uint32_t radiusX, ui
 	long x1 = -radiusX, y1 = 0;
 	long e2 = radiusY, dx = (1 + 2 * x1) * e2 * e2;
 	long dy = x1 * x1, err = dx + dy;
-	long diff = 0;
 
 	while (x1 <= 0) {
-		drawPixel(x - x1, y + y1, color);
-		drawPixel(x + x1, y + y1, color);
-		drawPixel(x + x1, y - y1, color);
-		drawPixel(x - x1, y - y1, color);
-
 		if (filled)
 		{
-			for (int i = 0; i < ((x - x1) - (x + x1)) / 2; i++) {
-				drawPixel(x - i, y + y1, color);
-				drawPixel(x + i, y + y1, color);
-				drawPixel(x + i, y - y1, color);
-				drawPixel(x - i, y - y1, color);
-			}
+			drawSpan(x + x1, x - x1, y + y1, color);
+			if (y1 != 0) drawSpan(x + x1, x - x1, y - y1, color);
+		} else {
+			drawPixel(x - x1, y + y1, color);
+			drawPixel(x + x1, y + y1, color);
+			drawPixel(x + x1, y - y1, color);
+			drawPixel(x - x1, y - y1, color);
 		}
 
 		e2 = 2 * err;
@@ -296,77 +293,72 @@ void GPGFX_TinySSD1306::drawEllipse(uint16_t x, uint16_t y, uint32_t radiusX, ui
 }
 
 void GPGFX_TinySSD1306::drawRectangle(uint16_t x, uint16_t y, uint16_t width, uint16_t height, uint32_t color, uint8_t filled, double rotationAngle) {
-    // Calculate center point of the rectangle
-    double centerX = (x + width) / 2.0;
-    double centerY = (y + height) / 2.0;
-
-    // Calculate half width and half height for easier calculations
-    double halfWidth = (width - x) / 2.0;
-    double halfHeight = (height - y) / 2.0;
-
-    // Convert rotation angle to radians
-    double angleRad = rotationAngle * M_PI / 180.0;
+    int32_t angle = ((int32_t)(rotationAngle * 16)) % TRIG_FULL_TURN;
 
-    // Pre-calculate sine and cosine of the rotation angle
-    double cosA = cos(angleRad);
-    double sinA = sin(angleRad);
-
-    // Calculate rotated coordinates for each corner of the rectangle
-    double x0 = centerX + cosA * (-halfWidth) - sinA * (-halfHeight);
-    double y0 = centerY + sinA * (-halfWidth) + cosA * (-halfHeight);
-
-    double x1 = centerX + cosA * (halfWidth) - sinA * (-halfHeight);
-    double y1 = centerY + sinA * (halfWidth) + cosA * (-halfHeight);
-
-    double x2 = centerX + cosA * (halfWidth) - sinA * (halfHeight);
-    double y2 = centerY + sinA * (halfWidth) + cosA * (halfHeight);
-
-    double x3 = centerX + cosA * (-halfWidth) - sinA * (halfHeight);
-    double y3 = centerY + sinA * (-halfWidth) + cosA * (halfHeight);
+    // unrotated rectangles are by far the most common, draw them as spans
+    if (angle == 0) {
+        if (filled) {
+            fillRect(x, y, width, height, color);
+        } else {
+            drawSpan(x, width, y, color);
+            drawSpan(x, width, height, color);
+            fillRect(x, y, x, height, color);
+            fillRect(width, y, width, height, color);
+        }
+        return;
+    }
 
-    // Round coordinates to nearest integer
-    uint16_t x0_rounded = (uint16_t)round(x0);
-    uint16_t y0_rounded = (uint16_t)round(y0);
-    uint16_t x1_rounded = (uint16_t)round(x1);
-    uint16_t y1_rounded = (uint16_t)round(y1);
-    uint16_t x2_rounded = (uint16_t)round(x2);
-    uint16_t y2_rounded = (uint16_t)round(y2);
-    uint16_t x3_rounded = (uint16_t)round(x3);
-    uint16_t y3_rounded = (uint16_t)round(y3);
+    // Work in units of half a pixel so the center and half sizes stay integers
+    int32_t centerX = x + width;
+    int32_t centerY = y + height;
+    int32_t halfWidth = width - x;
+    int32_t halfHeight = height - y;
+
+    int32_t cosA = cosFixed(angle);
+    int32_t sinA = sinFixed(angle);
+
+    // Corners relative to the center, before rotation
+    const int32_t cornerX[4] = { -halfWidth, halfWidth, halfWidth, -halfWidth };
+    const int32_t cornerY[4] = { -halfHeight, -halfHeight, halfHeight, halfHeight };
+
+    int16_t xVertices[4];
+    int16_t yVertices[4];
+    for (uint8_t i = 0; i < 4; i++) {
+        int32_t rotatedX = (centerX << TRIG_SHIFT) + cosA * cornerX[i] - sinA * cornerY[i];
+        int32_t rotatedY = (centerY << TRIG_SHIFT) + sinA * cornerX[i] + cosA * cornerY[i];
+
+        // Round to the nearest pixel
+        int32_t divisor = 2 << TRIG_SHIFT;
+        xVertices[i] = (rotatedX + ((rotatedX < 0) ? -(divisor / 2) : (divisor / 2))) / divisor;
+        yVertices[i] = (rotatedY + ((rotatedY < 0) ? -(divisor / 2) : (divisor / 2))) / divisor;
+    }
 
     // Draw lines between rotated coordinates
-    drawLine(x0_rounded, y0_rounded, x1_rounded, y1_rounded, color, filled);
-    drawLine(x1_rounded, y1_rounded, x2_rounded, y2_rounded, color, filled);
-    drawLine(x2_rounded, y2_rounded, x3_rounded, y3_rounded, color, filled);
-    drawLine(x3_rounded, y3_rounded, x0_rounded, y0_rounded, color, filled);
+    for (uint8_t i = 0; i < 4; i++) {
+        drawLine(xVertices[i], yVertices[i], xVertices[(i + 1) % 4], yVertices[(i + 1) % 4], color, filled);
+    }
 
 	if (filled) {
-        // Calculate the number of lines needed for the filling
-        uint16_t numLines = (uint16_t)round(sqrt(halfWidth * halfWidth + halfHeight * halfHeight) * 2);
-
-        for (uint16_t i = 0; i <= numLines; i++) {
-            double t = (double)i / numLines;
-            double xStart = (1 - t) * x0 + t * x3;
-            double yStart = (1 - t) * y0 + t * y3;
-            double xEnd = (1 - t) * x1 + t * x2;
-            double yEnd = (1 - t) * y1 + t * y2;
-
-            drawLine((uint16_t)round(xStart), (uint16_t)round(yStart), (uint16_t)round(xEnd), (uint16_t)round(yEnd), color, filled);
-        }
+        fillPolygon(xVertices, yVertices, 4, color);
 	}
 }
 
 void GPGFX_TinySSD1306::drawPolygon(uint16_t x, uint16_t y, uint16_t radius, uint16_t sides, uint32_t color, uint8_t filled, double rotation) {
-    // Calculate the angle increment between each vertex
-    double angleIncrement = 2 * M_PI / sides;
+    if (sides == 0) return;
+
+    // rotation is in radians
+    int32_t rotationAngle = (int32_t)(rotation * TRIG_FULL_TURN / (2 * M_PI));
 
     // Calculate vertices
-    uint16_t xVertices[sides];
-    uint16_t yVertices[sides];
+    int16_t xVertices[sides];
+    int16_t yVertices[sides];
     for (int i = 0; i < sides; i++) {
-        double angle = i * angleIncrement + rotation;
-        xVertices[i] = x + round(radius * cos(angle));
-        yVertices[i] = y + round(radius * sin(angle));
+        int32_t angle = (i * TRIG_FULL_TURN) / sides + rotationAngle;
+        int32_t offsetX = radius * cosFixed(angle);
+        int32_t offsetY = radius * sinFixed(angle);
+        int32_t half = 1 << (TRIG_SHIFT - 1);
+        xVertices[i] = x + (offsetX + ((offsetX < 0) ? -half : half)) / (1 << TRIG_SHIFT);
+        yVertices[i] = y + (offsetY + ((offsetY < 0) ? -half : half)) / (1 << TRIG_SHIFT);
     }
 
     // Draw lines between vertices
@@ -376,41 +368,7 @@ void GPGFX_TinySSD1306::drawPolygon(uint16_t x, uint16_t y, uint16_t radius, uin
     drawLine(xVertices[sides - 1], yVertices[sides - 1], xVertices[0], yVertices[0], color, false);
 
     if (filled) {
-        // Find the minimum and maximum y coordinates to scan
-        uint16_t minY = yVertices[0], maxY = yVertices[0];
-        for (int i = 1; i < sides; i++) {
-            if (yVertices[i] < minY) minY = yVertices[i];
-            if (yVertices[i] > maxY) maxY = yVertices[i];
-        }
-
-        // Scan horizontally and draw lines between intersections
-        for (int scanY = minY + 1; scanY < maxY; scanY++) {
-            int intersections = 0;
-            double intersectPoints[sides];
-
-            for (int i = 0; i < sides; i++) {
-                int next = (i + 1) % sides;
-                if ((yVertices[i] < scanY && yVertices[next] >= scanY) || (yVertices[next] < scanY && yVertices[i] >= scanY)) {
-                    intersectPoints[intersections++] = xVertices[i] + (scanY - yVertices[i]) * (xVertices[next] - xVertices[i]) / (yVertices[next] - yVertices[i]);
-                }
-            }
-
-            // Sort the intersection points by x coordinate
-            for (int i = 0; i < intersections - 1; i++) {
-                for (int j = 0; j < intersections - i - 1; j++) {
-                    if (intersectPoints[j] > intersectPoints[j + 1]) {
-                        double temp = intersectPoints[j];
-                        intersectPoints[j] = intersectPoints[j + 1];
-                        intersectPoints[j + 1] = temp;
-                    }
-                }
-            }
-
-            // Draw lines between pairs of intersection points
-            for (int i = 0; i < intersections; i += 2) {
-                drawLine(intersectPoints[i], scanY, intersectPoints[i + 1], scanY, color, false);
-            }
-        }
+        fillPolygon(xVertices, yVertices, sides, color);
     }
 }
 
@@ -487,3 +445,140 @@ void GPGFX_TinySSD1306::sendCommand(uint8_t command){
 void GPGFX_TinySSD1306::sendCommands(uint8_t* commands, uint16_t length){ 
 	int result = _options.i2c->write(_options.address, commands, length, false);
 }
+
+void GPGFX_TinySSD1306::blitColumn(int16_t x, int16_t y, uint8_t bits, uint8_t mask) {
+    if (this->screenType == ScreenAlternatives::SCREEN_132x64) {
+        x+=2;
+    }
+
+    if ((x < 0) || (x >= MAX_SCREEN_WIDTH) || (y <= -8) || (y >= MAX_SCREEN_HEIGHT)) return;
+
+    // a column that does not start on a page boundary straddles two pages
+    uint8_t shift = y & 0x07;
+    int16_t page = (y >> 3);
+
+    if (page >= 0) {
+        uint8_t pageMask = mask << shift;
+        uint8_t* target = &frameBuffer[(page * MAX_SCREEN_WIDTH) + x];
+        *target = (*target & ~pageMask) | ((bits << shift) & pageMask);
+    }
+
+    if ((shift != 0) && (page + 1 < (MAX_SCREEN_HEIGHT / 8))) {
+        uint8_t pageMask = mask >> (8 - shift);
+        uint8_t* target = &frameBuffer[((page + 1) * MAX_SCREEN_WIDTH) + x];
+        *target = (*target & ~pageMask) | ((bits >> (8 - shift)) & pageMask);
+    }
+}
+
+void GPGFX_TinySSD1306::drawSpan(int16_t x1, int16_t x2, int16_t y, uint32_t color) {
+    fillRect(x1, y, x2, y, color);
+}
+
+void GPGFX_TinySSD1306::fillRect(int16_t x1, int16_t y1, int16_t x2, int16_t y2, uint32_t color) {
+    if (x1 > x2) std::swap(x1, x2);
+    if (y1 > y2) std::swap(y1, y2);
+
+    if (this->screenType == ScreenAlternatives::SCREEN_132x64) {
+        x1+=2;
+        x2+=2;
+    }
+
+    // clip to the frame buffer
+    x1 = MAX(x1, 0);
+    y1 = MAX(y1, 0);
+    x2 = MIN(x2, (int16_t)(MAX_SCREEN_WIDTH - 1));
+    y2 = MIN(y2, (int16_t)(MAX_SCREEN_HEIGHT - 1));
+    if ((x1 > x2) || (y1 > y2)) return;
+
+    for (int16_t page = (y1 >> 3); page <= (y2 >> 3); page++) {
+        // rows of this page that are inside the rectangle
+        uint8_t top = (page == (y1 >> 3)) ? (y1 & 0x07) : 0;
+        uint8_t bottom = (page == (y2 >> 3)) ? (y2 & 0x07) : 7;
+        uint8_t mask = (0xFF << top) & (0xFF >> (7 - bottom));
+
+        uint8_t* target = &frameBuffer[(page * MAX_SCREEN_WIDTH) + x1];
+        uint8_t* last = &frameBuffer[(page * MAX_SCREEN_WIDTH) + x2];
+        if (color == 1) {
+            for (; target <= last; target++) *target |= mask;
+        } else if (color == 0) {
+            for (; target <= last; target++) *target &= ~mask;
+        } else {
+            for (; target <= last; target++) *target ^= mask;
+        }
+    }
+}
+
+void GPGFX_TinySSD1306::fillPolygon(const int16_t* xVertices, const int16_t* yVertices, uint16_t sides, uint32_t color) {
+    // Find the minimum and maximum y coordinates to scan
+    int16_t minY = yVertices[0], maxY = yVertices[0];
+    for (int i = 1; i < sides; i++) {
+        if (yVertices[i] < minY) minY = yVertices[i];
+        if (yVertices[i] > maxY) maxY = yVertices[i];
+    }
+
+    // Scan horizontally and draw spans between intersections
+    int16_t intersectPoints[sides];
+    for (int scanY = minY + 1; scanY < maxY; scanY++) {
+        int intersections = 0;
+
+        for (int i = 0; i < sides; i++) {
+            int next = (i + 1) % sides;
+            if ((yVertices[i] < scanY && yVertices[next] >= scanY) || (yVertices[next] < scanY && yVertices[i] >= scanY)) {
+                intersectPoints[intersections++] = xVertices[i] + (scanY - yVertices[i]) * (xVertices[next] - xVertices[i]) / (yVertices[next] - yVertices[i]);
+            }
+        }
+
+        // Sort the intersection points by x coordinate
+        for (int i = 1; i < intersections; i++) {
+            int16_t point = intersectPoints[i];
+            int j = i - 1;
+            for (; j >= 0 && intersectPoints[j] > point; j--) {
+                intersectPoints[j + 1] = intersectPoints[j];
+            }
+            intersectPoints[j + 1] = point;
+        }
+
+        // Draw spans between pairs of intersection points
+        for (int i = 0; i + 1 < intersections; i += 2) {
+            drawSpan(intersectPoints[i], intersectPoints[i + 1], scanY, color);
+        }
+    }
+}
+
+// sin of 0-90 degrees in 1 degree steps, scaled by 1 << TRIG_SHIFT
+static const uint16_t sineTable[91] = {
+    0, 286, 572, 857, 1143, 1428, 1713, 1997, 2280, 2563,
+    2845, 3126, 3406, 3686, 3964, 4240, 4516, 4790, 5063, 5334,
+    5604, 5872, 6138, 6402, 6664, 6924, 7182, 7438, 7692, 7943,
+    8192, 8438, 8682, 8923, 9162, 9397, 9630, 9860, 10087, 10311,
+    10531, 10749, 10963, 11174, 11381, 11585, 11786, 11982, 12176, 12365,
+    12551, 12733, 12911, 13085, 13255, 13421, 13583, 13741, 13894, 14044,
+    14189, 14330, 14466, 14598, 14726, 14849, 14968, 15082, 15191, 15296,
+    15396, 15491, 15582, 15668, 15749, 15826, 15897, 15964, 16026, 16083,
+    16135, 16182, 16225, 16262, 16294, 16322, 16344, 16362, 16374, 16382,
+    16384
+};
+
+int32_t GPGFX_TinySSD1306::sinFixed(int32_t angle) {
+    const int32_t quarterTurn = TRIG_FULL_TURN / 4;
+
+    angle %= TRIG_FULL_TURN;
+    if (angle < 0) angle += TRIG_FULL_TURN;
+
+    uint8_t quadrant = angle / quarterTurn;
+    int32_t offset = angle % quarterTurn;
+    if (quadrant & 1) offset = quarterTurn - offset;
+
+    // interpolate between whole degrees
+    int32_t degree = offset >> 4;
+    int32_t value = sineTable[degree];
+    if (offset & 0x0F) {
+        value += ((sineTable[degree + 1] - value) * (offset & 0x0F)) >> 4;
+    }
+
+    return (quadrant & 2) ? -value : value;
+}
+
+int32_t GPGFX_TinySSD1306::cosFixed(int32_t angle) {
+    return sinFixed(angle + (TRIG_FULL_TURN / 4));
+}
@@ -9,6 +9,8 @@
 // GP2040 includes
 #include "gp2040.h"
 #include "gp2040aux.h"
+#include "system.h"
+#include "taskmanager.h"
 
 #include <cstdlib>
 
@@ -26,6 +28,7 @@ static GP2040Aux * gp2040Core1 = nullptr;
 // Launch our second core with additional modules loaded in
 void core1() {
 	multicore_lockout_victim_init(); // block core 1
+	System::markBootTimeline("core1 start");
 
 	// Create GP2040 w/ Additional Modules for Core 1	
 	gp2040Core1->setup();
@@ -33,6 +36,9 @@ void core1() {
 }
 
 int main() {
+	System::startBootTimeline();
+	TaskManager::getInstance().init();
+
 	// Create GP2040 Main Core (core0), Core1 is dependent on Core0
 	gp2040Core0 = new GP2040();
 	gp2040Core1 = new GP2040Aux();
@@ -43,10 +49,18 @@ int main() {
 	// Create GP2040 Thread for Core1
 	multicore_launch_core1(core1);
 
-	// Sync Core0 and Core1
-	while(gp2040Core1->ready() == false ) {
-		__asm volatile ("nop\n");
+	// Enumerate with the host while Core1 brings up the USB host stack and Core0 its
+	// slower add-ons, so consoles polling at plug-in see us right away. The input
+	// driver's auth has to be set up first, the console can start it as soon as we
+	// enumerate, and Core1's add-ons register their event handlers before it too.
+	while(gp2040Core1->authReady() == false) {
+		tight_loop_contents();
 	}
+	gp2040Core0->startUSB();
+	gp2040Core0->setupDeferredAddons();
+
+	// Core0's loop does not wait for the rest of Core1's setup
+	System::markBootTimeline("core0 loop");
 	gp2040Core0->run();
 
 	return 0;
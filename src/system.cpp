@@ -4,10 +4,19 @@
 
 #include <hardware/flash.h>
 #include <hardware/sync.h>
+#include <hardware/timer.h>
 #include <hardware/watchdog.h>
 #include <pico/multicore.h>
+#include <pico/platform.h>
 
 #include <malloc.h>
+#include <cstring>
+
+#define BOOT_TIMELINE_MAGIC 0x42544c31
+
+// Not cleared by the runtime, so a watchdog reboot leaves the last boot readable
+static System::BootTimeline __uninitialized_ram(bootTimeline);
+static System::BootTimeline __uninitialized_ram(previousBootTimeline);
 
 extern char __flash_binary_start;
 extern char __flash_binary_end;
@@ -92,3 +101,40 @@ System::BootMode System::takeBootMode() {
 
     return bootMode;
 }
+
+void System::startBootTimeline() {
+    if (bootTimeline.magic == BOOT_TIMELINE_MAGIC &&
+        bootTimeline.count[0] <= BOOT_TIMELINE_MAX_ENTRIES &&
+        bootTimeline.count[1] <= BOOT_TIMELINE_MAX_ENTRIES) {
+        memcpy(&previousBootTimeline, &bootTimeline, sizeof(BootTimeline));
+    } else {
+        memset(&previousBootTimeline, 0, sizeof(BootTimeline));
+    }
+
+    memset(&bootTimeline, 0, sizeof(BootTimeline));
+    bootTimeline.magic = BOOT_TIMELINE_MAGIC;
+    markBootTimeline("reset");
+}
+
+// Each core only appends to its own list, so no locking is needed
+void System::markBootTimeline(const char* label) {
+    uint32_t core = get_core_num();
+    uint8_t index = bootTimeline.count[core];
+    if (bootTimeline.magic != BOOT_TIMELINE_MAGIC || index >= BOOT_TIMELINE_MAX_ENTRIES)
+        return;
+
+    BootTimelineEntry& entry = bootTimeline.entries[core][index];
+    strncpy(entry.label, label, BOOT_TIMELINE_LABEL_SIZE - 1);
+    entry.label[BOOT_TIMELINE_LABEL_SIZE - 1] = '\0';
+    entry.timeUs = time_us_32();
+    bootTimeline.count[core] = index + 1;
+}
+
+const System::BootTimeline& System::getBootTimeline(bool previous) {
+    return previous ? previousBootTimeline : bootTimeline;
+}
+
+// SEV latches the event flag, so a wake sent while Core1 is busy makes its next WFE return at once
+void System::wakeCore1() {
+    __sev();
+}
@@ -0,0 +1,108 @@
+#include "taskmanager.h"
+
+#include <pico/platform.h>
+
+#include <cstring>
+
+#define TASK_STATS_MAGIC 0x54534b31
+
+static TaskStatsTable __uninitialized_ram(taskStats);
+static TaskStatsTable __uninitialized_ram(previousTaskStats);
+
+void TaskManager::init() {
+    if (taskStats.magic == TASK_STATS_MAGIC &&
+        taskStats.count[0] <= TASK_MANAGER_MAX_TASKS &&
+        taskStats.count[1] <= TASK_MANAGER_MAX_TASKS) {
+        memcpy(&previousTaskStats, &taskStats, sizeof(TaskStatsTable));
+    } else {
+        memset(&previousTaskStats, 0, sizeof(TaskStatsTable));
+    }
+
+    memset(&taskStats, 0, sizeof(TaskStatsTable));
+    taskStats.magic = TASK_STATS_MAGIC;
+    nextDue[0] = nextDue[1] = at_the_end_of_time;
+}
+
+int TaskManager::addPeriodicTask(const char* name, uint32_t periodUs, TaskFunction task) {
+    return addTask(name, periodUs, periodUs, task);
+}
+
+int TaskManager::addOneShotTask(const char* name, uint32_t delayUs, TaskFunction task) {
+    return addTask(name, 0, delayUs, task);
+}
+
+// Each core only touches its own table, so no locking is needed. Slots of one-shot
+// tasks that already ran are reused before the table grows.
+int TaskManager::addTask(const char* name, uint32_t periodUs, uint32_t delayUs, TaskFunction task) {
+    uint32_t core = get_core_num();
+    uint8_t index = 0;
+    while (index < taskStats.count[core] && tasks[core][index].active)
+        index++;
+    if (index >= TASK_MANAGER_MAX_TASKS)
+        return -1;
+
+    TaskStats& stats = taskStats.tasks[core][index];
+    memset(&stats, 0, sizeof(TaskStats));
+    strncpy(stats.name, name, TASK_NAME_SIZE - 1);
+    stats.periodUs = periodUs;
+
+    tasks[core][index].function = task;
+    tasks[core][index].deadline = make_timeout_time_us(delayUs);
+    tasks[core][index].active = true;
+    if (index == taskStats.count[core])
+        taskStats.count[core] = index + 1;
+
+    if (absolute_time_diff_us(tasks[core][index].deadline, nextDue[core]) > 0)
+        nextDue[core] = tasks[core][index].deadline;
+    return index;
+}
+
+// A periodic task that overran is moved to its next slot after now instead of
+// running back to back, and each slot it skipped is counted as a miss
+void TaskManager::process() {
+    uint32_t core = get_core_num();
+    if (!time_reached(nextDue[core]))
+        return;
+
+    // A task may add another one, into any free slot, which lowers nextDue again
+    nextDue[core] = at_the_end_of_time;
+    absolute_time_t next = at_the_end_of_time;
+    for (uint8_t i = 0; i < taskStats.count[core]; i++) {
+        Task& task = tasks[core][i];
+        if (!task.active)
+            continue;
+
+        int64_t lateUs = absolute_time_diff_us(task.deadline, get_absolute_time());
+        if (lateUs >= 0) {
+            TaskStats& stats = taskStats.tasks[core][i];
+            stats.runs++;
+            if (lateUs > stats.maxLateUs)
+                stats.maxLateUs = lateUs;
+
+            if (stats.periodUs != 0) {
+                uint32_t missed = lateUs / stats.periodUs;
+                stats.misses += missed;
+                task.deadline = delayed_by_us(task.deadline, (uint64_t)(missed + 1) * stats.periodUs);
+                task.function();
+            } else {
+                // Free the slot first, the task may reuse it for its follow-up
+                TaskFunction function = std::move(task.function);
+                task.active = false;
+                function();
+            }
+        }
+
+        if (task.active && absolute_time_diff_us(task.deadline, next) > 0)
+            next = task.deadline;
+    }
+    if (absolute_time_diff_us(next, nextDue[core]) > 0)
+        nextDue[core] = next;
+}
+
+absolute_time_t TaskManager::nextDeadline() {
+    return nextDue[get_core_num()];
+}
+
+const TaskStatsTable& TaskManager::getStats(bool previous) {
+    return previous ? previousTaskStats : taskStats;
+}
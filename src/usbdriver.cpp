@@ -8,6 +8,7 @@
 
 #include "tusb.h"
 #include "drivermanager.h"
+#include "system.h"
 
 static bool usb_mounted;
 static bool usb_suspended;
@@ -38,8 +39,11 @@ void tud_hid_set_report_cb(uint8_t itf, uint8_t report_id, hid_report_type_t rep
 // Invoked when device is mounted
 void tud_mount_cb(void)
 {
+	if (!usb_mounted)
+		System::markBootTimeline("usb mounted");
 	usb_mounted = true;
 	usb_suspended = false;
+	System::wakeCore1();
 }
 
 // Invoked when device is unmounted
@@ -47,6 +51,7 @@ void tud_umount_cb(void)
 {
 	usb_mounted = false;
 	usb_suspended = false;
+	System::wakeCore1();
 }
 
 // Invoked when usb bus is suspended
@@ -55,11 +60,13 @@ void tud_umount_cb(void)
 void tud_suspend_cb(bool remote_wakeup_en) {
 	(void)remote_wakeup_en;
 	usb_suspended = true;
+	System::wakeCore1();
 }
 
 // Invoked when usb bus is resumed
 void tud_resume_cb(void) {
 	usb_suspended = false;
+	System::wakeCore1();
 }
 
 // Vendor Controlled XFER occured
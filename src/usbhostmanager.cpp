@@ -35,7 +35,8 @@ void USBHostManager::pushListener(USBListener * usbListener) { // If anything ne
     listeners.push_back(usbListener);
 }
 
-// Host manager should call tuh_task as fast as possible
+// Host manager should call tuh_task as fast as possible, always from Core1 where
+// the host stack was started so listeners never race the PIO-USB frame IRQ
 void USBHostManager::process() {
     if ( tuh_ready ){
         tuh_task();
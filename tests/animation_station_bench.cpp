@@ -0,0 +1,39 @@
+// Time per LED frame for each AnimationStation effect on the scenario layout, on the host:
+// presses, Animate() and ApplyBrightness(), as NeoPicoLEDAddon::process() runs them
+
+#include "animation_station_scenario.h"
+
+#include <chrono>
+#include <cstdio>
+
+static const char * effectNames[SCENARIO_EFFECTS] = {
+    "static color", "rainbow", "chase", "static theme", "custom theme"
+};
+
+int main() {
+    static AnimationStation station;
+    PixelMatrix matrix;
+    matrix.setup(scenarioPixels(), SCENARIO_LEDS_PER_PIXEL);
+    scenarioThemes();
+    AnimationStation::ConfigureBrightness(255, SCENARIO_BRIGHTNESS_STEPS);
+    station.SetMatrix(matrix);
+    AnimationStation::SetOptions(scenarioOptions());
+
+    const int frames = 200000;
+    uint32_t leds[100];
+    uint32_t check = 0;
+    for (int effect = 0; effect < SCENARIO_EFFECTS; effect++) {
+        station.SetMode(effect);
+        ScenarioRandom random;
+        auto start = std::chrono::steady_clock::now();
+        for (int frame = 0; frame < frames; frame++) {
+            scenarioFrame(station, matrix, random);
+            station.ApplyBrightness(leds, 100);
+            check += leds[frame % matrix.getLedCount()];
+        }
+        auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+        printf("%-13s %.2f us/frame\n", effectNames[effect], elapsed / 1000.0 / frames);
+    }
+    if (check == 0xFFFFFFFF) printf("\n"); // keep the frames from being optimized out
+    return 0;
+}
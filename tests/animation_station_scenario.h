@@ -0,0 +1,148 @@
+#ifndef _ANIMATION_STATION_SCENARIO_H_
+#define _ANIMATION_STATION_SCENARIO_H_
+
+// The LED layout, themes and button presses the AnimationStation test and benchmark run.
+// animation_station_vectors.h was recorded by running this file against the sources from
+// before the pixel table was flattened.
+
+#include "AnimationStation.hpp"
+
+#include <stdint.h>
+#include <vector>
+
+static const int SCENARIO_COLUMNS = 6;
+static const int SCENARIO_ROWS = 3;
+static const int SCENARIO_LEDS_PER_PIXEL = 2;
+static const int SCENARIO_FRAMES = 600;
+static const int SCENARIO_SEGMENT_FRAMES = 50;
+static const int SCENARIO_EFFECTS = TOTAL_EFFECTS + 1; // with the custom theme
+static const int SCENARIO_BRIGHTNESS_STEPS = 5;
+
+// Small LCG so the press pattern and frame times are the same on every host
+class ScenarioRandom {
+public:
+    uint32_t next(uint32_t range) {
+        state = state * 1664525u + 1013904223u;
+        return (state >> 8) % range;
+    }
+private:
+    uint32_t state = 12345;
+};
+
+// Columns of three pixels with a gap at the bottom, LEDs chained up one column and down the next
+static std::vector<std::vector<Pixel>> scenarioPixels() {
+    std::vector<std::vector<Pixel>> pixels;
+    int index = 0;
+    for (int column = 0; column < SCENARIO_COLUMNS; column++) {
+        std::vector<Pixel> rows;
+        for (int row = 0; row < SCENARIO_ROWS; row++) {
+            int chainRow = (column & 1) ? (SCENARIO_ROWS - 1 - row) : row;
+            uint8_t led = (column * SCENARIO_ROWS + chainRow) * SCENARIO_LEDS_PER_PIXEL;
+            std::vector<uint8_t> positions;
+            for (int i = 0; i < SCENARIO_LEDS_PER_PIXEL; i++)
+                positions.push_back(led + i);
+            rows.push_back(Pixel(index, 1u << index, positions));
+            index++;
+        }
+        rows.push_back(NO_PIXEL);
+        pixels.push_back(rows);
+    }
+    return pixels;
+}
+
+// Two static themes and a custom theme, each leaving some pixels on the default color
+static void scenarioThemes() {
+    std::map<uint32_t, RGB> even, odd, custom, customPressed;
+    for (int i = 0; i < SCENARIO_COLUMNS * SCENARIO_ROWS; i++) {
+        RGB color(i * 14, 255 - i * 14, (i * 37) & 0xff);
+        if ((i % 2) == 0) even[1u << i] = color;
+        if ((i % 3) != 0) odd[1u << i] = RGB(color.b, color.r, color.g);
+        if ((i % 5) != 0) custom[1u << i] = RGB(color.g, color.b, color.r);
+        if ((i % 4) != 0) customPressed[1u << i] = RGB(255 - color.r, 255 - color.g, 255 - color.b);
+    }
+    StaticTheme::AddTheme(even);
+    StaticTheme::AddTheme(odd);
+    CustomTheme::SetCustomTheme(custom);
+    CustomThemePressed::SetCustomTheme(customPressed);
+}
+
+static AnimationOptions scenarioOptions() {
+    AnimationOptions options = {};
+    options.brightness = SCENARIO_BRIGHTNESS_STEPS;
+    options.staticColorIndex = 2;
+    options.buttonColorIndex = 5;
+    options.chaseCycleTime = 40;
+    options.rainbowCycleTime = 20;
+    options.hasCustomTheme = true;
+    // A power of two keeps the old float blend exact, see animation_station_test.cpp for other times
+    options.buttonPressColorCooldownTimeInMs = 512;
+    return options;
+}
+
+// One frame: move the clock 1-16 ms, hold a random set of buttons now and then, press a hotkey
+// now and then, then animate
+static void scenarioFrame(AnimationStation & station, PixelMatrix & matrix, ScenarioRandom & random) {
+    host_time_advance_us(1000 + random.next(15000));
+
+    uint32_t roll = random.next(100);
+    if (roll < 30) {
+        std::vector<Pixel> pressed;
+        for (auto & column : matrix.pixels)
+            for (auto & pixel : column)
+                if (pixel.index != NO_PIXEL.index && random.next(4) == 0)
+                    pressed.push_back(pixel);
+        station.HandlePressed(pressed);
+    } else if (roll < 60) {
+        station.ClearPressed();
+    }
+
+    roll = random.next(200);
+    if (roll == 0) {
+        station.HandleEvent(HOTKEY_LEDS_PARAMETER_UP);
+    } else if (roll == 1) {
+        station.HandleEvent(HOTKEY_LEDS_PRESS_PARAMETER_UP);
+    } else if (roll == 2) {
+        station.HandleEvent(HOTKEY_LEDS_BRIGHTNESS_DOWN);
+    } else if (roll == 3) {
+        station.HandleEvent(HOTKEY_LEDS_BRIGHTNESS_UP);
+    }
+
+    station.Animate();
+}
+
+// Every effect at every brightness step, one FNV-1a hash of the LED values per segment of frames
+static std::vector<uint32_t> scenarioHashes() {
+    static AnimationStation station;
+    PixelMatrix matrix;
+    matrix.setup(scenarioPixels(), SCENARIO_LEDS_PER_PIXEL);
+    scenarioThemes();
+    AnimationStation::ConfigureBrightness(255, SCENARIO_BRIGHTNESS_STEPS);
+    station.SetMatrix(matrix);
+
+    std::vector<uint32_t> hashes;
+    ScenarioRandom random;
+    uint32_t leds[100];
+    for (int effect = 0; effect < SCENARIO_EFFECTS; effect++) {
+        for (int brightness = 0; brightness <= SCENARIO_BRIGHTNESS_STEPS; brightness++) {
+            AnimationOptions options = scenarioOptions();
+            options.brightness = brightness;
+            AnimationStation::SetOptions(options);
+            station.SetMode(effect);
+
+            uint32_t hash = 2166136261u;
+            for (int frame = 0; frame < SCENARIO_FRAMES; frame++) {
+                scenarioFrame(station, matrix, random);
+                station.ApplyBrightness(leds, 100);
+                for (int i = 0; i < matrix.getLedCount(); i++)
+                    hash = (hash ^ leds[i]) * 16777619u;
+                if (((frame + 1) % SCENARIO_SEGMENT_FRAMES) == 0) {
+                    hashes.push_back(hash);
+                    hash = 2166136261u;
+                }
+            }
+        }
+    }
+    return hashes;
+}
+
+#endif
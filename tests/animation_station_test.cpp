@@ -0,0 +1,90 @@
+// Runs every AnimationStation effect through animation_station_scenario.h and checks the LED
+// values against hashes recorded from the float based sources. The fixed-point brightness is
+// also checked against RGB::value() for every brightness setting, and BlendColor against the
+// old float blend at the fade times the scenario does not use.
+
+#include "animation_station_scenario.h"
+
+#include "testing.h"
+#include "animation_station_vectors.h"
+
+static void checkScenario() {
+    std::vector<uint32_t> hashes = scenarioHashes();
+    const size_t expected = sizeof(animationStationHashes) / sizeof(animationStationHashes[0]);
+    EXPECT(hashes.size() == expected, "%zu segment hashes, got %zu", expected, hashes.size());
+
+    const int segments = SCENARIO_FRAMES / SCENARIO_SEGMENT_FRAMES;
+    for (size_t i = 0; i < hashes.size() && i < expected; i++) {
+        int effect = i / (segments * (SCENARIO_BRIGHTNESS_STEPS + 1));
+        int brightness = (i / segments) % (SCENARIO_BRIGHTNESS_STEPS + 1);
+        int frame = (i % segments) * SCENARIO_SEGMENT_FRAMES;
+        EXPECT(hashes[i] == animationStationHashes[i], "effect %d brightness %d frames %d-%d match the recording",
+            effect, brightness, frame, frame + SCENARIO_SEGMENT_FRAMES - 1);
+    }
+}
+
+static void checkBrightness() {
+    AnimationOptions options = scenarioOptions();
+    for (int maximum = 0; maximum < 256; maximum++) {
+        for (int steps = 1; steps <= 10; steps++) {
+            AnimationStation::ConfigureBrightness(maximum, steps);
+            for (int brightness = 0; brightness <= steps; brightness++) {
+                options.brightness = brightness;
+                AnimationStation::SetOptions(options);
+                float brightnessX = AnimationStation::GetBrightnessX();
+                uint32_t scale = AnimationStation::GetBrightnessScale();
+                for (int c = 0; c < 256; c++) {
+                    RGB color(c, 255 - c, c / 3);
+                    uint32_t value = color.value(LED_FORMAT_RGB, brightnessX);
+                    uint32_t scaled = color.scaledValue(LED_FORMAT_RGB, scale);
+                    EXPECT(scaled == value, "maximum %d, %d steps, brightness %d scales %d to %06x, got %06x",
+                        maximum, steps, brightness, c, value, scaled);
+                }
+            }
+        }
+    }
+}
+
+// The old blend computed start + (end - start) * (1 - remaining / coolDown) in floats. Where the
+// exact result is a whole number the float result can land just under it and truncate one
+// lower, the integer blend does not. Everywhere else the two have to agree.
+static void checkBlend() {
+    static const uint32_t coolDowns[] = { 7, 100, 333, 500, 1000, 1500, 2000, 2500, 3000, 4000, 5000 };
+    PixelMatrix matrix;
+    matrix.setup(scenarioPixels(), SCENARIO_LEDS_PER_PIXEL);
+    int roundedUp = 0;
+    int checked = 0;
+    for (uint32_t coolDown : coolDowns) {
+        AnimationStation::options.buttonPressColorCooldownTimeInMs = coolDown;
+        StaticColor animation(matrix);
+        animation.UpdateTime();
+        for (uint32_t remaining = 1; remaining < coolDown; remaining++) {
+            float progress = 1.0f - (static_cast<float>(remaining) / static_cast<float>(coolDown));
+            for (int start = 0; start < 256; start += 5) {
+                for (int end = 0; end < 256; end += 5) {
+                    RGB blended = animation.BlendColor(RGB(start, 0, 0), RGB(end, 0, 0), remaining);
+                    uint32_t old = static_cast<uint32_t>(static_cast<float>(start + (end - start) * progress));
+                    bool whole = ((start * remaining + end * (coolDown - remaining)) % coolDown) == 0;
+                    checked++;
+                    if (blended.r == old)
+                        continue;
+                    if (whole && blended.r == old + 1) {
+                        roundedUp++;
+                        continue;
+                    }
+                    EXPECT(false, "blend %d -> %d at %u of %u ms is %u, got %u",
+                        start, end, remaining, coolDown, old, blended.r);
+                }
+            }
+        }
+    }
+    printf("blend: %d of %d differ from the float blend, all on a whole number\n", roundedUp, checked);
+}
+
+int main() {
+    checkScenario();
+    checkBrightness();
+    checkBlend();
+
+    return TEST_RESULT("animation_station_test");
+}
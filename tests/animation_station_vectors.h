@@ -0,0 +1,74 @@
+#ifndef _ANIMATION_STATION_VECTORS_H_
+#define _ANIMATION_STATION_VECTORS_H_
+
+// Segment hashes from scenarioHashes() in animation_station_scenario.h, recorded with the
+// AnimationStation sources from before the pixel table was flattened: float brightness and
+// blending, nested pixel vectors and map based fade timers. Every effect in turn, brightness
+// 0 to 5 for each, SCENARIO_FRAMES / SCENARIO_SEGMENT_FRAMES hashes per brightness.
+
+#include <stdint.h>
+
+static const uint32_t animationStationHashes[] = {
+    0xe4b75d65, 0xe4b75d65, 0xe4b75d65, 0xe4b75d65, 0xe4b75d65, 0xe4b75d65,
+    0xe4b75d65, 0xe4b75d65, 0xe4b75d65, 0xe4b75d65, 0xe4b75d65, 0xe4b75d65,
+    0x235d1565, 0x1270bb65, 0xf8136b65, 0xaa0d6765, 0x9e37ed65, 0xd26b1539,
+    0x32399823, 0x6b3624f1, 0x8ec17831, 0x16ede68d, 0x10d343e5, 0xf66c42e1,
+    0x16b70565, 0xbec30f65, 0x036e6165, 0x1e706565, 0xf2515765, 0xf5e73965,
+    0x56d73d65, 0xd0190439, 0xe425ca59, 0x579bf53b, 0x3f5ab6f9, 0x608a701f,
+    0x449af965, 0x4bf7a965, 0x44449d65, 0xee77a965, 0xfbce2965, 0x485f2565,
+    0xf9acb565, 0xf1839d65, 0xf1a9ab93, 0xa0441003, 0xd8ae23c3, 0x46a0bf4f,
+    0x208af765, 0x1bed0165, 0x82e9e165, 0xe6e13d65, 0xa08f9365, 0x1cbe8b65,
+    0x8326df65, 0xd84b2b65, 0x1738d0f3, 0x8e6945bd, 0xae036f09, 0x62acde57,
+    0x7f1cf565, 0xd80d9565, 0x6eaa7b65, 0x9e4e9165, 0x2807b565, 0x065a7965,
+    0xc4c1c365, 0xe4b75d65, 0xe4b75d65, 0xe4b75d65, 0xe4b75d65, 0xe4b75d65,
+    0xe4b75d65, 0xe4b75d65, 0xe4b75d65, 0xe4b75d65, 0xe4b75d65, 0xe4b75d65,
+    0xe4b75d65, 0xe4b75d65, 0x35a28c21, 0xbe812765, 0xd921350f, 0xa0f57d3d,
+    0xc1c84565, 0x06b80965, 0xe4b40b65, 0x8ff1c365, 0x9c2d6565, 0xe4b75d65,
+    0x96c20997, 0xd7afb2cb, 0xe4b75d65, 0xe4b75d65, 0xe4b75d65, 0xe4b75d65,
+    0x6d0b2765, 0x98c2a565, 0xb98ecf65, 0xe3fb4d65, 0x8dbff533, 0x68849ed7,
+    0xa7a74fbb, 0x54e99d09, 0xec4146eb, 0x81822e0d, 0x89bc0b3d, 0xe4b75d65,
+    0xf7b11b65, 0x1a586165, 0x3dc2a565, 0x2b258565, 0xa4774d65, 0x2c64cb21,
+    0x85af5871, 0xcf731145, 0xc9ab72b5, 0xd35fcea7, 0x2bcf3049, 0x78880bed,
+    0x789ad165, 0x51cd9b65, 0x3be4b965, 0x1c242965, 0x35657565, 0x48f7166b,
+    0x14052501, 0x6f1b268d, 0x603ecd57, 0x24ee7949, 0x629dfacf, 0x3b4b71af,
+    0x34d34f65, 0x4dd7ef65, 0xf7617165, 0xdf2ab965, 0x9dad2765, 0xfff59349,
+    0x65b631f7, 0xda3af107, 0x37360d61, 0xa27bb0c3, 0xedb320f9, 0x1900e77d,
+    0xe4b75d65, 0xe4b75d65, 0xe4b75d65, 0xe4b75d65, 0xe4b75d65, 0xe4b75d65,
+    0xe4b75d65, 0x14047e11, 0x5603ac31, 0x4299e789, 0x6cf0a58d, 0xe4b75d65,
+    0xbc4baf65, 0x17f99365, 0xb6134965, 0x2fbdef65, 0x462edf65, 0xf878cb65,
+    0x59f3d565, 0x44d46365, 0xcac38d65, 0xd2d8db0d, 0x04de227f, 0x96b5635d,
+    0x8eab3565, 0x585f7365, 0x29732765, 0xcdb31565, 0x1ced7565, 0x43c03365,
+    0xfb54ce71, 0x8103a331, 0x51a2df15, 0xdb6b48e1, 0x05f9f33b, 0x42b39877,
+    0x39a1ab65, 0x1bc8fb65, 0x792b5565, 0x69f33f65, 0x0e911965, 0x69b87765,
+    0xf3396765, 0x108e6165, 0x2ab75565, 0x513b4365, 0x019b1f65, 0x7bee3f65,
+    0x9a702d65, 0x7f02c565, 0x0519ab65, 0x4cf78565, 0xb8965165, 0x4a510565,
+    0xca0e9365, 0x76b23765, 0x0f164965, 0x92a06a8d, 0x0b4b627d, 0x7469ee11,
+    0x7a138565, 0xb7671165, 0x561d8d65, 0xad210f65, 0x59968365, 0x05f5660d,
+    0xa4ef700d, 0x6470c8df, 0x1997527b, 0x3cefd93d, 0x39bdc1cb, 0x082c556b,
+    0xe4b75d65, 0xe4b75d65, 0xe4b75d65, 0x2442322d, 0x162501d3, 0x4911addb,
+    0xc4520fdd, 0x0e1ca2d9, 0x78cf273b, 0xe4b75d65, 0xe4b75d65, 0xe4b75d65,
+    0xcd828cf7, 0x46a01e5f, 0x528bee5d, 0xafea37b9, 0xea1559f9, 0x58770aa3,
+    0xcbb3fa27, 0xdc9aa1b9, 0x77ee9a17, 0xe4b75d65, 0xe4b75d65, 0xe4b75d65,
+    0x42383183, 0xd24520c7, 0xc554502b, 0xaa1524cd, 0x843d7f13, 0xa03bcc79,
+    0x46f3d7fb, 0x8fc9b489, 0xe3a51037, 0x3b6dc6c1, 0xbb9ff4fb, 0x46738fbb,
+    0xfc4e58d3, 0xbc603d25, 0x1b5f3ebd, 0xf7d00bff, 0x25175579, 0x5e47b0c7,
+    0x84fad965, 0x728fd84f, 0x7ef23e79, 0x623233c1, 0x59137d35, 0x41fa8537,
+    0x0e310973, 0x6caf8c25, 0x959ffafd, 0x8a441c7d, 0xb5d761bd, 0x97af712d,
+    0xb98f4411, 0x911c2c89, 0x5428920b, 0x24c5ed2f, 0x51b0d8d9, 0xb57894f3,
+    0xff0ad4d3, 0xcd941af1, 0xfc6844f3, 0xfb1a5693, 0x358b923f, 0x4d8f6055,
+    0x34a25b33, 0x51ec354f, 0xdb3019f7, 0xf7933a29, 0xbb388fc3, 0xc74bee19,
+    0x60dcc637, 0x445fc32b, 0xc2418be9, 0xbfb03697, 0xa8e60713, 0x4af58ce3,
+    0x0b6c7435, 0xe34e16d7, 0xa077e507, 0xd2f40ffb, 0x49a23cb3, 0x27868457,
+    0x5a7f534b, 0x8839a645, 0x26e05085, 0xd1432df9, 0x462bf535, 0xe9be78e1,
+    0x6b0f144f, 0xf4e30c6d, 0xc3a969d3, 0xfe3c8197, 0x21b8c057, 0x70a32fc3,
+    0xa8b48a19, 0xead5df95, 0xfd61a7e1, 0x6160f465, 0x50bc1ea9, 0x065eef87,
+    0x82a6ec19, 0x56048221, 0xd958e2b3, 0x879ea60b, 0x215cc71b, 0x97a8c76d,
+    0x438b4483, 0xc47cd093, 0xb4fe5b2d, 0x87ed204d, 0x252e731b, 0xee763875,
+    0xd6176c53, 0xe35d0f41, 0x305853e3, 0x370ceb65, 0xb16f7d79, 0x359e856b,
+    0x020936f1, 0xf130cf17, 0xa55a712f, 0xb3d48a3b, 0x3b8fbbd5, 0xa0807e03,
+    0xd41592ff, 0x134a7a75, 0xc44578c7, 0x7e9c5e07, 0x08349873, 0xe07eb0b5,
+    0x10e562ff, 0x833eca41, 0x8bb45b45, 0x5d08b633, 0x88cf468f, 0xcff82a39,
+    0xd8531d9f, 0x371e5ba3, 0x97318635, 0x0c6730ad, 0x4b3c273f, 0xee933d13,
+};
+
+#endif
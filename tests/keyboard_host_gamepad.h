@@ -0,0 +1,56 @@
+#ifndef _GAMEPAD_H_
+#define _GAMEPAD_H_
+
+// Stands in for headers/gamepad.h and storagemanager.h in keyboard_host_listener_test, both
+// need the generated config to build. Force-included, so their include guards keep the real
+// ones out. Only the fields the keyboard host listener reads are here.
+
+#include <stdint.h>
+#include <string.h>
+
+#include "gamepad/GamepadState.h"
+#include "gamepad/GamepadAuxState.h"
+
+class Gamepad {
+public:
+    GamepadState state;
+    GamepadAuxState auxState;
+    bool hasAnalogTriggers {false};
+};
+
+#endif
+
+#ifndef STORAGE_H_
+#define STORAGE_H_
+
+struct KeyboardMapping {
+    uint32_t keyDpadUp, keyDpadDown, keyDpadLeft, keyDpadRight;
+    uint32_t keyButtonB1, keyButtonB2, keyButtonB3, keyButtonB4;
+    uint32_t keyButtonL1, keyButtonR1, keyButtonL2, keyButtonR2;
+    uint32_t keyButtonS1, keyButtonS2, keyButtonL3, keyButtonR3;
+    uint32_t keyButtonA1, keyButtonA2, keyButtonA3, keyButtonA4;
+};
+
+struct KeyboardHostOptions {
+    KeyboardMapping mapping;
+    uint32_t mouseLeft, mouseMiddle, mouseRight;
+};
+
+struct AddonOptions {
+    KeyboardHostOptions keyboardHostOptions;
+};
+
+class Storage {
+public:
+    static Storage& getInstance() {
+        static Storage instance;
+        return instance;
+    }
+    AddonOptions& getAddonOptions() { return addonOptions; }
+    Gamepad* GetGamepad() { return &gamepad; }
+
+    AddonOptions addonOptions {};
+    Gamepad gamepad;
+};
+
+#endif
@@ -0,0 +1,300 @@
+// Mounts host keyboards with a boot keyboard descriptor and with NKRO bitmap descriptors, feeds
+// them reports of random key sets and checks the gamepad inputs against the configured mapping,
+// and that only the NKRO keyboards are switched over to report protocol.
+
+#include "addons/keyboard_host_listener.h"
+#include "class/hid/hid_host.h"
+
+#include "testing.h"
+
+#include <algorithm>
+#include <random>
+#include <set>
+#include <vector>
+
+static const uint8_t DEV_ADDR = 1, INSTANCE = 0;
+
+// TinyUSB's boot keyboard: modifier bitmap, reserved byte, LED outputs, six keycode array
+static const uint8_t bootDescriptor[] = {
+    0x05, 0x01, 0x09, 0x06, 0xA1, 0x01,
+    0x05, 0x07, 0x19, 0xE0, 0x29, 0xE7, 0x15, 0x00, 0x25, 0x01, 0x95, 0x08, 0x75, 0x01, 0x81, 0x02,
+    0x95, 0x01, 0x75, 0x08, 0x81, 0x01,
+    0x05, 0x08, 0x19, 0x01, 0x29, 0x05, 0x95, 0x05, 0x75, 0x01, 0x91, 0x02,
+    0x95, 0x01, 0x75, 0x03, 0x91, 0x01,
+    0x05, 0x07, 0x19, 0x00, 0x2A, 0xFF, 0x00, 0x15, 0x00, 0x26, 0xFF, 0x00, 0x95, 0x06, 0x75, 0x08, 0x81, 0x00,
+    0xC0,
+};
+
+// Report ID 1: modifier bitmap, reserved byte, LED outputs, a bitmap of keycodes 0x00-0x77.
+// Report ID 2: a consumer control collection on the same interface.
+static const uint8_t nkroDescriptor[] = {
+    0x05, 0x01, 0x09, 0x06, 0xA1, 0x01, 0x85, 0x01,
+    0x05, 0x07, 0x19, 0xE0, 0x29, 0xE7, 0x15, 0x00, 0x25, 0x01, 0x95, 0x08, 0x75, 0x01, 0x81, 0x02,
+    0x95, 0x01, 0x75, 0x08, 0x81, 0x01,
+    0x05, 0x08, 0x19, 0x01, 0x29, 0x05, 0x95, 0x05, 0x75, 0x01, 0x91, 0x02,
+    0x95, 0x01, 0x75, 0x03, 0x91, 0x01,
+    0x05, 0x07, 0x19, 0x00, 0x29, 0x77, 0x15, 0x00, 0x25, 0x01, 0x95, 0x78, 0x75, 0x01, 0x81, 0x02,
+    0xC0,
+    0x05, 0x0C, 0x09, 0x01, 0xA1, 0x01, 0x85, 0x02,
+    0x19, 0x00, 0x2A, 0x3C, 0x02, 0x15, 0x00, 0x26, 0x3C, 0x02, 0x95, 0x01, 0x75, 0x10, 0x81, 0x00,
+    0xC0,
+};
+static const uint8_t NKRO_BITMAP_KEYS = 0x78;
+
+// No report IDs: the boot layout first, then a bitmap of keycodes 0x04-0x6B
+static const uint8_t hybridDescriptor[] = {
+    0x05, 0x01, 0x09, 0x06, 0xA1, 0x01,
+    0x05, 0x07, 0x19, 0xE0, 0x29, 0xE7, 0x15, 0x00, 0x25, 0x01, 0x95, 0x08, 0x75, 0x01, 0x81, 0x02,
+    0x95, 0x01, 0x75, 0x08, 0x81, 0x01,
+    0x05, 0x07, 0x19, 0x00, 0x2A, 0xFF, 0x00, 0x15, 0x00, 0x26, 0xFF, 0x00, 0x95, 0x06, 0x75, 0x08, 0x81, 0x00,
+    0x05, 0x07, 0x19, 0x04, 0x29, 0x6B, 0x15, 0x00, 0x25, 0x01, 0x95, 0x68, 0x75, 0x01, 0x81, 0x02,
+    0xC0,
+};
+static const uint8_t HYBRID_BITMAP_MIN = 0x04, HYBRID_BITMAP_KEYS = 0x68;
+
+struct MappedKey {
+    uint32_t KeyboardMapping::* key;
+    uint8_t keycode;
+    uint8_t dpad;
+    uint32_t buttons;
+};
+
+// Modifiers, a key two inputs share, keys at both ends of the NKRO bitmap
+static const MappedKey mappedKeys[] = {
+    { &KeyboardMapping::keyDpadUp, 0x1A, GAMEPAD_MASK_UP, 0 },        // W
+    { &KeyboardMapping::keyDpadDown, 0x16, GAMEPAD_MASK_DOWN, 0 },    // S
+    { &KeyboardMapping::keyDpadLeft, 0x04, GAMEPAD_MASK_LEFT, 0 },    // A
+    { &KeyboardMapping::keyDpadRight, 0x07, GAMEPAD_MASK_RIGHT, 0 },  // D
+    { &KeyboardMapping::keyButtonB1, 0x0D, 0, GAMEPAD_MASK_B1 },      // J
+    { &KeyboardMapping::keyButtonB2, 0x0E, 0, GAMEPAD_MASK_B2 },      // K
+    { &KeyboardMapping::keyButtonB3, 0x0C, 0, GAMEPAD_MASK_B3 },      // I
+    { &KeyboardMapping::keyButtonB4, 0x12, 0, GAMEPAD_MASK_B4 },      // O
+    { &KeyboardMapping::keyButtonL1, 0x2C, 0, GAMEPAD_MASK_L1 },      // Space
+    { &KeyboardMapping::keyButtonR1, 0x77, 0, GAMEPAD_MASK_R1 },      // Select, last bitmap key
+    { &KeyboardMapping::keyButtonL2, 0xE1, 0, GAMEPAD_MASK_L2 },      // left shift
+    { &KeyboardMapping::keyButtonR2, 0xE7, 0, GAMEPAD_MASK_R2 },      // right GUI
+    { &KeyboardMapping::keyButtonS1, 0x2B, 0, GAMEPAD_MASK_S1 },      // Tab
+    { &KeyboardMapping::keyButtonS2, 0x28, 0, GAMEPAD_MASK_S2 },      // Enter
+    { &KeyboardMapping::keyButtonL3, 0xE0, 0, GAMEPAD_MASK_L3 },      // left control
+    { &KeyboardMapping::keyButtonR3, 0x64, 0, GAMEPAD_MASK_R3 },      // non-US backslash
+    { &KeyboardMapping::keyButtonA1, 0x0D, 0, GAMEPAD_MASK_A1 },      // J, shared with B1
+    { &KeyboardMapping::keyButtonA2, 0x3A, 0, GAMEPAD_MASK_A2 },      // F1
+    // A3 and A4 keys are stored but have never driven an input from a host keyboard
+    { &KeyboardMapping::keyButtonA3, 0x3B, 0, 0 },                    // F2
+    { &KeyboardMapping::keyButtonA4, 0x3C, 0, 0 },                    // F3
+};
+
+static std::mt19937 randomEngine(42);
+
+static void configure() {
+    KeyboardHostOptions& options = Storage::getInstance().getAddonOptions().keyboardHostOptions;
+    options = {};
+    for (const MappedKey& mapped : mappedKeys)
+        options.mapping.*mapped.key = mapped.keycode;
+}
+
+static void expectedInputs(const std::set<uint8_t>& keys, uint8_t& dpad, uint32_t& buttons) {
+    dpad = 0;
+    buttons = 0;
+    for (const MappedKey& mapped : mappedKeys) {
+        if (keys.count(mapped.keycode)) {
+            dpad |= mapped.dpad;
+            buttons |= mapped.buttons;
+        }
+    }
+}
+
+static std::string describe(const std::set<uint8_t>& keys) {
+    std::string text;
+    char key[8];
+    for (uint8_t keycode : keys) {
+        snprintf(key, sizeof(key), " %02X", keycode);
+        text += key;
+    }
+    return text.empty() ? " none" : text;
+}
+
+// Sends a report and runs the core0 side over a released gamepad
+static void sendReport(KeyboardHostListener& listener, const std::vector<uint8_t>& report) {
+    listener.report_received(DEV_ADDR, INSTANCE, report.data(), report.size());
+    Gamepad* gamepad = Storage::getInstance().GetGamepad();
+    gamepad->state.dpad = 0;
+    gamepad->state.buttons = 0;
+    listener.process();
+}
+
+static void expectKeys(const std::set<uint8_t>& keys, const char* what) {
+    uint8_t dpad;
+    uint32_t buttons;
+    expectedInputs(keys, dpad, buttons);
+    const GamepadState& state = Storage::getInstance().GetGamepad()->state;
+    EXPECT(state.dpad == dpad && state.buttons == buttons, "%s keys%s: dpad %02x buttons %05x, got %02x %05x",
+        what, describe(keys).c_str(), dpad, buttons, state.dpad, state.buttons);
+}
+
+static std::vector<uint8_t> bootReport(const std::set<uint8_t>& keys) {
+    std::vector<uint8_t> report(sizeof(hid_keyboard_report_t));
+    size_t slot = 2;
+    for (uint8_t keycode : keys) {
+        if (keycode >= HID_KEY_CONTROL_LEFT)
+            report[0] |= 1 << (keycode - HID_KEY_CONTROL_LEFT);
+        else if (slot < report.size())
+            report[slot++] = keycode;
+    }
+    // keyboards fill the slots in press order, not sorted
+    std::shuffle(report.begin() + 2, report.end(), randomEngine);
+    return report;
+}
+
+// Up to maxKeys keys, picked from the mapped ones and the rest of the keycodes, modifiers included
+static std::set<uint8_t> randomKeys(size_t maxKeys, uint8_t minKey, uint8_t maxKey) {
+    std::set<uint8_t> keys;
+    size_t count = randomEngine() % (maxKeys + 1);
+    while (keys.size() < count) {
+        uint8_t keycode;
+        switch (randomEngine() % 3) {
+            case 0: keycode = mappedKeys[randomEngine() % (sizeof(mappedKeys) / sizeof(mappedKeys[0]))].keycode; break;
+            case 1: keycode = HID_KEY_CONTROL_LEFT + randomEngine() % 8; break;
+            default: keycode = minKey + randomEngine() % (maxKey - minKey + 1); break;
+        }
+        if (keycode < HID_KEY_CONTROL_LEFT && (keycode < minKey || keycode > maxKey))
+            continue;
+        keys.insert(keycode);
+    }
+    return keys;
+}
+
+static size_t nonModifiers(const std::set<uint8_t>& keys) {
+    size_t count = 0;
+    for (uint8_t keycode : keys)
+        count += keycode < HID_KEY_CONTROL_LEFT;
+    return count;
+}
+
+static void mountKeyboard(KeyboardHostListener& listener, const uint8_t* descriptor, uint16_t length) {
+    configure();
+    listener.setup();
+    host_hid_itf_protocol = HID_ITF_PROTOCOL_KEYBOARD;
+    host_hid_protocol = HID_PROTOCOL_BOOT;
+    host_hid_set_protocol_calls = 0;
+    listener.mount(DEV_ADDR, INSTANCE, descriptor, length);
+}
+
+static void checkBootKeyboard() {
+    KeyboardHostListener listener;
+    mountKeyboard(listener, bootDescriptor, sizeof(bootDescriptor));
+    EXPECT(host_hid_set_protocol_calls == 0, "a boot keyboard stays in boot protocol");
+
+    for (const MappedKey& mapped : mappedKeys) {
+        std::set<uint8_t> keys = { mapped.keycode };
+        sendReport(listener, bootReport(keys));
+        expectKeys(keys, "boot");
+    }
+    for (int i = 0; i < 20000; i++) {
+        std::set<uint8_t> keys = randomKeys(14, 0x04, 0xDF);
+        while (nonModifiers(keys) > 6)
+            keys.erase(std::find_if(keys.begin(), keys.end(), [](uint8_t k) { return k < HID_KEY_CONTROL_LEFT; }));
+        sendReport(listener, bootReport(keys));
+        expectKeys(keys, "boot");
+    }
+
+    listener.unmount(DEV_ADDR);
+    sendReport(listener, bootReport({ 0x1A }));
+    expectKeys({}, "unmounted boot keyboard");
+}
+
+static std::vector<uint8_t> nkroReport(const std::set<uint8_t>& keys) {
+    std::vector<uint8_t> report(3 + NKRO_BITMAP_KEYS / 8);
+    report[0] = 1;
+    for (uint8_t keycode : keys) {
+        if (keycode >= HID_KEY_CONTROL_LEFT)
+            report[1] |= 1 << (keycode - HID_KEY_CONTROL_LEFT);
+        else
+            report[3 + keycode / 8] |= 1 << (keycode % 8);
+    }
+    return report;
+}
+
+static void checkNKROKeyboard() {
+    KeyboardHostListener listener;
+    mountKeyboard(listener, nkroDescriptor, sizeof(nkroDescriptor));
+    EXPECT(host_hid_set_protocol_calls == 1 && host_hid_protocol == HID_PROTOCOL_REPORT,
+        "an NKRO keyboard is switched to report protocol");
+
+    for (const MappedKey& mapped : mappedKeys) {
+        std::set<uint8_t> keys = { mapped.keycode };
+        sendReport(listener, nkroReport(keys));
+        expectKeys(keys, "NKRO");
+    }
+
+    // Every mapped key at once, more than boot protocol can carry
+    std::set<uint8_t> allKeys;
+    for (const MappedKey& mapped : mappedKeys)
+        allKeys.insert(mapped.keycode);
+    sendReport(listener, nkroReport(allKeys));
+    expectKeys(allKeys, "NKRO");
+
+    for (int i = 0; i < 20000; i++) {
+        std::set<uint8_t> keys = randomKeys(40, 0x04, NKRO_BITMAP_KEYS - 1);
+        sendReport(listener, nkroReport(keys));
+        expectKeys(keys, "NKRO");
+    }
+
+    // A consumer key report leaves the keyboard state alone
+    std::set<uint8_t> held = { 0x1A, 0x0D };
+    sendReport(listener, nkroReport(held));
+    sendReport(listener, { 2, 0xE9, 0x00 });
+    expectKeys(held, "consumer report after");
+
+    // A report cut short reads the keys it carries
+    std::vector<uint8_t> report = nkroReport({ 0x04, 0x77 });
+    report.pop_back();
+    sendReport(listener, report);
+    expectKeys({ 0x04 }, "short NKRO report");
+
+    // Still in boot protocol (the switch failed), reports are decoded as boot reports
+    host_hid_protocol = HID_PROTOCOL_BOOT;
+    std::set<uint8_t> keys = { 0x16, 0xE1 };
+    sendReport(listener, bootReport(keys));
+    expectKeys(keys, "boot protocol NKRO keyboard");
+}
+
+static std::vector<uint8_t> hybridReport(const std::set<uint8_t>& arrayKeys, const std::set<uint8_t>& bitmapKeys) {
+    std::vector<uint8_t> report = bootReport(arrayKeys);
+    report.resize(8 + HYBRID_BITMAP_KEYS / 8);
+    for (uint8_t keycode : bitmapKeys) {
+        if (keycode >= HID_KEY_CONTROL_LEFT) {
+            report[0] |= 1 << (keycode - HID_KEY_CONTROL_LEFT);
+        } else {
+            uint8_t bit = keycode - HYBRID_BITMAP_MIN;
+            report[8 + bit / 8] |= 1 << (bit % 8);
+        }
+    }
+    return report;
+}
+
+static void checkHybridKeyboard() {
+    KeyboardHostListener listener;
+    mountKeyboard(listener, hybridDescriptor, sizeof(hybridDescriptor));
+    EXPECT(host_hid_set_protocol_calls == 1, "a keyboard with a bitmap after the boot layout is switched to report protocol");
+
+    const uint8_t maxKey = HYBRID_BITMAP_MIN + HYBRID_BITMAP_KEYS - 1;
+    for (int i = 0; i < 20000; i++) {
+        std::set<uint8_t> arrayKeys = randomKeys(6, 0x04, maxKey);
+        std::set<uint8_t> bitmapKeys = randomKeys(30, 0x04, maxKey);
+        while (nonModifiers(arrayKeys) > 6)
+            arrayKeys.erase(std::find_if(arrayKeys.begin(), arrayKeys.end(), [](uint8_t k) { return k < HID_KEY_CONTROL_LEFT; }));
+        sendReport(listener, hybridReport(arrayKeys, bitmapKeys));
+        std::set<uint8_t> keys = arrayKeys;
+        keys.insert(bitmapKeys.begin(), bitmapKeys.end());
+        expectKeys(keys, "hybrid");
+    }
+}
+
+int main() {
+    checkBootKeyboard();
+    checkNKROKeyboard();
+    checkHybridKeyboard();
+
+    return TEST_RESULT("keyboard_host_listener_test");
+}
@@ -0,0 +1,204 @@
+// Runs the rotary encoder's PIO quadrature program on a cycle-level model of one state
+// machine and checks the count it pushes for every pin transition, for long walks with
+// the slowest legal edge spacing, and for contact bounce.
+
+#include <cstdint>
+#include <cstdlib>
+#include <deque>
+
+#define PICO_NO_HARDWARE 1
+#include "addons/generated/quadrature_encoder.pio.h"
+
+#include "testing.h"
+
+// Only the instructions the quadrature program uses are modelled
+class StateMachine {
+public:
+    uint8_t pins = 0; // bit 0 is phase A (base pin), bit 1 is phase B
+    std::deque<uint32_t> rxFifo;
+
+    // What quadrature_encoder_program_init() runs before enabling the state machine
+    void start() {
+        exec(0x4002); // in pins, 2
+        exec(0xa0e6); // mov osr, isr
+    }
+
+    void step() {
+        pc = exec(quadrature_encoder_program_instructions[pc]);
+    }
+
+    uint8_t exec(uint16_t instr) {
+        uint8_t next = (pc == quadrature_encoder_wrap) ? quadrature_encoder_wrap_target : pc + 1;
+        uint8_t arg1 = (instr >> 5) & 7;
+        uint8_t arg2 = instr & 0x1f;
+        switch (instr >> 13) {
+            case 0: // JMP, always or Y--
+                if (arg1 == 0) {
+                    next = arg2;
+                } else if (arg1 == 4) {
+                    if (y != 0) next = arg2;
+                    y--;
+                } else {
+                    unsupported(instr);
+                }
+                break;
+            case 2: // IN PINS, left shift
+                if (arg1 != 0) unsupported(instr);
+                isr = (isr << arg2) | (pins & ((1u << arg2) - 1));
+                break;
+            case 3: // OUT ISR, right shift
+                if (arg1 != 6) unsupported(instr);
+                isr = osr & ((1u << arg2) - 1);
+                osr >>= arg2;
+                break;
+            case 4: // PUSH noblock, dropped when the joined FIFO is full
+                if (instr != 0x8000) unsupported(instr);
+                if (rxFifo.size() < 8) rxFifo.push_back(isr);
+                isr = 0;
+                pushes++;
+                break;
+            case 5: { // MOV
+                uint8_t source = instr & 7;
+                uint32_t value = (source == 2) ? y : (source == 6) ? isr : unsupported(instr);
+                if (((instr >> 3) & 3) == 1) value = ~value;
+                switch (arg1) {
+                    case 2: y = value; break;
+                    case 5: next = value & 0x1f; break;
+                    case 6: isr = value; break;
+                    case 7: osr = value; break;
+                    default: unsupported(instr);
+                }
+                break;
+            }
+            default:
+                unsupported(instr);
+        }
+        return next;
+    }
+
+    void run(int cycles) {
+        for (int i = 0; i < cycles; i++)
+            step();
+    }
+
+    // quadrature_encoder_get_count(): drain the FIFO, then wait for a fresh push
+    int32_t getCount() {
+        rxFifo.clear();
+        uint32_t before = pushes;
+        while (pushes == before)
+            step();
+        int32_t count = (int32_t)rxFifo.back();
+        rxFifo.clear();
+        return count;
+    }
+
+    uint32_t pushes = 0;
+private:
+    uint8_t pc = 0;
+    uint32_t isr = 0, osr = 0, y = 0;
+
+    uint32_t unsupported(uint16_t instr) {
+        printf("unsupported instruction %04x at %u\n", instr, pc);
+        exit(1);
+    }
+};
+
+// One pass of the sampling loop is at most 10 cycles, an edge held that long is never missed
+static const int LOOP_CYCLES = 10;
+
+// Phase A leading B: 00 -> 01 -> 11 -> 10, every edge counts down
+static const uint8_t gray[4] = { 0, 1, 3, 2 };
+
+static int grayIndex(uint8_t pins) {
+    for (int i = 0; i < 4; i++)
+        if (gray[i] == pins) return i;
+    return -1;
+}
+
+static int32_t expectedDelta(uint8_t from, uint8_t to) {
+    int steps = (grayIndex(to) - grayIndex(from) + 4) % 4;
+    return (steps == 1) ? -1 : (steps == 3) ? 1 : 0; // 2 is a skipped state, not counted
+}
+
+static void checkTransitions() {
+    for (uint8_t from = 0; from < 4; from++) {
+        for (uint8_t to = 0; to < 4; to++) {
+            StateMachine sm;
+            sm.pins = from;
+            sm.start();
+            sm.run(LOOP_CYCLES * 2);
+            int32_t start = sm.getCount();
+            EXPECT(start == 0, "starting on pins %u reads 0, got %d", from, start);
+            sm.pins = to;
+            sm.run(LOOP_CYCLES);
+            int32_t delta = sm.getCount() - start;
+            EXPECT(delta == expectedDelta(from, to), "pins %u -> %u moves the count by %d, got %d",
+                from, to, expectedDelta(from, to), delta);
+        }
+    }
+}
+
+static void checkRandomWalk() {
+    srand(1);
+    StateMachine sm;
+    sm.start();
+    int32_t expected = 0;
+    int position = 0;
+    for (int i = 0; i < 100000; i++) {
+        int move = (rand() % 3) - 1;
+        position = (position + move + 4) % 4;
+        expected -= move;
+        sm.pins = gray[position];
+        sm.run(LOOP_CYCLES + (rand() % 20));
+        if ((i % 997) == 0) {
+            int32_t count = sm.getCount();
+            EXPECT(count == expected, "count after %d random steps is %d, got %d", i + 1, expected, count);
+        }
+    }
+    int32_t count = sm.getCount();
+    EXPECT(count == expected, "count after the random walk is %d, got %d", expected, count);
+}
+
+static void checkRotations() {
+    // Whole cycles in each direction, rotaryencoder.cpp halves the count to two steps per cycle
+    StateMachine sm;
+    sm.start();
+    for (int cycle = 0; cycle < 50; cycle++) {
+        for (int edge = 1; edge <= 4; edge++) {
+            sm.pins = gray[edge % 4];
+            sm.run(LOOP_CYCLES);
+        }
+    }
+    int32_t count = sm.getCount();
+    EXPECT(count == -200 && (count >> 1) == -100, "50 cycles with A leading count -200, got %d", count);
+
+    for (int cycle = 0; cycle < 75; cycle++) {
+        for (int edge = 3; edge >= 0; edge--) {
+            sm.pins = gray[edge];
+            sm.run(LOOP_CYCLES);
+        }
+    }
+    count = sm.getCount();
+    EXPECT(count == 100 && (count >> 1) == 50, "75 cycles back with B leading count 100, got %d", count);
+}
+
+static void checkBounce() {
+    // Phase A chattering on an edge settles to a single step
+    StateMachine sm;
+    sm.start();
+    for (int bounce = 0; bounce < 9; bounce++) {
+        sm.pins = (bounce & 1) ? 0 : 1;
+        sm.run(LOOP_CYCLES);
+    }
+    int32_t count = sm.getCount();
+    EXPECT(count == -1, "bouncing 00/01 ending on 01 counts -1, got %d", count);
+}
+
+int main() {
+    checkTransitions();
+    checkRandomWalk();
+    checkRotations();
+    checkBounce();
+
+    return TEST_RESULT("quadrature_encoder_test");
+}
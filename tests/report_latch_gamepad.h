@@ -0,0 +1,19 @@
+#ifndef _GAMEPAD_H_
+#define _GAMEPAD_H_
+
+// Stands in for headers/gamepad.h in report_latch_test, which needs the generated config
+// to build. Force-included, so its include guard keeps gpdriver.h from pulling in the real one.
+
+#include <stdint.h>
+
+#include "gamepad/GamepadState.h"
+
+extern uint32_t getMillis();
+
+class Gamepad {
+public:
+    GamepadState state;
+    bool fourWayDpad {false};
+};
+
+#endif
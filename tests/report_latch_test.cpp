@@ -0,0 +1,256 @@
+// Simulates the report latch in GPDriver against a host that polls the IN endpoint on a
+// fixed interval, with a driver that queues a report whenever it changed and the endpoint
+// is free, as the HID-style drivers do. Checks the guarantees listed in gpdriver.h: taps
+// pressed two polls after the input last changed all arrive, nothing is reported that did not
+// happen, 4-way dpads never report diagonals, and edges behind a stalled endpoint are not
+// replayed once it frees up.
+
+#include "gpdriver.h"
+#include "system.h"
+
+#include "testing.h"
+
+#include <random>
+#include <vector>
+
+static uint64_t nowUs = 0;
+
+uint32_t getMillis() { return nowUs / 1000; }
+
+void System::markBootTimeline(const char* label) {}
+
+struct Report {
+    uint32_t buttons;
+    uint8_t dpad;
+    bool operator!=(const Report & other) const { return buttons != other.buttons || dpad != other.dpad; }
+};
+
+class SimDriver : public GPDriver {
+public:
+    SimDriver(bool latch) { reportLatchEnabled = latch; }
+
+    virtual void process(Gamepad * gamepad) {
+        Report report = { gamepad->state.buttons, gamepad->state.dpad };
+        if (report != lastReport && !busy) {
+            busy = true;
+            queued = report;
+            lastReport = report;
+            reportSent();
+        }
+    }
+
+    // The host takes the queued report, if there is one
+    bool poll(Report & report) {
+        if (!busy) return false;
+        report = queued;
+        busy = false;
+        return true;
+    }
+
+    virtual void initialize() {}
+    virtual void initializeAux() {}
+    virtual void processAux() {}
+    virtual uint16_t get_report(uint8_t report_id, hid_report_type_t report_type, uint8_t *buffer, uint16_t reqlen) { return 0; }
+    virtual void set_report(uint8_t report_id, hid_report_type_t report_type, uint8_t const *buffer, uint16_t bufsize) {}
+    virtual bool vendor_control_xfer_cb(uint8_t rhport, uint8_t stage, tusb_control_request_t const *request) { return false; }
+    virtual const uint16_t * get_descriptor_string_cb(uint8_t index, uint16_t langid) { return nullptr; }
+    virtual const uint8_t * get_descriptor_device_cb() { return nullptr; }
+    virtual const uint8_t * get_hid_descriptor_report_cb(uint8_t itf) { return nullptr; }
+    virtual const uint8_t * get_descriptor_configuration_cb(uint8_t index) { return nullptr; }
+    virtual const uint8_t * get_descriptor_device_qualifier_cb() { return nullptr; }
+    virtual uint16_t GetJoystickMidValue() { return 0; }
+    virtual USBListener * get_usb_auth_listener() { return nullptr; }
+
+private:
+    bool busy = false;
+    Report queued = {};
+    Report lastReport = {};
+};
+
+static const uint64_t LOOP_US = 100;
+static const uint64_t RUN_US = 60ull * 1000 * 1000;
+static const int BUTTONS = 4;
+static const uint8_t directions[4] = { GAMEPAD_MASK_UP, GAMEPAD_MASK_DOWN, GAMEPAD_MASK_LEFT, GAMEPAD_MASK_RIGHT };
+
+struct Result {
+    int taps = 0;     // presses on the live input (dpad: changes to a direction)
+    int arrived = 0;  // presses the host saw
+    int phantom = 0;  // host presses beyond the live ones, per input
+    int diagonal = 0; // 4-way reports with more than one direction
+    int opposing = 0; // reports with up+down or left+right
+};
+
+// Buttons (or the 4-way dpad) tapped for 1-40 ms, each input pressed again (or the dpad
+// rolled to a new direction) at least minGapPolls host polls after its previous change
+static Result simulate(bool latch, bool fourWay, uint64_t pollUs, int minGapPolls) {
+    std::mt19937 random(pollUs + minGapPolls + fourWay);
+    SimDriver driver(latch);
+    Gamepad gamepad;
+    Result result;
+
+    const int inputs = fourWay ? 1 : BUTTONS;
+    uint64_t nextPress[BUTTONS], release[BUTTONS];
+    bool down[BUTTONS] = {};
+    uint8_t direction = 0;
+    int livePresses[BUTTONS] = {}, hostPresses[BUTTONS] = {};
+    for (int i = 0; i < inputs; i++) {
+        nextPress[i] = random() % 20000;
+        release[i] = 0;
+    }
+
+    Report host = {};
+    for (nowUs = 0; nowUs < RUN_US; nowUs += LOOP_US) {
+        for (int i = 0; i < inputs; i++) {
+            if (down[i] && nowUs >= release[i]) {
+                down[i] = false;
+                if (nextPress[i] < nowUs + minGapPolls * pollUs)
+                    nextPress[i] = nowUs + minGapPolls * pollUs;
+            } else if (nowUs >= nextPress[i] && (fourWay || !down[i]) && nowUs < RUN_US - 100000) {
+                // the dpad sometimes rolls straight from one direction into the next
+                uint8_t next = directions[random() % 4];
+                if (fourWay && down[i] && next == direction) continue;
+                direction = next;
+                down[i] = true;
+                livePresses[i]++;
+                result.taps++;
+                release[i] = nowUs + 1000 + random() % 39000;
+                nextPress[i] = nowUs + minGapPolls * pollUs + random() % 30000;
+            }
+        }
+
+        gamepad.fourWayDpad = fourWay;
+        gamepad.state.buttons = 0;
+        gamepad.state.dpad = 0;
+        if (fourWay) {
+            gamepad.state.dpad = down[0] ? direction : 0;
+        } else {
+            for (int i = 0; i < inputs; i++)
+                if (down[i]) gamepad.state.buttons |= (1u << i);
+        }
+        Report live = { gamepad.state.buttons, gamepad.state.dpad };
+        driver.processLatched(&gamepad);
+        EXPECT(!(live != Report { gamepad.state.buttons, gamepad.state.dpad }), "live state restored after processing");
+
+        Report report;
+        if ((nowUs % pollUs) == 0 && driver.poll(report)) {
+            if (fourWay) {
+                if (report.dpad != host.dpad && report.dpad != 0) hostPresses[0]++;
+                if (report.dpad & (report.dpad - 1)) result.diagonal++;
+            } else {
+                for (int i = 0; i < inputs; i++)
+                    if ((report.buttons & ~host.buttons) & (1u << i)) hostPresses[i]++;
+            }
+            if ((report.dpad & (GAMEPAD_MASK_UP | GAMEPAD_MASK_DOWN)) == (GAMEPAD_MASK_UP | GAMEPAD_MASK_DOWN) ||
+                (report.dpad & (GAMEPAD_MASK_LEFT | GAMEPAD_MASK_RIGHT)) == (GAMEPAD_MASK_LEFT | GAMEPAD_MASK_RIGHT))
+                result.opposing++;
+            host = report;
+        }
+    }
+
+    for (int i = 0; i < inputs; i++) {
+        result.arrived += hostPresses[i];
+        if (hostPresses[i] > livePresses[i]) result.phantom += hostPresses[i] - livePresses[i];
+    }
+    return result;
+}
+
+static void checkTaps() {
+    static const uint64_t polls[] = { 1000, 4000, 8000 };
+    for (uint64_t pollUs : polls) {
+        for (int fourWay = 0; fourWay <= 1; fourWay++) {
+            const char * input = fourWay ? "4-way dpad" : "buttons";
+            Result unlatched = simulate(false, fourWay, pollUs, 2);
+            Result latched = simulate(true, fourWay, pollUs, 2);
+            printf("%s, %u us poll: %d of %d taps arrive, %d without the latch\n",
+                input, (unsigned)pollUs, latched.arrived, latched.taps, unlatched.arrived);
+            EXPECT(latched.arrived == latched.taps, "%s, %u us poll, taps two polls apart: %d of %d arrive",
+                input, (unsigned)pollUs, latched.arrived, latched.taps);
+            EXPECT(latched.phantom == 0 && latched.diagonal == 0 && latched.opposing == 0,
+                "%s, %u us poll: %d phantom presses, %d diagonals, %d opposing reports",
+                input, (unsigned)pollUs, latched.phantom, latched.diagonal, latched.opposing);
+            // A lone dpad mostly finds the endpoint free, four buttons keep it busy
+            if (pollUs == 8000 && !fourWay)
+                EXPECT(unlatched.arrived < unlatched.taps, "buttons without the latch lose taps at an 8 ms poll");
+
+            // Closer taps may merge, but never invent presses or diagonals
+            Result close = simulate(true, fourWay, pollUs, 0);
+            EXPECT(close.phantom == 0 && close.diagonal == 0 && close.opposing == 0,
+                "%s, %u us poll, close taps: %d phantom presses, %d diagonals, %d opposing reports",
+                input, (unsigned)pollUs, close.phantom, close.diagonal, close.opposing);
+        }
+    }
+}
+
+// The case that broke 4-way mode when directions were latched bit by bit: up tapped, then
+// right pressed, while the endpoint was still busy with an earlier report. A 4-way dpad
+// reports up, then right.
+static void checkFourWayRoll() {
+    for (int fourWay = 0; fourWay <= 1; fourWay++) {
+        SimDriver driver(true);
+        Gamepad gamepad;
+        gamepad.fourWayDpad = fourWay;
+        Report report;
+        nowUs = 0;
+
+        gamepad.state.buttons = 1;
+        driver.processLatched(&gamepad);
+        gamepad.state.dpad = GAMEPAD_MASK_UP;
+        driver.processLatched(&gamepad);
+        gamepad.state.dpad = 0;
+        driver.processLatched(&gamepad);
+        gamepad.state.dpad = GAMEPAD_MASK_RIGHT;
+        driver.processLatched(&gamepad);
+
+        driver.poll(report);
+        driver.processLatched(&gamepad);
+        driver.poll(report);
+        if (fourWay) {
+            EXPECT(report.dpad == GAMEPAD_MASK_UP, "4-way up tap then right reports up first, got %02x", report.dpad);
+            driver.processLatched(&gamepad);
+            driver.poll(report);
+            EXPECT(report.dpad == GAMEPAD_MASK_RIGHT, "4-way up tap then right reports right next, got %02x", report.dpad);
+        } else {
+            EXPECT(report.dpad == (GAMEPAD_MASK_UP | GAMEPAD_MASK_RIGHT), "8-way keeps both the up tap and right, got %02x", report.dpad);
+        }
+    }
+}
+
+// A tap behind an endpoint the host stops polling for longer than REPORT_LATCH_TIMEOUT_MS
+// is dropped rather than replayed when polling resumes
+static void checkStall() {
+    for (int fourWay = 0; fourWay <= 1; fourWay++) {
+        SimDriver driver(true);
+        Gamepad gamepad;
+        gamepad.fourWayDpad = fourWay;
+        Report report;
+        nowUs = 0;
+
+        auto set = [&](bool pressed) {
+            gamepad.state.buttons = (!fourWay && pressed) ? 1 : 0;
+            gamepad.state.dpad = (fourWay && pressed) ? GAMEPAD_MASK_LEFT : 0;
+        };
+
+        set(true);
+        driver.processLatched(&gamepad); // queued, the host never takes it during the stall
+        set(false);
+        for (; nowUs < 5000; nowUs += LOOP_US) driver.processLatched(&gamepad);
+        set(true);
+        for (; nowUs < 10000; nowUs += LOOP_US) driver.processLatched(&gamepad);
+        set(false);
+        for (; nowUs < 200000; nowUs += LOOP_US) driver.processLatched(&gamepad);
+
+        driver.poll(report); // the press queued before the stall
+        driver.processLatched(&gamepad);
+        driver.poll(report);
+        EXPECT(report.buttons == 0 && report.dpad == 0,
+            "%s tap during a 200 ms stall is not replayed, got %x/%02x", fourWay ? "4-way" : "button", report.buttons, report.dpad);
+    }
+}
+
+int main() {
+    checkTaps();
+    checkFourWayRoll();
+    checkStall();
+
+    return TEST_RESULT("report_latch_test");
+}
@@ -0,0 +1,217 @@
+// Feeds SNESpad's PIO reader frames through a stubbed RX FIFO, built the way the snespad
+// program shifts them in, and checks the decoded pads, NES pads and mice, the frame
+// requests it writes back, and that it keeps the last frame until a whole one is queued.
+
+#include "SNESpad.h"
+
+#include "testing.h"
+
+#include <cstdlib>
+
+static const uint CLOCK_PIN = 2, LATCH_PIN = 3, DATA_PIN = 4;
+
+// The two words the state machine pushes for one frame: the data line before the latch in
+// bit 31, then 32 bits shifted in from the left so the first bit clocked ends up in bit 0.
+// Inputs are active low on the wire, bit i of logical is the i-th bit clocked, 1 = pressed.
+static void pushFrame(PIO pio, uint sm, uint32_t logical, bool connected = true) {
+    pio->rxFifo[sm].push_back(connected ? 0 : (1u << 31));
+    uint32_t isr = 0;
+    for (int i = 0; i < 32; i++) {
+        uint32_t wire = ((logical >> i) & 1) ^ 1;
+        isr = (isr >> 1) | (wire << 31);
+    }
+    pio->rxFifo[sm].push_back(isr);
+}
+
+static void resetPIO() {
+    for (host_pio_block& block : host_pio_blocks) {
+        uint index = block.index;
+        block = host_pio_block{};
+        block.index = index;
+    }
+}
+
+// begin() waits for the first frame, so queue it before
+static SNESpad* startPad(uint32_t firstFrame) {
+    resetPIO();
+    pushFrame(pio1, 0, firstFrame);
+    SNESpad* pad = new SNESpad(CLOCK_PIN, LATCH_PIN, DATA_PIN);
+    pad->begin();
+    EXPECT(pio1->claimed[0] && pio1->enabled[0], "the reader runs on pio1 sm 0");
+    EXPECT(pio1->txFifo[0].size() == 1 && pio1->txFifo[0].front() == 0, "begin() requests one frame without a speed pulse");
+    pio1->txFifo[0].clear();
+    return pad;
+}
+
+struct PadButton {
+    const char* name;
+    uint32_t bit;
+    bool SNESpad::* flag;
+};
+
+// SNES order on the wire: B, Y, Select, Start, Up, Down, Left, Right, A, X, L, R, then the id
+static const PadButton snesButtons[] = {
+    { "B", 0, &SNESpad::buttonB }, { "Y", 1, &SNESpad::buttonY },
+    { "Select", 2, &SNESpad::buttonSelect }, { "Start", 3, &SNESpad::buttonStart },
+    { "Up", 4, &SNESpad::directionUp }, { "Down", 5, &SNESpad::directionDown },
+    { "Left", 6, &SNESpad::directionLeft }, { "Right", 7, &SNESpad::directionRight },
+    { "A", 8, &SNESpad::buttonA }, { "X", 9, &SNESpad::buttonX },
+    { "L", 10, &SNESpad::buttonL }, { "R", 11, &SNESpad::buttonR },
+};
+
+// NES order: A, B, Select, Start, Up, Down, Left, Right, then the line stays low
+static const PadButton nesButtons[] = {
+    { "A", 0, &SNESpad::buttonA }, { "B", 1, &SNESpad::buttonB },
+    { "Select", 2, &SNESpad::buttonSelect }, { "Start", 3, &SNESpad::buttonStart },
+    { "Up", 4, &SNESpad::directionUp }, { "Down", 5, &SNESpad::directionDown },
+    { "Left", 6, &SNESpad::directionLeft }, { "Right", 7, &SNESpad::directionRight },
+};
+
+template <size_t N>
+static void expectButtons(SNESpad* pad, const PadButton (&buttons)[N], uint32_t pressed, const char* what) {
+    for (const PadButton& button : buttons) {
+        bool expected = (pressed >> button.bit) & 1;
+        EXPECT(pad->*button.flag == expected, "%s: %s reads %d", what, button.name, expected);
+    }
+}
+
+static void checkSNESPad() {
+    SNESpad* pad = startPad(0);
+    pad->poll();
+    EXPECT(pad->type == SNES_PAD_BASIC, "an idle SNES pad is detected, got type %d", pad->type);
+    EXPECT(pio1->txFifo[0].size() == 1 && pio1->txFifo[0].back() == 0, "each frame read requests the next one");
+
+    // Only the first 16 bits make a pad frame, whatever the line does after them is dropped.
+    // An idle pad with the line released after them must not read as an empty frame.
+    srand(32);
+    for (uint32_t upper : { 0x00000000u, 0xFFFF0000u, 0x5A5A0000u }) {
+        pushFrame(pio1, 0, upper);
+        pad->poll();
+        EXPECT(pad->type == SNES_PAD_BASIC, "idle SNES pad with upper bits %08x stays a pad", upper);
+        expectButtons(pad, snesButtons, 0, "idle");
+        for (const PadButton& button : snesButtons) {
+            pushFrame(pio1, 0, (1u << button.bit) | upper);
+            pad->poll();
+            EXPECT(pad->type == SNES_PAD_BASIC, "SNES pad with %s held and upper bits %08x stays a pad", button.name, upper);
+            expectButtons(pad, snesButtons, 1u << button.bit, button.name);
+        }
+    }
+    for (int i = 0; i < 1000; i++) {
+        uint32_t pressed = rand() & 0xFFF;
+        pushFrame(pio1, 0, pressed | ((uint32_t)rand() << 16));
+        pad->poll();
+        expectButtons(pad, snesButtons, pressed, "random SNES buttons");
+    }
+    delete pad;
+}
+
+static void checkNESPad() {
+    // NES pads clock out 8 bits, the line then reads low (pressed) for the rest of the frame
+    const uint32_t tail = 0xFFFFFF00;
+    SNESpad* pad = startPad(tail);
+    pad->poll();
+    EXPECT(pad->type == SNES_PAD_NES, "an idle NES pad is detected, got type %d", pad->type);
+    for (const PadButton& button : nesButtons) {
+        pushFrame(pio1, 0, tail | (1u << button.bit));
+        pad->poll();
+        EXPECT(pad->type == SNES_PAD_NES, "NES pad with %s held stays an NES pad", button.name);
+        expectButtons(pad, nesButtons, 1u << button.bit, button.name);
+        EXPECT(!pad->buttonX && !pad->buttonY && !pad->buttonL && !pad->buttonR, "NES %s sets no SNES-only button", button.name);
+    }
+    delete pad;
+}
+
+// One mouse frame: buttons, speed and the mouse id (only bit 15 of the id set) in the first 16 bits,
+// then Y and X each as a direction bit and a 7 bit magnitude, most significant bit first
+static uint32_t mouseFrame(bool left, bool right, uint8_t speed, bool up, uint8_t dy, bool leftward, uint8_t dx) {
+    uint32_t frame = (right ? 1u << 8 : 0) | (left ? 1u << 9 : 0) | ((uint32_t)(speed & 3) << 10) | (1u << 15);
+    frame |= (up ? 1u : 0) << 16;
+    for (int i = 0; i < 7; i++)
+        frame |= (uint32_t)((dy >> (6 - i)) & 1) << (17 + i);
+    frame |= (leftward ? 1u : 0) << 24;
+    for (int i = 0; i < 7; i++)
+        frame |= (uint32_t)((dx >> (6 - i)) & 1) << (25 + i);
+    return frame;
+}
+
+static void checkMouse() {
+    SNESpad* pad = startPad(mouseFrame(false, false, SNES_MOUSE_SLOW, false, 0, false, 0));
+    pad->poll();
+    EXPECT(pad->type == SNES_PAD_MOUSE, "an idle mouse is detected, got type %d", pad->type);
+    EXPECT(pio1->txFifo[0].size() == 1 && pio1->txFifo[0].back() == 1, "a slow mouse gets a speed pulse with the next request");
+    pio1->txFifo[0].clear();
+
+    // The reader keeps all 32 bits of a mouse frame. The library doubles the 7 bit magnitude.
+    for (int i = 0; i < 500; i++) {
+        bool left = rand() & 1, right = rand() & 1, up = rand() & 1, leftward = rand() & 1;
+        uint8_t dy = rand() % 64, dx = rand() % 64;
+        pushFrame(pio1, 0, mouseFrame(left, right, SNES_MOUSE_FAST, up, dy, leftward, dx));
+        pad->poll();
+        int expectedX = leftward ? 127 - 2 * dx : 127 + 2 * dx;
+        int expectedY = up ? 127 - 2 * dy : 127 + 2 * dy;
+        EXPECT(pad->type == SNES_PAD_MOUSE, "mouse frame %d stays a mouse", i);
+        EXPECT(pad->mouseX == expectedX && pad->mouseY == expectedY, "mouse moved %c%u %c%u reads %d,%d, got %d,%d",
+            leftward ? '-' : '+', dx, up ? '-' : '+', dy, expectedX, expectedY, pad->mouseX, pad->mouseY);
+        EXPECT(pad->buttonB == left && pad->buttonA == right, "mouse buttons %d/%d, got %d/%d", left, right, pad->buttonB, pad->buttonA);
+    }
+    EXPECT(!pio1->txFifo[0].empty() && pio1->txFifo[0].back() == 0, "a fast mouse gets no speed pulse");
+    delete pad;
+}
+
+static void checkPartialFrames() {
+    SNESpad* pad = startPad(0);
+    pad->poll();
+    pushFrame(pio1, 0, 1u << snesButtons[8].bit); // A
+    pad->poll();
+    EXPECT(pad->buttonA, "A is held");
+    pio1->txFifo[0].clear();
+
+    // Nothing queued, or only the first word of the next frame: keep reporting the last frame
+    pad->poll();
+    EXPECT(pad->buttonA && pad->type == SNES_PAD_BASIC, "an empty FIFO keeps the last frame");
+    pushFrame(pio1, 0, 1u << snesButtons[0].bit); // B
+    uint32_t data = pio1->rxFifo[0].back();
+    pio1->rxFifo[0].pop_back();
+    pad->poll();
+    EXPECT(pad->buttonA && !pad->buttonB, "one word in the FIFO keeps the last frame");
+    EXPECT(pio1->rxFifo[0].size() == 1, "the lone word is left for the next poll");
+    EXPECT(pio1->txFifo[0].empty(), "no frame is requested while one is still being clocked in");
+
+    pio1->rxFifo[0].push_back(data);
+    pad->poll();
+    EXPECT(!pad->buttonA && pad->buttonB, "the frame is read once both words are queued");
+    EXPECT(pio1->txFifo[0].size() == 1, "and the next one requested");
+
+    // Unplugged: the line idles high before the latch and every bit reads released
+    pushFrame(pio1, 0, 0, false);
+    pad->poll();
+    EXPECT(pad->type == SNES_PAD_NONE, "an unplugged pad is dropped, got type %d", pad->type);
+    pushFrame(pio1, 0, 0);
+    pad->poll();
+    EXPECT(pad->type == SNES_PAD_BASIC, "and found again once it answers");
+    delete pad;
+}
+
+static void checkReservedPIO() {
+    // A frame on every state machine, so begin() returns wherever the reader ends up
+    resetPIO();
+    for (uint sm = 0; sm < NUM_PIO_STATE_MACHINES; sm++) {
+        pushFrame(pio0, sm, 0);
+        pushFrame(pio1, sm, 0);
+    }
+    SNESpad pad(CLOCK_PIN, LATCH_PIN, DATA_PIN);
+    pad.reservePIO(1);
+    pad.begin();
+    EXPECT(!pio1->claimed[0] && pio0->claimed[1] && !pio0->claimed[0],
+        "with pio1 reserved the reader takes pio0 sm 1, leaving sm 0 to NeoPico");
+}
+
+int main() {
+    checkSNESPad();
+    checkNESPad();
+    checkMouse();
+    checkPartialFrames();
+    checkReservedPIO();
+
+    return TEST_RESULT("snespad_test");
+}
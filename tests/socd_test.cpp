@@ -0,0 +1,322 @@
+// Checks the shared SOCD and 4-way tables in GamepadState.cpp against the branchy cleaners
+// they replaced: the gamepad's runSOCDCleaner/filterToFourWayMode and Dual Directional's
+// SOCDDualClean, SOCDCombine and SOCDGamepadClean. Each reference walks the product of its
+// own state and the table history from power on, over every mode and d-pad value, until no
+// new state pair is reached, so every reachable state is compared for every input.
+
+#include "GamepadState.h"
+
+#include "testing.h"
+
+#include <list>
+#include <set>
+#include <utility>
+#include <vector>
+
+#define SOCD_MODES (SOCD_MODE_BYPASS + 1)
+
+namespace baseline {
+
+// Gamepad::process, runSOCDCleaner() with its statics as members
+struct GamepadSOCD {
+    DpadDirection lastUD = DIRECTION_NONE;
+    DpadDirection lastLR = DIRECTION_NONE;
+
+    uint32_t key() const { return lastUD * 5 + lastLR; }
+
+    uint8_t step(SOCDMode mode, uint8_t dpad) {
+        if (mode == SOCD_MODE_BYPASS) {
+            return dpad;
+        }
+
+        uint8_t newDpad = 0;
+
+        switch (dpad & (GAMEPAD_MASK_UP | GAMEPAD_MASK_DOWN))
+        {
+            case (GAMEPAD_MASK_UP | GAMEPAD_MASK_DOWN):
+                if (mode == SOCD_MODE_UP_PRIORITY)
+                {
+                    newDpad |= GAMEPAD_MASK_UP;
+                    lastUD = DIRECTION_UP;
+                }
+                else if (mode == SOCD_MODE_SECOND_INPUT_PRIORITY && lastUD != DIRECTION_NONE)
+                    newDpad |= (lastUD == DIRECTION_UP) ? GAMEPAD_MASK_DOWN : GAMEPAD_MASK_UP;
+                else if (mode == SOCD_MODE_FIRST_INPUT_PRIORITY && lastUD != DIRECTION_NONE)
+                    newDpad |= (lastUD == DIRECTION_UP) ? GAMEPAD_MASK_UP : GAMEPAD_MASK_DOWN;
+                else
+                    lastUD = DIRECTION_NONE;
+                break;
+
+            case GAMEPAD_MASK_UP:
+                newDpad |= GAMEPAD_MASK_UP;
+                lastUD = DIRECTION_UP;
+                break;
+
+            case GAMEPAD_MASK_DOWN:
+                newDpad |= GAMEPAD_MASK_DOWN;
+                lastUD = DIRECTION_DOWN;
+                break;
+
+            default:
+                lastUD = DIRECTION_NONE;
+                break;
+        }
+
+        switch (dpad & (GAMEPAD_MASK_LEFT | GAMEPAD_MASK_RIGHT))
+        {
+            case (GAMEPAD_MASK_LEFT | GAMEPAD_MASK_RIGHT):
+                if (mode == SOCD_MODE_SECOND_INPUT_PRIORITY && lastLR != DIRECTION_NONE)
+                    newDpad |= (lastLR == DIRECTION_LEFT) ? GAMEPAD_MASK_RIGHT : GAMEPAD_MASK_LEFT;
+                else if (mode == SOCD_MODE_FIRST_INPUT_PRIORITY && lastLR != DIRECTION_NONE)
+                    newDpad |= (lastLR == DIRECTION_LEFT) ? GAMEPAD_MASK_LEFT : GAMEPAD_MASK_RIGHT;
+                else
+                    lastLR = DIRECTION_NONE;
+                break;
+
+            case GAMEPAD_MASK_LEFT:
+                newDpad |= GAMEPAD_MASK_LEFT;
+                lastLR = DIRECTION_LEFT;
+                break;
+
+            case GAMEPAD_MASK_RIGHT:
+                newDpad |= GAMEPAD_MASK_RIGHT;
+                lastLR = DIRECTION_RIGHT;
+                break;
+
+            default:
+                lastLR = DIRECTION_NONE;
+                break;
+        }
+
+        return newDpad;
+    }
+};
+
+// filterToFourWayMode() and filterToFourWayModeDDI(), updateDpad() with its statics as members
+struct FourWay {
+    bool inList[5] = {false, false, false, false, false};
+    std::list<DpadDirection> dpadList;
+
+    uint32_t key() const {
+        uint32_t key = 0;
+        for (DpadDirection direction : dpadList)
+            key = key * 5 + direction;
+        return key;
+    }
+
+    uint8_t updateDpad(uint8_t dpad, DpadDirection direction) {
+        if (dpad & getMaskFromDirection(direction)) {
+            if (!inList[direction]) {
+                dpadList.push_back(direction);
+                inList[direction] = true;
+            }
+        } else {
+            if (inList[direction]) {
+                dpadList.remove(direction);
+                inList[direction] = false;
+            }
+        }
+
+        if (dpadList.empty()) {
+            return 0;
+        } else {
+            return getMaskFromDirection(dpadList.back());
+        }
+    }
+
+    uint8_t step(SOCDMode, uint8_t dpad) {
+        updateDpad(dpad, DIRECTION_UP);
+        updateDpad(dpad, DIRECTION_DOWN);
+        updateDpad(dpad, DIRECTION_LEFT);
+        return updateDpad(dpad, DIRECTION_RIGHT);
+    }
+};
+
+// DualDirectionalInput::SOCDDualClean()
+struct DualSOCD {
+    DpadDirection lastDualUD = DIRECTION_NONE;
+    DpadDirection lastDualLR = DIRECTION_NONE;
+
+    uint32_t key() const { return lastDualUD * 5 + lastDualLR; }
+
+    uint8_t step(SOCDMode socdMode, uint8_t dualState) {
+        if (socdMode == SOCD_MODE_BYPASS) {
+            return dualState;
+        }
+
+        switch (dualState & (GAMEPAD_MASK_UP | GAMEPAD_MASK_DOWN)) {
+            case (GAMEPAD_MASK_UP | GAMEPAD_MASK_DOWN):
+                if ( socdMode == SOCD_MODE_UP_PRIORITY ) {
+                    dualState ^= GAMEPAD_MASK_DOWN;
+                    lastDualUD = DIRECTION_UP;
+                } else if ( socdMode == SOCD_MODE_SECOND_INPUT_PRIORITY && lastDualUD != DIRECTION_NONE ) {
+                    dualState ^= (lastDualUD == DIRECTION_UP) ? GAMEPAD_MASK_UP : GAMEPAD_MASK_DOWN;
+                } else if ( socdMode == SOCD_MODE_FIRST_INPUT_PRIORITY && lastDualUD != DIRECTION_NONE ) {
+                    dualState ^= (lastDualUD == DIRECTION_UP) ? GAMEPAD_MASK_DOWN : GAMEPAD_MASK_UP;
+                } else {
+                    dualState ^= (GAMEPAD_MASK_UP | GAMEPAD_MASK_DOWN);
+                    lastDualUD = DIRECTION_NONE;
+                }
+                break;
+            case GAMEPAD_MASK_UP:
+                lastDualUD = DIRECTION_UP;
+                break;
+            case GAMEPAD_MASK_DOWN:
+                lastDualUD = DIRECTION_DOWN;
+                break;
+            default:
+                lastDualUD = DIRECTION_NONE;
+                break;
+        }
+        switch (dualState & (GAMEPAD_MASK_LEFT | GAMEPAD_MASK_RIGHT)) {
+            case (GAMEPAD_MASK_LEFT | GAMEPAD_MASK_RIGHT):
+                if ( socdMode == SOCD_MODE_UP_PRIORITY || socdMode == SOCD_MODE_NEUTRAL ) {
+                    dualState ^= (GAMEPAD_MASK_LEFT | GAMEPAD_MASK_RIGHT);
+                    lastDualLR = DIRECTION_NONE;
+                } else if ( socdMode == SOCD_MODE_SECOND_INPUT_PRIORITY || socdMode == SOCD_MODE_FIRST_INPUT_PRIORITY ) {
+                    if (lastDualLR != DIRECTION_NONE)
+                        if (socdMode == SOCD_MODE_SECOND_INPUT_PRIORITY) dualState ^= (lastDualLR == DIRECTION_LEFT) ? GAMEPAD_MASK_LEFT : GAMEPAD_MASK_RIGHT;
+                        else dualState ^= (lastDualLR == DIRECTION_LEFT) ? GAMEPAD_MASK_RIGHT : GAMEPAD_MASK_LEFT;
+                    else
+                        lastDualLR = DIRECTION_NONE;
+                }
+                break;
+            case GAMEPAD_MASK_LEFT:
+                lastDualLR = DIRECTION_LEFT;
+                break;
+            case GAMEPAD_MASK_RIGHT:
+                lastDualLR = DIRECTION_RIGHT;
+                break;
+            default:
+                lastDualLR = DIRECTION_NONE;
+                break;
+        }
+        return dualState;
+    }
+};
+
+// DualDirectionalInput::process() mixing: SOCDCombine(), SOCDGamepadClean() or an OR
+struct MixedSOCD {
+    DpadDirection lastGPUD = DIRECTION_NONE;
+    DpadDirection lastGPLR = DIRECTION_NONE;
+
+    uint32_t key() const { return lastGPUD * 5 + lastGPLR; }
+
+    uint8_t combine(SOCDMode mode, uint8_t outState) {
+        switch (outState & (GAMEPAD_MASK_UP | GAMEPAD_MASK_DOWN)) {
+            case (GAMEPAD_MASK_UP | GAMEPAD_MASK_DOWN):
+                if ( mode == SOCD_MODE_NEUTRAL )
+                    outState ^= (GAMEPAD_MASK_UP | GAMEPAD_MASK_DOWN);
+                else if ( mode == SOCD_MODE_UP_PRIORITY )
+                    outState = GAMEPAD_MASK_UP;
+                break;
+            default:
+                break;
+        }
+        switch (outState & (GAMEPAD_MASK_LEFT | GAMEPAD_MASK_RIGHT)) {
+            case (GAMEPAD_MASK_LEFT | GAMEPAD_MASK_RIGHT):
+                outState ^= (GAMEPAD_MASK_LEFT | GAMEPAD_MASK_RIGHT);
+                break;
+            default:
+                break;
+        }
+        return outState;
+    }
+
+    uint8_t gamepadClean(uint8_t gamepadState, bool isLastWin) {
+        switch (gamepadState & (GAMEPAD_MASK_UP | GAMEPAD_MASK_DOWN)) {
+            case (GAMEPAD_MASK_UP | GAMEPAD_MASK_DOWN):
+                if (isLastWin) gamepadState ^= (lastGPUD == DIRECTION_UP) ? GAMEPAD_MASK_UP : GAMEPAD_MASK_DOWN;
+                else gamepadState ^= (lastGPUD == DIRECTION_UP) ? GAMEPAD_MASK_DOWN : GAMEPAD_MASK_UP;
+                break;
+            case GAMEPAD_MASK_UP:
+                gamepadState |= GAMEPAD_MASK_UP;
+                lastGPUD = DIRECTION_UP;
+                break;
+            case GAMEPAD_MASK_DOWN:
+                gamepadState |= GAMEPAD_MASK_DOWN;
+                lastGPUD = DIRECTION_DOWN;
+                break;
+            default:
+                lastGPUD = DIRECTION_NONE;
+                break;
+        }
+        switch (gamepadState & (GAMEPAD_MASK_LEFT | GAMEPAD_MASK_RIGHT)) {
+            case (GAMEPAD_MASK_LEFT | GAMEPAD_MASK_RIGHT):
+                if (lastGPLR != DIRECTION_NONE)
+                    if (isLastWin) gamepadState ^= (lastGPLR == DIRECTION_LEFT) ? GAMEPAD_MASK_LEFT : GAMEPAD_MASK_RIGHT;
+                    else gamepadState ^= (lastGPLR == DIRECTION_LEFT) ? GAMEPAD_MASK_RIGHT : GAMEPAD_MASK_LEFT;
+                else
+                    lastGPLR = DIRECTION_NONE;
+                break;
+            case GAMEPAD_MASK_LEFT:
+                gamepadState |= GAMEPAD_MASK_LEFT;
+                lastGPLR = DIRECTION_LEFT;
+                break;
+            case GAMEPAD_MASK_RIGHT:
+                gamepadState |= GAMEPAD_MASK_RIGHT;
+                lastGPLR = DIRECTION_RIGHT;
+                break;
+            default:
+                lastGPLR = DIRECTION_NONE;
+                break;
+        }
+        return gamepadState;
+    }
+
+    uint8_t step(SOCDMode socdMode, uint8_t combined) {
+        if ( socdMode == SOCD_MODE_UP_PRIORITY || socdMode == SOCD_MODE_NEUTRAL ) {
+            return combine(socdMode, combined);
+        } else if ( socdMode != SOCD_MODE_BYPASS ) {
+            return gamepadClean(combined, socdMode == SOCD_MODE_SECOND_INPUT_PRIORITY);
+        } else {
+            return combined;
+        }
+    }
+};
+
+}
+
+template <typename Reference, typename Resolve>
+static void checkExhaustive(const char * name, int modes, Resolve resolve) {
+    struct Node {
+        Reference reference;
+        DpadHistory history;
+
+        std::pair<uint32_t, uint16_t> key() const {
+            return { reference.key(), (uint16_t)((history.socd << 8) | history.fourWay) };
+        }
+    };
+
+    std::vector<Node> queue(1);
+    std::set<std::pair<uint32_t, uint16_t>> seen = { queue[0].key() };
+    size_t transitions = 0;
+    for (size_t i = 0; i < queue.size(); i++) {
+        for (int mode = 0; mode < modes; mode++) {
+            for (uint8_t dpad = 0; dpad < 16; dpad++) {
+                Node node = queue[i];
+                uint8_t expected = node.reference.step((SOCDMode)mode, dpad);
+                uint8_t actual = resolve((SOCDMode)mode, dpad, node.history);
+                EXPECT(actual == expected, "%s: state %zu, mode %d, dpad %x gives %x, got %x",
+                    name, i, mode, dpad, expected, actual);
+                transitions++;
+                if (seen.insert(node.key()).second)
+                    queue.push_back(node);
+            }
+        }
+    }
+    printf("%s: %zu state pairs, %zu transitions\n", name, queue.size(), transitions);
+}
+
+int main() {
+    checkExhaustive<baseline::GamepadSOCD>("gamepad SOCD", SOCD_MODES,
+        [](SOCDMode mode, uint8_t dpad, DpadHistory & history) { return runSOCDCleaner(mode, dpad, history); });
+    checkExhaustive<baseline::DualSOCD>("dual directional SOCD", SOCD_MODES,
+        [](SOCDMode mode, uint8_t dpad, DpadHistory & history) { return runSOCDCleaner(mode, dpad, history, SOCD_RULES_DUAL); });
+    checkExhaustive<baseline::MixedSOCD>("dual directional mixed SOCD", SOCD_MODES,
+        [](SOCDMode mode, uint8_t dpad, DpadHistory & history) { return runSOCDCleaner(mode, dpad, history, SOCD_RULES_MIXED); });
+    checkExhaustive<baseline::FourWay>("4-way", 1,
+        [](SOCDMode, uint8_t dpad, DpadHistory & history) { return filterToFourWayMode(dpad, history); });
+
+    return TEST_RESULT("socd_test");
+}
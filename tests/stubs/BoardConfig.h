@@ -0,0 +1,6 @@
+#ifndef _BOARDCONFIG_H_
+#define _BOARDCONFIG_H_
+
+// Host stand-in for the board config, tests build with every add-on default
+
+#endif
@@ -0,0 +1,16 @@
+#ifndef _NEO_PICO_H_
+#define _NEO_PICO_H_
+
+// Host stand-in for lib/NeoPico, only the LED formats AnimationStation packs colors for
+
+#include <stdint.h>
+
+typedef enum
+{
+  LED_FORMAT_GRB = 0,
+  LED_FORMAT_RGB = 1,
+  LED_FORMAT_GRBW = 2,
+  LED_FORMAT_RGBW = 3,
+} LEDFormat;
+
+#endif
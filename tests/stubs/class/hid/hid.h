@@ -0,0 +1,94 @@
+#ifndef _TUSB_HID_H_
+#define _TUSB_HID_H_
+
+// Host stand-in for the TinyUSB HID class header, with TinyUSB's values
+
+#include <stdint.h>
+
+typedef enum {
+    HID_REPORT_TYPE_INVALID = 0,
+    HID_REPORT_TYPE_INPUT,
+    HID_REPORT_TYPE_OUTPUT,
+    HID_REPORT_TYPE_FEATURE,
+} hid_report_type_t;
+
+typedef enum {
+    HID_ITF_PROTOCOL_NONE = 0,
+    HID_ITF_PROTOCOL_KEYBOARD = 1,
+    HID_ITF_PROTOCOL_MOUSE = 2,
+} hid_interface_protocol_enum_t;
+
+typedef enum {
+    HID_PROTOCOL_BOOT = 0,
+    HID_PROTOCOL_REPORT = 1,
+} hid_protocol_mode_enum_t;
+
+typedef struct __attribute__((packed)) {
+    uint8_t modifier;
+    uint8_t reserved;
+    uint8_t keycode[6];
+} hid_keyboard_report_t;
+
+typedef struct __attribute__((packed)) {
+    uint8_t buttons;
+    int8_t x;
+    int8_t y;
+    int8_t wheel;
+    int8_t pan;
+} hid_mouse_report_t;
+
+typedef enum {
+    MOUSE_BUTTON_LEFT = 1u << 0,
+    MOUSE_BUTTON_RIGHT = 1u << 1,
+    MOUSE_BUTTON_MIDDLE = 1u << 2,
+} hid_mouse_button_bm_t;
+
+#define HID_KEY_NONE          0x00
+#define HID_KEY_A             0x04
+#define HID_KEY_CONTROL_LEFT  0xE0
+#define HID_KEY_GUI_RIGHT     0xE7
+
+// Report descriptor items
+enum {
+    RI_TYPE_MAIN = 0,
+    RI_TYPE_GLOBAL = 1,
+    RI_TYPE_LOCAL = 2,
+};
+
+enum {
+    RI_MAIN_INPUT = 8,
+    RI_MAIN_OUTPUT = 9,
+    RI_MAIN_COLLECTION = 10,
+    RI_MAIN_FEATURE = 11,
+    RI_MAIN_COLLECTION_END = 12,
+};
+
+enum {
+    RI_GLOBAL_USAGE_PAGE = 0,
+    RI_GLOBAL_LOGICAL_MIN = 1,
+    RI_GLOBAL_LOGICAL_MAX = 2,
+    RI_GLOBAL_PHYSICAL_MIN = 3,
+    RI_GLOBAL_PHYSICAL_MAX = 4,
+    RI_GLOBAL_UNIT_EXPONENT = 5,
+    RI_GLOBAL_UNIT = 6,
+    RI_GLOBAL_REPORT_SIZE = 7,
+    RI_GLOBAL_REPORT_ID = 8,
+    RI_GLOBAL_REPORT_COUNT = 9,
+    RI_GLOBAL_PUSH = 10,
+    RI_GLOBAL_POP = 11,
+};
+
+enum {
+    RI_LOCAL_USAGE = 0,
+    RI_LOCAL_USAGE_MIN = 1,
+    RI_LOCAL_USAGE_MAX = 2,
+};
+
+#define HID_USAGE_PAGE_KEYBOARD 0x07
+
+#define HID_DATA     (0 << 0)
+#define HID_CONSTANT (1 << 0)
+#define HID_ARRAY    (0 << 1)
+#define HID_VARIABLE (1 << 1)
+
+#endif
@@ -0,0 +1,25 @@
+#ifndef _TUSB_HID_HOST_H_
+#define _TUSB_HID_HOST_H_
+
+// Host stand-in for the TinyUSB HID host API: one interface whose protocol the test sets,
+// set_protocol requests are recorded and switch it over
+
+#include <stdint.h>
+
+#include "class/hid/hid.h"
+
+inline uint8_t host_hid_itf_protocol = HID_ITF_PROTOCOL_NONE;
+inline uint8_t host_hid_protocol = HID_PROTOCOL_BOOT;
+inline int host_hid_set_protocol_calls = 0;
+
+inline uint8_t tuh_hid_interface_protocol(uint8_t dev_addr, uint8_t idx) { return host_hid_itf_protocol; }
+
+inline bool tuh_hid_set_protocol(uint8_t dev_addr, uint8_t idx, uint8_t protocol) {
+    host_hid_set_protocol_calls++;
+    host_hid_protocol = protocol;
+    return true;
+}
+
+inline uint8_t tuh_hid_get_protocol(uint8_t dev_addr, uint8_t idx) { return host_hid_protocol; }
+
+#endif
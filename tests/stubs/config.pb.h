@@ -0,0 +1,112 @@
+#ifndef PB_CONFIG_PB_H_INCLUDED
+#define PB_CONFIG_PB_H_INCLUDED
+
+// Host stand-in for the generated nanopb config, only the messages host tests read
+
+#include <stdint.h>
+
+typedef struct _WiiOptions_AnalogAxis {
+    int32_t axisType;
+    int32_t minRange;
+    int32_t maxRange;
+} WiiOptions_AnalogAxis;
+
+typedef struct _WiiOptions_StickOptions {
+    WiiOptions_AnalogAxis x;
+    WiiOptions_AnalogAxis y;
+} WiiOptions_StickOptions;
+
+typedef struct _WiiOptions_NunchukOptions {
+    int32_t buttonC;
+    int32_t buttonZ;
+    WiiOptions_StickOptions stick;
+} WiiOptions_NunchukOptions;
+
+typedef struct _WiiOptions_ClassicOptions {
+    int32_t buttonA;
+    int32_t buttonB;
+    int32_t buttonX;
+    int32_t buttonY;
+    int32_t buttonL;
+    int32_t buttonZL;
+    int32_t buttonR;
+    int32_t buttonZR;
+    int32_t buttonMinus;
+    int32_t buttonPlus;
+    int32_t buttonHome;
+    int32_t buttonUp;
+    int32_t buttonDown;
+    int32_t buttonLeft;
+    int32_t buttonRight;
+    WiiOptions_StickOptions leftStick;
+    WiiOptions_StickOptions rightStick;
+    WiiOptions_AnalogAxis leftTrigger;
+    WiiOptions_AnalogAxis rightTrigger;
+} WiiOptions_ClassicOptions;
+
+typedef struct _WiiOptions_TaikoOptions {
+    int32_t buttonKatLeft;
+    int32_t buttonKatRight;
+    int32_t buttonDonLeft;
+    int32_t buttonDonRight;
+} WiiOptions_TaikoOptions;
+
+typedef struct _WiiOptions_GuitarOptions {
+    int32_t buttonRed;
+    int32_t buttonGreen;
+    int32_t buttonYellow;
+    int32_t buttonBlue;
+    int32_t buttonOrange;
+    int32_t buttonPedal;
+    int32_t buttonMinus;
+    int32_t buttonPlus;
+    int32_t strumUp;
+    int32_t strumDown;
+    WiiOptions_StickOptions stick;
+    WiiOptions_AnalogAxis whammyBar;
+} WiiOptions_GuitarOptions;
+
+typedef struct _WiiOptions_DrumOptions {
+    int32_t buttonRed;
+    int32_t buttonGreen;
+    int32_t buttonYellow;
+    int32_t buttonBlue;
+    int32_t buttonOrange;
+    int32_t buttonPedal;
+    int32_t buttonMinus;
+    int32_t buttonPlus;
+    WiiOptions_StickOptions stick;
+} WiiOptions_DrumOptions;
+
+typedef struct _WiiOptions_TurntableOptions {
+    int32_t buttonLeftRed;
+    int32_t buttonLeftGreen;
+    int32_t buttonLeftBlue;
+    int32_t buttonRightRed;
+    int32_t buttonRightGreen;
+    int32_t buttonRightBlue;
+    int32_t buttonMinus;
+    int32_t buttonPlus;
+    int32_t buttonEuphoria;
+    WiiOptions_StickOptions stick;
+    WiiOptions_AnalogAxis leftTurntable;
+    WiiOptions_AnalogAxis rightTurntable;
+    WiiOptions_AnalogAxis effects;
+    WiiOptions_AnalogAxis fader;
+} WiiOptions_TurntableOptions;
+
+typedef struct _WiiOptions_ControllerOptions {
+    WiiOptions_NunchukOptions nunchuk;
+    WiiOptions_ClassicOptions classic;
+    WiiOptions_TaikoOptions taiko;
+    WiiOptions_GuitarOptions guitar;
+    WiiOptions_DrumOptions drum;
+    WiiOptions_TurntableOptions turntable;
+} WiiOptions_ControllerOptions;
+
+typedef struct _WiiOptions {
+    bool enabled;
+    WiiOptions_ControllerOptions controllers;
+} WiiOptions;
+
+#endif
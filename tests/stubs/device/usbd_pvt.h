@@ -0,0 +1,10 @@
+#ifndef _TUSB_USBD_PVT_H_
+#define _TUSB_USBD_PVT_H_
+
+// Host stand-in for the TinyUSB device class driver table entry
+
+typedef struct {
+    const char * name;
+} usbd_class_driver_t;
+
+#endif
@@ -0,0 +1,26 @@
+#ifndef _DRIVERMANAGER_H
+#define _DRIVERMANAGER_H
+
+// Host stand-in for the driver manager, no input driver is active unless a test sets one
+
+#include <stdint.h>
+
+class GPDriver {
+public:
+    uint16_t GetJoystickMidValue() { return joystickMid; }
+
+    uint16_t joystickMid = 0x7FFF;
+};
+
+class DriverManager {
+public:
+    static DriverManager& getInstance() {
+        static DriverManager instance;
+        return instance;
+    }
+    GPDriver * getDriver() { return driver; }
+
+    GPDriver * driver = nullptr;
+};
+
+#endif
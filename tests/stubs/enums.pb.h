@@ -0,0 +1,15 @@
+#ifndef _ENUMS_PB_H
+#define _ENUMS_PB_H
+
+// Host stand-in for the nanopb header generated from proto/enums.proto, only the enums
+// the tested sources use
+
+typedef enum _SOCDMode {
+    SOCD_MODE_UP_PRIORITY = 0,
+    SOCD_MODE_NEUTRAL = 1,
+    SOCD_MODE_SECOND_INPUT_PRIORITY = 2,
+    SOCD_MODE_FIRST_INPUT_PRIORITY = 3,
+    SOCD_MODE_BYPASS = 4
+} SOCDMode;
+
+#endif
@@ -0,0 +1,12 @@
+#ifndef _HARDWARE_CLOCKS_H
+#define _HARDWARE_CLOCKS_H
+
+// Host stand-in for the Pico SDK clocks header, PIO loaders only read the system clock
+
+#include <stdint.h>
+
+enum clock_index { clk_sys = 5 };
+
+static inline uint32_t clock_get_hz(clock_index) { return 125000000; }
+
+#endif
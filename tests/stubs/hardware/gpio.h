@@ -0,0 +1,8 @@
+#ifndef _HARDWARE_GPIO_H
+#define _HARDWARE_GPIO_H
+
+// Host stand-in for the Pico SDK GPIO header, the GPIO helpers live in pico/stdlib.h
+
+#include "pico/stdlib.h"
+
+#endif
@@ -0,0 +1,8 @@
+#ifndef _HARDWARE_I2C_H
+#define _HARDWARE_I2C_H
+
+// Host stand-in for the Pico SDK I2C header, devices talk through PeripheralI2C instead
+
+typedef struct i2c_inst i2c_inst_t;
+
+#endif
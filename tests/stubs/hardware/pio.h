@@ -0,0 +1,91 @@
+#ifndef _HARDWARE_PIO_H
+#define _HARDWARE_PIO_H
+
+// Host stand-in for the Pico SDK PIO API. No program runs: each state machine is a pair of
+// FIFOs the test fills and drains, plus the claim and instruction memory bookkeeping the
+// loaders check.
+
+#include <stdint.h>
+#include <sys/types.h>
+
+#include <deque>
+
+#include "pico/stdlib.h"
+
+#define NUM_PIO_STATE_MACHINES 4
+#define PIO_INSTRUCTION_COUNT 32
+
+struct pio_program {
+    const uint16_t * instructions;
+    uint8_t length;
+    int8_t origin;
+};
+
+typedef struct {
+    uint32_t clkdiv;
+    uint32_t execctrl;
+    uint32_t shiftctrl;
+    uint32_t pinctrl;
+} pio_sm_config;
+
+struct host_pio_block {
+    uint index;
+    uint usedInstructions;
+    bool claimed[NUM_PIO_STATE_MACHINES];
+    bool enabled[NUM_PIO_STATE_MACHINES];
+    std::deque<uint32_t> rxFifo[NUM_PIO_STATE_MACHINES]; // pushed by the "state machine", read by pio_sm_get()
+    std::deque<uint32_t> txFifo[NUM_PIO_STATE_MACHINES]; // written by pio_sm_put()
+};
+
+typedef host_pio_block * PIO;
+
+inline host_pio_block host_pio_blocks[2] = { { 0 }, { 1 } };
+
+#define pio0 (&host_pio_blocks[0])
+#define pio1 (&host_pio_blocks[1])
+
+static inline uint pio_get_index(PIO pio) { return pio->index; }
+
+static inline bool pio_can_add_program(PIO pio, const pio_program * program) {
+    return pio->usedInstructions + program->length <= PIO_INSTRUCTION_COUNT;
+}
+
+static inline uint pio_add_program(PIO pio, const pio_program * program) {
+    uint offset = pio->usedInstructions;
+    pio->usedInstructions += program->length;
+    return offset;
+}
+
+static inline bool pio_sm_is_claimed(PIO pio, uint sm) { return pio->claimed[sm]; }
+static inline void pio_sm_claim(PIO pio, uint sm) { pio->claimed[sm] = true; }
+
+static inline void pio_sm_set_enabled(PIO pio, uint sm, bool enabled) { pio->enabled[sm] = enabled; }
+
+static inline uint pio_sm_get_rx_fifo_level(PIO pio, uint sm) { return (uint)pio->rxFifo[sm].size(); }
+
+// The SDK would block on an empty FIFO, a test that gets here has a bug
+static inline uint32_t pio_sm_get(PIO pio, uint sm) {
+    assert(!pio->rxFifo[sm].empty());
+    uint32_t value = pio->rxFifo[sm].front();
+    pio->rxFifo[sm].pop_front();
+    return value;
+}
+
+static inline void pio_sm_put(PIO pio, uint sm, uint32_t data) { pio->txFifo[sm].push_back(data); }
+
+// Configuration only matters on hardware
+static inline pio_sm_config pio_get_default_sm_config() { return pio_sm_config{}; }
+static inline void sm_config_set_wrap(pio_sm_config *, uint, uint) {}
+static inline void sm_config_set_sideset(pio_sm_config *, uint, bool, bool) {}
+static inline void sm_config_set_sideset_pins(pio_sm_config *, uint) {}
+static inline void sm_config_set_set_pins(pio_sm_config *, uint, uint) {}
+static inline void sm_config_set_in_pins(pio_sm_config *, uint) {}
+static inline void sm_config_set_in_shift(pio_sm_config *, bool, bool, uint) {}
+static inline void sm_config_set_out_shift(pio_sm_config *, bool, bool, uint) {}
+static inline void sm_config_set_clkdiv(pio_sm_config *, float) {}
+static inline void pio_gpio_init(PIO, uint) {}
+static inline void pio_sm_set_pins_with_mask(PIO, uint, uint32_t, uint32_t) {}
+static inline void pio_sm_set_consecutive_pindirs(PIO, uint, uint, uint, bool) {}
+static inline void pio_sm_init(PIO, uint, uint, const pio_sm_config *) {}
+
+#endif
@@ -0,0 +1,8 @@
+#ifndef _HARDWARE_SYNC_H
+#define _HARDWARE_SYNC_H
+
+// Host stand-in for the Pico SDK barriers, a compiler fence is enough in one thread
+
+#define __dmb() __asm__ volatile ("" ::: "memory")
+
+#endif
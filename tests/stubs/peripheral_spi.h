@@ -0,0 +1,8 @@
+#ifndef _PERIPHERAL_SPI_H_
+#define _PERIPHERAL_SPI_H_
+
+// Host stand-in for an SPI block, only referenced by pointer in the tested sources
+
+class PeripheralSPI {};
+
+#endif
@@ -0,0 +1,36 @@
+#ifndef _PICO_STDLIB_H
+#define _PICO_STDLIB_H
+
+// Host stand-in for the Pico SDK standard library header, the helpers the tested sources use
+
+#include <assert.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "pico/time.h"
+
+// GPIO levels a test drives, writes go nowhere
+#define GPIO_OUT 1
+#define GPIO_IN 0
+
+inline bool host_gpio_level[30] = {};
+
+static inline void gpio_init(unsigned int) {}
+static inline void gpio_set_dir(unsigned int, bool) {}
+static inline void gpio_pull_up(unsigned int) {}
+static inline void gpio_put(unsigned int, bool) {}
+static inline bool gpio_get(unsigned int pin) { return host_gpio_level[pin]; }
+static inline void busy_wait_us(uint64_t) {}
+// Nothing changes while a single-threaded test spins, fail instead of hanging
+inline uint32_t host_spin_count = 0;
+static inline void tight_loop_contents() { assert(++host_spin_count < 1000000 && "waiting on something that never comes"); }
+
+#ifndef MIN
+#define MIN(a, b) ((b) > (a) ? (a) : (b))
+#endif
+
+#ifndef MAX
+#define MAX(a, b) ((a) > (b) ? (a) : (b))
+#endif
+
+#endif
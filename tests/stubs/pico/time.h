@@ -0,0 +1,27 @@
+#ifndef _PICO_TIME_H
+#define _PICO_TIME_H
+
+// Host stand-in for the Pico SDK time functions. Time only moves when a test calls
+// host_time_advance_us(), so anything timed runs the same way on every run.
+
+#include <stdint.h>
+
+typedef uint64_t absolute_time_t;
+
+static const absolute_time_t nil_time = 0;
+
+inline uint64_t host_time_us = 1;
+
+static inline void host_time_advance_us(uint64_t us) { host_time_us += us; }
+
+static inline absolute_time_t get_absolute_time() { return host_time_us; }
+
+static inline int64_t absolute_time_diff_us(absolute_time_t from, absolute_time_t to) { return (int64_t)(to - from); }
+
+static inline bool time_reached(absolute_time_t t) { return host_time_us >= t; }
+
+static inline absolute_time_t make_timeout_time_ms(uint32_t ms) { return host_time_us + (uint64_t)ms * 1000; }
+
+static inline uint32_t to_ms_since_boot(absolute_time_t t) { return (uint32_t)(t / 1000); }
+
+#endif
@@ -0,0 +1,19 @@
+#ifndef _PICO_UNIQUE_ID_H
+#define _PICO_UNIQUE_ID_H
+
+// Host stand-in for the Pico SDK board id, a fixed id keeps generated descriptors reproducible
+
+#include <stdint.h>
+
+#define PICO_UNIQUE_BOARD_ID_SIZE_BYTES 8
+
+typedef struct {
+    uint8_t id[PICO_UNIQUE_BOARD_ID_SIZE_BYTES];
+} pico_unique_board_id_t;
+
+static inline void pico_get_unique_board_id(pico_unique_board_id_t * id) {
+    for (int i = 0; i < PICO_UNIQUE_BOARD_ID_SIZE_BYTES; i++)
+        id->id[i] = (uint8_t)i;
+}
+
+#endif
@@ -0,0 +1,16 @@
+#ifndef _TUSB_H_
+#define _TUSB_H_
+
+// Host stand-in for TinyUSB, the types the driver interface names
+
+#include <stdint.h>
+
+typedef struct {
+    uint8_t bmRequestType;
+    uint8_t bRequest;
+    uint16_t wValue;
+    uint16_t wIndex;
+    uint16_t wLength;
+} tusb_control_request_t;
+
+#endif
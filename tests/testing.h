@@ -0,0 +1,23 @@
+#ifndef _TESTING_H_
+#define _TESTING_H_
+
+// Minimal checks for the host tests, a test binary returns the number of failures
+
+#include <cstdio>
+
+static int testFailures = 0;
+
+#define EXPECT(cond, ...) \
+    do { \
+        if (!(cond)) { \
+            testFailures++; \
+            printf("%s:%d: expected %s: ", __FILE__, __LINE__, #cond); \
+            printf(__VA_ARGS__); \
+            printf("\n"); \
+        } \
+    } while (0)
+
+#define TEST_RESULT(name) \
+    (printf("%s: %s\n", name, testFailures ? "FAILED" : "passed"), testFailures)
+
+#endif
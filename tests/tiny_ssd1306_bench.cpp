@@ -0,0 +1,48 @@
+// Time to draw a button-layout-like frame with GPGFX_TinySSD1306 and with the drawPixel based
+// reference it replaced, on the host
+
+#include "tiny_ssd1306.h"
+#include "fonts/GP_Font_Standard.h"
+
+#include "tiny_ssd1306_reference.h"
+
+#include <chrono>
+#include <cstdio>
+
+template <typename Display>
+static double timeFrames(Display & display, int frames) {
+    uint32_t check = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int frame = 0; frame < frames; frame++) {
+        display.clear();
+        for (int row = 0; row < 8; row++)
+            display.drawText(0, row, "Hello GP2040-CE 12345", 0);
+        for (int i = 0; i < 12; i++)
+            display.drawEllipse(10 + i * 9, 40, 4, 4, 1, i % 2);
+        display.drawRectangle(0, 0, 128, 7, 1, 1);
+        for (int i = 0; i < 4; i++)
+            display.drawRectangle(20 + i * 20, 20, 30 + i * 20, 30, 1, i % 2, 45);
+        display.drawEllipse(20, 30, 8, 8, 1, 0);
+        check += display.getFrameBuffer()[frame % 1024];
+    }
+    auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+    if (check == 0xFFFFFFFF) printf("\n"); // keep the frames from being optimized out
+    return elapsed / 1000.0 / frames;
+}
+
+int main() {
+    const GPGFX_DisplayFont font = { 6, 8, GP_Font_Standard };
+    GPGFX_DisplayTypeOptions options {};
+    PeripheralI2C i2c;
+    options.i2c = &i2c;
+    options.font = font;
+    GPGFX_TinySSD1306 display;
+    display.init(options);
+    BaselineTinySSD1306 reference(font);
+
+    const int frames = 2000;
+    double referenceTime = timeFrames(reference, frames);
+    double displayTime = timeFrames(display, frames);
+    printf("%d frames: reference %.1f us/frame, GPGFX_TinySSD1306 %.1f us/frame\n", frames, referenceTime, displayTime);
+    return 0;
+}
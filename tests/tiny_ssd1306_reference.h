@@ -0,0 +1,51 @@
+#ifndef _TINY_SSD1306_REFERENCE_H_
+#define _TINY_SSD1306_REFERENCE_H_
+
+// The drawing code of GPGFX_TinySSD1306 as it was before glyphs and shapes were blitted
+// with integer math, kept as the reference for tiny_ssd1306_test and tiny_ssd1306_bench.
+// Display setup and transfers are left out, only the frame buffer is drawn into.
+
+#include <string>
+#include <string.h>
+#include <math.h>
+#include "pico/stdlib.h"
+#include "GPGFX_types.h"
+
+class BaselineTinySSD1306 {
+    public:
+        BaselineTinySSD1306(GPGFX_DisplayFont font) { _options.font = font; }
+
+        void clear();
+
+        uint32_t getPixel(uint8_t x, uint8_t y);
+
+        void drawPixel(uint8_t x, uint8_t y, uint32_t color);
+
+        void drawText(uint8_t x, uint8_t y, std::string text, uint8_t invert = 0);
+
+        void drawLine(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint32_t color, uint8_t filled);
+
+        void drawArc(uint16_t x, uint16_t y, uint32_t radiusX, uint32_t radiusY, uint32_t color, uint8_t filled, double startAngle, double endAngle, uint8_t closed);
+
+        void drawEllipse(uint16_t x, uint16_t y, uint32_t radiusX, uint32_t radiusY, uint32_t color, uint8_t filled);
+
+        void drawRectangle(uint16_t x, uint16_t y, uint16_t width, uint16_t height, uint32_t color, uint8_t filled, double rotationAngle = 0);
+
+        void drawPolygon(uint16_t x, uint16_t y, uint16_t radius, uint16_t sides, uint32_t color, uint8_t filled, double rotation = 0);
+
+        uint8_t* getFrameBuffer() { return this->frameBuffer; }
+    private:
+        typedef enum {
+            SCREEN_132x64 = 8,
+        } ScreenAlternatives;
+
+        static const uint16_t MAX_SCREEN_WIDTH = 128;
+        static const uint16_t MAX_SCREEN_HEIGHT = 64;
+        static const uint16_t MAX_SCREEN_SIZE = (MAX_SCREEN_WIDTH * MAX_SCREEN_HEIGHT / 8);
+
+        GPGFX_DisplayTypeOptions _options {};
+        uint8_t frameBuffer[MAX_SCREEN_SIZE] {};
+        uint8_t screenType = 0;
+};
+
+#endif
@@ -0,0 +1,155 @@
+// Draws random text and shapes with GPGFX_TinySSD1306 and with the drawPixel based code it
+// replaced (tiny_ssd1306_reference.cpp). Text, lines, ellipses and unrotated rectangles have
+// to match bit for bit. Rotated rectangles, polygons and arcs sample their edges differently,
+// so there every pixel only one side drew has to touch a pixel the other side drew.
+
+#include "tiny_ssd1306.h"
+#include "fonts/GP_Font_Standard.h"
+
+#include "testing.h"
+#include "tiny_ssd1306_reference.h"
+
+#include <random>
+
+enum Shape {
+    SHAPE_TEXT,
+    SHAPE_LINE,
+    SHAPE_ELLIPSE,
+    SHAPE_ELLIPSE_FILLED,
+    SHAPE_RECTANGLE,
+    SHAPE_RECTANGLE_FILLED,
+    SHAPE_ROTATED_RECTANGLE,
+    SHAPE_ROTATED_RECTANGLE_FILLED,
+    SHAPE_POLYGON,
+    SHAPE_POLYGON_FILLED,
+    SHAPE_ARC,
+    SHAPE_ARC_FILLED,
+    SHAPE_COUNT
+};
+
+static const char * shapeNames[SHAPE_COUNT] = {
+    "text", "line", "ellipse", "filled ellipse", "rectangle", "filled rectangle",
+    "rotated rectangle", "filled rotated rectangle", "polygon", "filled polygon", "arc", "filled arc"
+};
+
+static const GPGFX_DisplayFont font = { 6, 8, GP_Font_Standard };
+
+static bool pixel(const uint8_t * frame, int x, int y) {
+    if (x < 0 || x >= 128 || y < 0 || y >= 64) return false;
+    return (frame[(y / 8) * 128 + x] >> (y % 8)) & 1;
+}
+
+// Pixels set in a but not in b that have no set pixel of b in their 3x3 neighbourhood
+static int strayPixels(const uint8_t * a, const uint8_t * b) {
+    int stray = 0;
+    for (int y = 0; y < 64; y++) {
+        for (int x = 0; x < 128; x++) {
+            if (!pixel(a, x, y) || pixel(b, x, y)) continue;
+            bool near = false;
+            for (int dy = -1; dy <= 1 && !near; dy++)
+                for (int dx = -1; dx <= 1 && !near; dx++)
+                    near = pixel(b, x + dx, y + dy);
+            if (!near) stray++;
+        }
+    }
+    return stray;
+}
+
+template <typename Display>
+static void draw(Display & display, Shape shape, std::mt19937 & random) {
+    int radius = 1 + random() % 20;
+    int x = radius + 1 + random() % (126 - 2 * radius);
+    int y = radius + 1 + random() % ((62 - 2 * radius < 1) ? 1 : 62 - 2 * radius);
+    switch (shape) {
+        case SHAPE_TEXT: {
+            std::string text;
+            int length = random() % 22;
+            for (int i = 0; i < length; i++)
+                text += (char)(32 + random() % 90);
+            int column = random() % 4, row = random() % 8, invert = random() % 2;
+            display.drawText(column, row, text, invert);
+            break;
+        }
+        case SHAPE_LINE: {
+            int x2 = random() % 128, y2 = random() % 64;
+            if (random() % 2) y2 = y;
+            display.drawLine(x, y, x2, y2, 1, 0);
+            break;
+        }
+        case SHAPE_ELLIPSE:
+        case SHAPE_ELLIPSE_FILLED:
+            display.drawEllipse(x, y, radius, radius, 1, shape == SHAPE_ELLIPSE_FILLED);
+            break;
+        case SHAPE_RECTANGLE:
+        case SHAPE_RECTANGLE_FILLED:
+        case SHAPE_ROTATED_RECTANGLE:
+        case SHAPE_ROTATED_RECTANGLE_FILLED: {
+            x = random() % 90;
+            y = random() % 40;
+            int right = x + random() % 30, bottom = y + random() % 20;
+            bool filled = (shape == SHAPE_RECTANGLE_FILLED || shape == SHAPE_ROTATED_RECTANGLE_FILLED);
+            // the reference fills a single pixel rectangle with 0 / 0 and draws wherever NaN lands
+            if (filled && right == x && bottom == y) right++;
+            double angle = 0;
+            if (shape == SHAPE_ROTATED_RECTANGLE || shape == SHAPE_ROTATED_RECTANGLE_FILLED) {
+                // keep rotated corners on screen, both sides wrap off-screen coordinates differently
+                angle = 1 + random() % 359;
+                x = 25 + random() % 50;
+                y = 25 + random() % 10;
+                right = x + random() % 25;
+                bottom = y + random() % 10;
+            }
+            display.drawRectangle(x, y, right, bottom, 1, filled, angle);
+            break;
+        }
+        case SHAPE_POLYGON:
+        case SHAPE_POLYGON_FILLED: {
+            int sides = 3 + random() % 6;
+            double rotation = (random() % 628) / 100.0;
+            display.drawPolygon(x, y, radius, sides, 1, shape == SHAPE_POLYGON_FILLED, rotation);
+            break;
+        }
+        case SHAPE_ARC:
+        case SHAPE_ARC_FILLED: {
+            double start = random() % 360, end = start + random() % 360;
+            int closed = (shape == SHAPE_ARC) ? random() % 2 : 0;
+            display.drawArc(x, y, radius, radius, 1, shape == SHAPE_ARC_FILLED, start, end, closed);
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+int main() {
+    GPGFX_DisplayTypeOptions options {};
+    PeripheralI2C i2c;
+    options.i2c = &i2c;
+    options.font = font;
+    GPGFX_TinySSD1306 display;
+    display.init(options);
+    BaselineTinySSD1306 reference(font);
+
+    for (int shape = 0; shape < SHAPE_COUNT; shape++) {
+        bool exact = (shape < SHAPE_ROTATED_RECTANGLE);
+        std::mt19937 random(shape + 1);
+        for (int scene = 0; scene < 500; scene++) {
+            display.clear();
+            reference.clear();
+            std::mt19937 sceneRandom = random;
+            draw(display, (Shape)shape, sceneRandom);
+            draw(reference, (Shape)shape, random);
+
+            const uint8_t * drawn = display.getFrameBuffer();
+            const uint8_t * expected = reference.getFrameBuffer();
+            if (exact) {
+                EXPECT(memcmp(drawn, expected, 1024) == 0, "%s %d matches the reference", shapeNames[shape], scene);
+            } else {
+                int stray = strayPixels(drawn, expected) + strayPixels(expected, drawn);
+                EXPECT(stray == 0, "%s %d is within a pixel of the reference, %d stray pixels", shapeNames[shape], scene, stray);
+            }
+        }
+    }
+
+    return TEST_RESULT("tiny_ssd1306_test");
+}
@@ -0,0 +1,129 @@
+// Builds the webconfig route table from the paths in src/configs/webconfig.cpp and checks that
+// the perfect hash lookup finds exactly what a strcmp over the whole list finds: every route,
+// and nothing for near misses, other paths or random strings.
+
+#include "configs/webconfig_routes.h"
+
+#include "testing.h"
+
+#include <fstream>
+#include <random>
+#include <regex>
+#include <set>
+#include <sstream>
+#include <string>
+
+struct Route
+{
+    const char* path;
+};
+
+// The route paths of webconfig.cpp, in its order. checkPathList() fails when they drift apart.
+static constexpr Route routes[] =
+{
+    { "/api/setDisplayOptions" }, { "/api/setPreviewDisplayOptions" }, { "/api/setGamepadOptions" },
+    { "/api/setLedOptions" }, { "/api/setCustomTheme" }, { "/api/getCustomTheme" },
+    { "/api/setPinMappings" }, { "/api/setProfileOptions" }, { "/api/setPeripheralOptions" },
+    { "/api/getPeripheralOptions" }, { "/api/getI2CPeripheralMap" }, { "/api/setExpansionPins" },
+    { "/api/getExpansionPins" }, { "/api/setReactiveLEDs" }, { "/api/getReactiveLEDs" },
+    { "/api/setKeyMappings" }, { "/api/setAddonsOptions" }, { "/api/setMacroAddonOptions" },
+    { "/api/setPS4Options" }, { "/api/setWiiControls" }, { "/api/setSplashImage" },
+    { "/api/reboot" }, { "/api/getDisplayOptions" }, { "/api/getGamepadOptions" },
+    { "/api/getButtonLayoutDefs" }, { "/api/getButtonLayouts" }, { "/api/getLedOptions" },
+    { "/api/getPinMappings" }, { "/api/getProfileOptions" }, { "/api/getKeyMappings" },
+    { "/api/getAddonsOptions" }, { "/api/getWiiControls" }, { "/api/getMacroAddonOptions" },
+    { "/api/resetSettings" }, { "/api/getSplashImage" }, { "/api/getFirmwareVersion" },
+    { "/api/getMemoryReport" }, { "/api/getBootTimeline" }, { "/api/getTaskStats" },
+    { "/api/getHeldPins" }, { "/api/abortGetHeldPins" }, { "/api/getUsedPins" },
+    { "/api/getConfig" }, { "/api/echo" }, { "/api/setConfig" },
+    { "/css" }, { "/images" }, { "/js" }, { "/static" },
+    { "/backup" }, { "/display-config" }, { "/led-config" }, { "/pin-mapping" }, { "/settings" },
+    { "/reset-settings" }, { "/add-ons" }, { "/custom-theme" }, { "/macro" }, { "/peripheral-mapping" },
+};
+static const size_t numRoutes = sizeof(routes) / sizeof(routes[0]);
+
+static constexpr auto routeTable = makeRouteTable(routes);
+static_assert(routeTable.valid, "No collision free seed found for the test route table");
+
+static const Route* linearFind(const char* name)
+{
+    for (const Route& route : routes)
+        if (strcmp(route.path, name) == 0)
+            return &route;
+    return nullptr;
+}
+
+static void expectSameRoute(const std::string& name)
+{
+    const Route* hashed = findRoute(routeTable, routes, name.c_str());
+    const Route* linear = linearFind(name.c_str());
+    EXPECT(hashed == linear, "\"%s\" resolves to %s, strcmp finds %s", name.c_str(),
+        hashed ? hashed->path : "nothing", linear ? linear->path : "nothing");
+}
+
+static void checkPathList()
+{
+    std::ifstream file(WEBCONFIG_SOURCE);
+    std::stringstream source;
+    source << file.rdbuf();
+    std::string text = source.str();
+    size_t start = text.find("static constexpr Route routes[] =");
+    size_t end = text.find("};", start);
+    EXPECT(start != std::string::npos && end != std::string::npos, "route list found in %s", WEBCONFIG_SOURCE);
+    if (start == std::string::npos || end == std::string::npos)
+        return;
+
+    std::string list = text.substr(start, end - start);
+    std::regex pathPattern("\\{ \"(/[^\"]*)\"");
+    size_t i = 0;
+    for (auto it = std::sregex_iterator(list.begin(), list.end(), pathPattern); it != std::sregex_iterator(); ++it, ++i)
+    {
+        std::string path = (*it)[1];
+        EXPECT(i < numRoutes && path == routes[i].path, "route %zu of webconfig.cpp is %s, the test has %s",
+            i, path.c_str(), i < numRoutes ? routes[i].path : "nothing");
+    }
+    EXPECT(i == numRoutes, "webconfig.cpp has %zu routes, the test has %zu", i, numRoutes);
+}
+
+static void checkLookups()
+{
+    std::set<std::string> misses = { "", "/", "/api", "/api/", "/index.html", "/favicon.ico", "/cgi/action",
+        "/js/app.js", "/css/main.css", "/images/logo.png" };
+    for (const Route& route : routes)
+    {
+        std::string path = route.path;
+        EXPECT(findRoute(routeTable, routes, route.path) == &route, "%s resolves to itself", route.path);
+        // Near misses of every route
+        misses.insert(path + "/");
+        misses.insert(path + "x");
+        misses.insert(path.substr(0, path.size() - 1));
+        misses.insert(path.substr(1));
+        std::string upper = path;
+        upper[1] = toupper(upper[1]);
+        misses.insert(upper);
+    }
+    for (const std::string& miss : misses)
+        expectSameRoute(miss);
+
+    // Random paths built from route characters
+    std::mt19937 random(26);
+    const char alphabet[] = "/-abcdefghijklmnopqrstuvwxyzACDEGHIKLMOPRST2";
+    for (int i = 0; i < 200000; i++)
+    {
+        std::string path = "/";
+        size_t length = random() % 24;
+        for (size_t c = 0; c < length; c++)
+            path += alphabet[random() % (sizeof(alphabet) - 1)];
+        expectSameRoute(path);
+    }
+    printf("%zu routes in %zu slots, seed %u, %zu near misses and 200000 random paths checked\n",
+        numRoutes, routeTable.size, (unsigned)routeTable.seed, misses.size());
+}
+
+int main()
+{
+    checkPathList();
+    checkLookups();
+
+    return TEST_RESULT("webconfig_routes_test");
+}
@@ -0,0 +1,125 @@
+#ifndef _GAMEPAD_H_
+#define _GAMEPAD_H_
+
+// Stands in for headers/gamepad.h, storagemanager.h, the peripheral and task managers and the
+// Wii extension I2C device in wiiext_test. Force-included, so their include guards keep the
+// real ones out. The test sets the extension type and its decoded state on the device itself,
+// and runs the polling task the add-on registers.
+
+#include <stdint.h>
+#include <string.h>
+
+#include <functional>
+#include <vector>
+
+#include "gamepad/GamepadState.h"
+#include "gamepad/GamepadAuxState.h"
+
+class Gamepad {
+public:
+    GamepadState state;
+    GamepadAuxState auxState;
+    bool hasAnalogTriggers {false};
+};
+
+#endif
+
+#ifndef STORAGE_H_
+#define STORAGE_H_
+
+#include "config.pb.h"
+
+struct AddonOptions {
+    WiiOptions wiiOptions;
+};
+
+class Storage {
+public:
+    static Storage& getInstance() {
+        static Storage instance;
+        return instance;
+    }
+    AddonOptions& getAddonOptions() { return addonOptions; }
+    Gamepad* GetGamepad() { return &gamepad; }
+
+    AddonOptions addonOptions {};
+    Gamepad gamepad;
+};
+
+#endif
+
+#ifndef _TASKMANAGER_H_
+#define _TASKMANAGER_H_
+
+class TaskManager {
+public:
+    typedef std::function<void()> TaskFunction;
+
+    static TaskManager& getInstance() {
+        static TaskManager instance;
+        return instance;
+    }
+    int addPeriodicTask(const char* name, uint32_t periodUs, TaskFunction task) {
+        periodicTask = task;
+        return 0;
+    }
+
+    // the last periodic task added
+    TaskFunction periodicTask;
+};
+
+#endif
+
+#ifndef _HELPER_H_
+#define _HELPER_H_
+#endif
+
+#ifndef _PERIPHERALMANAGER_H_
+#define _PERIPHERALMANAGER_H_
+
+#include "peripheral_i2c.h"
+
+typedef struct {
+    int8_t address;
+    uint8_t block;
+} PeripheralI2CScanResult;
+
+class PeripheralManager {
+public:
+    static PeripheralManager& getInstance() {
+        static PeripheralManager instance;
+        return instance;
+    }
+    PeripheralI2C* getI2C(uint8_t block) { return &i2c; }
+    PeripheralI2CScanResult scanForI2CDevice(std::vector<uint8_t> addressList) { return { (int8_t)addressList.front(), 0 }; }
+
+    PeripheralI2C i2c;
+};
+
+#endif
+
+#ifndef _WIIEXTDEVICE_H_
+#define _WIIEXTDEVICE_H_
+
+#include <WiiExtension.h>
+
+class WiiExtensionDevice {
+public:
+    WiiExtensionDevice() { created = this; }
+
+    // the last device an add-on created
+    static inline WiiExtensionDevice* created = nullptr;
+
+    int8_t extensionType = WII_EXTENSION_NONE;
+    ExtensionBase* controller = nullptr;
+
+    void begin() {}
+    void start() {}
+    void poll() {}
+    void setI2C(PeripheralI2C *i2cController) {}
+    void setAddress(uint8_t addr) {}
+    ExtensionBase* getController() { return controller; }
+    std::vector<uint8_t> getDeviceAddresses() const { return {WII_EXTENSION_I2C_ADDR,WII_MOTIONPLUS_I2C_ADDR}; }
+};
+
+#endif
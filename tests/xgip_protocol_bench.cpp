@@ -0,0 +1,39 @@
+// Time to encode and reassemble a full size auth message with XGIPProtocol, on the host
+
+#include "drivers/xbone/XBOneDescriptors.h"
+#include "drivers/shared/xgip_protocol.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+
+int main() {
+    static uint8_t payload[GIP_MAX_DATA_SIZE];
+    static uint8_t reassembly[GIP_MAX_DATA_SIZE];
+    for (int i = 0; i < GIP_MAX_DATA_SIZE; i++)
+        payload[i] = (uint8_t)(i * 7 + 3);
+
+    const int iterations = 20000;
+    uint32_t packets = 0;
+    uint32_t check = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++) {
+        XGIPProtocol out;
+        XGIPProtocol in;
+        in.setReassemblyBuffer(reassembly, sizeof(reassembly));
+        out.setAttributes(0x06, (uint8_t)i, 1, 1, 1);
+        out.setData(payload, sizeof(payload));
+        uint8_t endpoint[64];
+        do {
+            out.generatePacket(endpoint);
+            in.parse(endpoint, out.getPacketLength());
+            packets++;
+        } while (!out.endOfChunk());
+        check += in.getData()[i % GIP_MAX_DATA_SIZE];
+    }
+    auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+
+    printf("%d messages of %d bytes, %u packets: %.1f ns/packet, %.2f us/message (check %u)\n",
+        iterations, GIP_MAX_DATA_SIZE, packets, (double)elapsed / packets, elapsed / 1000.0 / iterations, check);
+    return 0;
+}
@@ -0,0 +1,184 @@
+#ifndef _XGIP_PROTOCOL_VECTORS_H_
+#define _XGIP_PROTOCOL_VECTORS_H_
+
+// XGIP packet streams recorded from the XGIPProtocol that owned its 1 KB payload buffer,
+// before the codec went zero-copy. Each packet is prefixed with its length. Payload byte i
+// is (i * 7 + 3), sent as command 0x06, sequence 5, internal, needing an ack, chunked
+// above 58 bytes. The acks are what the receiving side answered to each packet.
+
+#include <stdint.h>
+
+static const uint8_t xgipPackets10[] = {
+    0x0e, 0x06, 0x30, 0x05, 0x0a, 0x03, 0x0a, 0x11, 0x18, 0x1f, 0x26, 0x2d, 0x34, 0x3b, 0x42,
+};
+
+static const uint8_t xgipAcks10[] = {
+    0x0d, 0x01, 0x20, 0x05, 0x09, 0x00, 0x06, 0x20, 0x0a, 0x00, 0x00, 0x00, 0x00, 0x00,
+};
+
+static const uint8_t xgipPackets58[] = {
+    0x3e, 0x06, 0x30, 0x05, 0x3a, 0x03, 0x0a, 0x11, 0x18, 0x1f, 0x26, 0x2d, 0x34, 0x3b, 0x42, 0x49,
+    0x50, 0x57, 0x5e, 0x65, 0x6c, 0x73, 0x7a, 0x81, 0x88, 0x8f, 0x96, 0x9d, 0xa4, 0xab, 0xb2, 0xb9,
+    0xc0, 0xc7, 0xce, 0xd5, 0xdc, 0xe3, 0xea, 0xf1, 0xf8, 0xff, 0x06, 0x0d, 0x14, 0x1b, 0x22, 0x29,
+    0x30, 0x37, 0x3e, 0x45, 0x4c, 0x53, 0x5a, 0x61, 0x68, 0x6f, 0x76, 0x7d, 0x84, 0x8b, 0x92,
+};
+
+static const uint8_t xgipAcks58[] = {
+    0x0d, 0x01, 0x20, 0x05, 0x09, 0x00, 0x06, 0x20, 0x3a, 0x00, 0x00, 0x00, 0x00, 0x00,
+};
+
+static const uint8_t xgipPackets59[] = {
+    0x40, 0x06, 0xf0, 0x05, 0xba, 0x00, 0x3b, 0x03, 0x0a, 0x11, 0x18, 0x1f, 0x26, 0x2d, 0x34, 0x3b,
+    0x42, 0x49, 0x50, 0x57, 0x5e, 0x65, 0x6c, 0x73, 0x7a, 0x81, 0x88, 0x8f, 0x96, 0x9d, 0xa4, 0xab,
+    0xb2, 0xb9, 0xc0, 0xc7, 0xce, 0xd5, 0xdc, 0xe3, 0xea, 0xf1, 0xf8, 0xff, 0x06, 0x0d, 0x14, 0x1b,
+    0x22, 0x29, 0x30, 0x37, 0x3e, 0x45, 0x4c, 0x53, 0x5a, 0x61, 0x68, 0x6f, 0x76, 0x7d, 0x84, 0x8b,
+    0x92, 0x07, 0x06, 0xb0, 0x05, 0x81, 0x00, 0x3a, 0x99, 0x06, 0x06, 0xa0, 0x05, 0x00, 0x3b, 0x00,
+};
+
+static const uint8_t xgipAcks59[] = {
+    0x0d, 0x01, 0x20, 0x05, 0x09, 0x00, 0x06, 0x20, 0x3a, 0x00, 0x00, 0x00, 0x01, 0x00, 0x0d, 0x01,
+    0x20, 0x05, 0x09, 0x00, 0x06, 0x20, 0x3b, 0x00, 0x00, 0x00, 0x00, 0x00,
+};
+
+static const uint8_t xgipPackets100[] = {
+    0x40, 0x06, 0xf0, 0x05, 0xba, 0x00, 0x64, 0x03, 0x0a, 0x11, 0x18, 0x1f, 0x26, 0x2d, 0x34, 0x3b,
+    0x42, 0x49, 0x50, 0x57, 0x5e, 0x65, 0x6c, 0x73, 0x7a, 0x81, 0x88, 0x8f, 0x96, 0x9d, 0xa4, 0xab,
+    0xb2, 0xb9, 0xc0, 0xc7, 0xce, 0xd5, 0xdc, 0xe3, 0xea, 0xf1, 0xf8, 0xff, 0x06, 0x0d, 0x14, 0x1b,
+    0x22, 0x29, 0x30, 0x37, 0x3e, 0x45, 0x4c, 0x53, 0x5a, 0x61, 0x68, 0x6f, 0x76, 0x7d, 0x84, 0x8b,
+    0x92, 0x30, 0x06, 0xb0, 0x05, 0xaa, 0x00, 0x3a, 0x99, 0xa0, 0xa7, 0xae, 0xb5, 0xbc, 0xc3, 0xca,
+    0xd1, 0xd8, 0xdf, 0xe6, 0xed, 0xf4, 0xfb, 0x02, 0x09, 0x10, 0x17, 0x1e, 0x25, 0x2c, 0x33, 0x3a,
+    0x41, 0x48, 0x4f, 0x56, 0x5d, 0x64, 0x6b, 0x72, 0x79, 0x80, 0x87, 0x8e, 0x95, 0x9c, 0xa3, 0xaa,
+    0xb1, 0xb8, 0x06, 0x06, 0xa0, 0x05, 0x00, 0x64, 0x00,
+};
+
+static const uint8_t xgipAcks100[] = {
+    0x0d, 0x01, 0x20, 0x05, 0x09, 0x00, 0x06, 0x20, 0x3a, 0x00, 0x00, 0x00, 0x2a, 0x00, 0x0d, 0x01,
+    0x20, 0x05, 0x09, 0x00, 0x06, 0x20, 0x64, 0x00, 0x00, 0x00, 0x00, 0x00,
+};
+
+static const uint8_t xgipPackets300[] = {
+    0x40, 0x06, 0xf0, 0x05, 0x3a, 0xac, 0x02, 0x03, 0x0a, 0x11, 0x18, 0x1f, 0x26, 0x2d, 0x34, 0x3b,
+    0x42, 0x49, 0x50, 0x57, 0x5e, 0x65, 0x6c, 0x73, 0x7a, 0x81, 0x88, 0x8f, 0x96, 0x9d, 0xa4, 0xab,
+    0xb2, 0xb9, 0xc0, 0xc7, 0xce, 0xd5, 0xdc, 0xe3, 0xea, 0xf1, 0xf8, 0xff, 0x06, 0x0d, 0x14, 0x1b,
+    0x22, 0x29, 0x30, 0x37, 0x3e, 0x45, 0x4c, 0x53, 0x5a, 0x61, 0x68, 0x6f, 0x76, 0x7d, 0x84, 0x8b,
+    0x92, 0x40, 0x06, 0xa0, 0x05, 0xba, 0x00, 0x3a, 0x99, 0xa0, 0xa7, 0xae, 0xb5, 0xbc, 0xc3, 0xca,
+    0xd1, 0xd8, 0xdf, 0xe6, 0xed, 0xf4, 0xfb, 0x02, 0x09, 0x10, 0x17, 0x1e, 0x25, 0x2c, 0x33, 0x3a,
+    0x41, 0x48, 0x4f, 0x56, 0x5d, 0x64, 0x6b, 0x72, 0x79, 0x80, 0x87, 0x8e, 0x95, 0x9c, 0xa3, 0xaa,
+    0xb1, 0xb8, 0xbf, 0xc6, 0xcd, 0xd4, 0xdb, 0xe2, 0xe9, 0xf0, 0xf7, 0xfe, 0x05, 0x0c, 0x13, 0x1a,
+    0x21, 0x28, 0x40, 0x06, 0xa0, 0x05, 0xba, 0x00, 0x74, 0x2f, 0x36, 0x3d, 0x44, 0x4b, 0x52, 0x59,
+    0x60, 0x67, 0x6e, 0x75, 0x7c, 0x83, 0x8a, 0x91, 0x98, 0x9f, 0xa6, 0xad, 0xb4, 0xbb, 0xc2, 0xc9,
+    0xd0, 0xd7, 0xde, 0xe5, 0xec, 0xf3, 0xfa, 0x01, 0x08, 0x0f, 0x16, 0x1d, 0x24, 0x2b, 0x32, 0x39,
+    0x40, 0x47, 0x4e, 0x55, 0x5c, 0x63, 0x6a, 0x71, 0x78, 0x7f, 0x86, 0x8d, 0x94, 0x9b, 0xa2, 0xa9,
+    0xb0, 0xb7, 0xbe, 0x40, 0x06, 0xa0, 0x05, 0x3a, 0xae, 0x01, 0xc5, 0xcc, 0xd3, 0xda, 0xe1, 0xe8,
+    0xef, 0xf6, 0xfd, 0x04, 0x0b, 0x12, 0x19, 0x20, 0x27, 0x2e, 0x35, 0x3c, 0x43, 0x4a, 0x51, 0x58,
+    0x5f, 0x66, 0x6d, 0x74, 0x7b, 0x82, 0x89, 0x90, 0x97, 0x9e, 0xa5, 0xac, 0xb3, 0xba, 0xc1, 0xc8,
+    0xcf, 0xd6, 0xdd, 0xe4, 0xeb, 0xf2, 0xf9, 0x00, 0x07, 0x0e, 0x15, 0x1c, 0x23, 0x2a, 0x31, 0x38,
+    0x3f, 0x46, 0x4d, 0x54, 0x40, 0x06, 0xb0, 0x05, 0x3a, 0xe8, 0x01, 0x5b, 0x62, 0x69, 0x70, 0x77,
+    0x7e, 0x85, 0x8c, 0x93, 0x9a, 0xa1, 0xa8, 0xaf, 0xb6, 0xbd, 0xc4, 0xcb, 0xd2, 0xd9, 0xe0, 0xe7,
+    0xee, 0xf5, 0xfc, 0x03, 0x0a, 0x11, 0x18, 0x1f, 0x26, 0x2d, 0x34, 0x3b, 0x42, 0x49, 0x50, 0x57,
+    0x5e, 0x65, 0x6c, 0x73, 0x7a, 0x81, 0x88, 0x8f, 0x96, 0x9d, 0xa4, 0xab, 0xb2, 0xb9, 0xc0, 0xc7,
+    0xce, 0xd5, 0xdc, 0xe3, 0xea, 0x10, 0x06, 0xb0, 0x05, 0x0a, 0xa2, 0x02, 0xf1, 0xf8, 0xff, 0x06,
+    0x0d, 0x14, 0x1b, 0x22, 0x29, 0x30, 0x06, 0x06, 0xa0, 0x05, 0x00, 0xac, 0x02,
+};
+
+static const uint8_t xgipAcks300[] = {
+    0x0d, 0x01, 0x20, 0x05, 0x09, 0x00, 0x06, 0x20, 0x3a, 0x00, 0x00, 0x00, 0xf2, 0x00, 0x0d, 0x01,
+    0x20, 0x05, 0x09, 0x00, 0x06, 0x20, 0x22, 0x01, 0x00, 0x00, 0x0a, 0x00, 0x0d, 0x01, 0x20, 0x05,
+    0x09, 0x00, 0x06, 0x20, 0x2c, 0x01, 0x00, 0x00, 0x00, 0x00,
+};
+
+static const uint8_t xgipPackets900[] = {
+    0x40, 0x06, 0xf0, 0x05, 0x3a, 0x84, 0x07, 0x03, 0x0a, 0x11, 0x18, 0x1f, 0x26, 0x2d, 0x34, 0x3b,
+    0x42, 0x49, 0x50, 0x57, 0x5e, 0x65, 0x6c, 0x73, 0x7a, 0x81, 0x88, 0x8f, 0x96, 0x9d, 0xa4, 0xab,
+    0xb2, 0xb9, 0xc0, 0xc7, 0xce, 0xd5, 0xdc, 0xe3, 0xea, 0xf1, 0xf8, 0xff, 0x06, 0x0d, 0x14, 0x1b,
+    0x22, 0x29, 0x30, 0x37, 0x3e, 0x45, 0x4c, 0x53, 0x5a, 0x61, 0x68, 0x6f, 0x76, 0x7d, 0x84, 0x8b,
+    0x92, 0x40, 0x06, 0xa0, 0x05, 0xba, 0x00, 0x3a, 0x99, 0xa0, 0xa7, 0xae, 0xb5, 0xbc, 0xc3, 0xca,
+    0xd1, 0xd8, 0xdf, 0xe6, 0xed, 0xf4, 0xfb, 0x02, 0x09, 0x10, 0x17, 0x1e, 0x25, 0x2c, 0x33, 0x3a,
+    0x41, 0x48, 0x4f, 0x56, 0x5d, 0x64, 0x6b, 0x72, 0x79, 0x80, 0x87, 0x8e, 0x95, 0x9c, 0xa3, 0xaa,
+    0xb1, 0xb8, 0xbf, 0xc6, 0xcd, 0xd4, 0xdb, 0xe2, 0xe9, 0xf0, 0xf7, 0xfe, 0x05, 0x0c, 0x13, 0x1a,
+    0x21, 0x28, 0x40, 0x06, 0xa0, 0x05, 0xba, 0x00, 0x74, 0x2f, 0x36, 0x3d, 0x44, 0x4b, 0x52, 0x59,
+    0x60, 0x67, 0x6e, 0x75, 0x7c, 0x83, 0x8a, 0x91, 0x98, 0x9f, 0xa6, 0xad, 0xb4, 0xbb, 0xc2, 0xc9,
+    0xd0, 0xd7, 0xde, 0xe5, 0xec, 0xf3, 0xfa, 0x01, 0x08, 0x0f, 0x16, 0x1d, 0x24, 0x2b, 0x32, 0x39,
+    0x40, 0x47, 0x4e, 0x55, 0x5c, 0x63, 0x6a, 0x71, 0x78, 0x7f, 0x86, 0x8d, 0x94, 0x9b, 0xa2, 0xa9,
+    0xb0, 0xb7, 0xbe, 0x40, 0x06, 0xa0, 0x05, 0x3a, 0xae, 0x01, 0xc5, 0xcc, 0xd3, 0xda, 0xe1, 0xe8,
+    0xef, 0xf6, 0xfd, 0x04, 0x0b, 0x12, 0x19, 0x20, 0x27, 0x2e, 0x35, 0x3c, 0x43, 0x4a, 0x51, 0x58,
+    0x5f, 0x66, 0x6d, 0x74, 0x7b, 0x82, 0x89, 0x90, 0x97, 0x9e, 0xa5, 0xac, 0xb3, 0xba, 0xc1, 0xc8,
+    0xcf, 0xd6, 0xdd, 0xe4, 0xeb, 0xf2, 0xf9, 0x00, 0x07, 0x0e, 0x15, 0x1c, 0x23, 0x2a, 0x31, 0x38,
+    0x3f, 0x46, 0x4d, 0x54, 0x40, 0x06, 0xb0, 0x05, 0x3a, 0xe8, 0x01, 0x5b, 0x62, 0x69, 0x70, 0x77,
+    0x7e, 0x85, 0x8c, 0x93, 0x9a, 0xa1, 0xa8, 0xaf, 0xb6, 0xbd, 0xc4, 0xcb, 0xd2, 0xd9, 0xe0, 0xe7,
+    0xee, 0xf5, 0xfc, 0x03, 0x0a, 0x11, 0x18, 0x1f, 0x26, 0x2d, 0x34, 0x3b, 0x42, 0x49, 0x50, 0x57,
+    0x5e, 0x65, 0x6c, 0x73, 0x7a, 0x81, 0x88, 0x8f, 0x96, 0x9d, 0xa4, 0xab, 0xb2, 0xb9, 0xc0, 0xc7,
+    0xce, 0xd5, 0xdc, 0xe3, 0xea, 0x40, 0x06, 0xa0, 0x05, 0x3a, 0xa2, 0x02, 0xf1, 0xf8, 0xff, 0x06,
+    0x0d, 0x14, 0x1b, 0x22, 0x29, 0x30, 0x37, 0x3e, 0x45, 0x4c, 0x53, 0x5a, 0x61, 0x68, 0x6f, 0x76,
+    0x7d, 0x84, 0x8b, 0x92, 0x99, 0xa0, 0xa7, 0xae, 0xb5, 0xbc, 0xc3, 0xca, 0xd1, 0xd8, 0xdf, 0xe6,
+    0xed, 0xf4, 0xfb, 0x02, 0x09, 0x10, 0x17, 0x1e, 0x25, 0x2c, 0x33, 0x3a, 0x41, 0x48, 0x4f, 0x56,
+    0x5d, 0x64, 0x6b, 0x72, 0x79, 0x80, 0x40, 0x06, 0xa0, 0x05, 0x3a, 0xdc, 0x02, 0x87, 0x8e, 0x95,
+    0x9c, 0xa3, 0xaa, 0xb1, 0xb8, 0xbf, 0xc6, 0xcd, 0xd4, 0xdb, 0xe2, 0xe9, 0xf0, 0xf7, 0xfe, 0x05,
+    0x0c, 0x13, 0x1a, 0x21, 0x28, 0x2f, 0x36, 0x3d, 0x44, 0x4b, 0x52, 0x59, 0x60, 0x67, 0x6e, 0x75,
+    0x7c, 0x83, 0x8a, 0x91, 0x98, 0x9f, 0xa6, 0xad, 0xb4, 0xbb, 0xc2, 0xc9, 0xd0, 0xd7, 0xde, 0xe5,
+    0xec, 0xf3, 0xfa, 0x01, 0x08, 0x0f, 0x16, 0x40, 0x06, 0xa0, 0x05, 0x3a, 0x96, 0x03, 0x1d, 0x24,
+    0x2b, 0x32, 0x39, 0x40, 0x47, 0x4e, 0x55, 0x5c, 0x63, 0x6a, 0x71, 0x78, 0x7f, 0x86, 0x8d, 0x94,
+    0x9b, 0xa2, 0xa9, 0xb0, 0xb7, 0xbe, 0xc5, 0xcc, 0xd3, 0xda, 0xe1, 0xe8, 0xef, 0xf6, 0xfd, 0x04,
+    0x0b, 0x12, 0x19, 0x20, 0x27, 0x2e, 0x35, 0x3c, 0x43, 0x4a, 0x51, 0x58, 0x5f, 0x66, 0x6d, 0x74,
+    0x7b, 0x82, 0x89, 0x90, 0x97, 0x9e, 0xa5, 0xac, 0x40, 0x06, 0xa0, 0x05, 0x3a, 0xd0, 0x03, 0xb3,
+    0xba, 0xc1, 0xc8, 0xcf, 0xd6, 0xdd, 0xe4, 0xeb, 0xf2, 0xf9, 0x00, 0x07, 0x0e, 0x15, 0x1c, 0x23,
+    0x2a, 0x31, 0x38, 0x3f, 0x46, 0x4d, 0x54, 0x5b, 0x62, 0x69, 0x70, 0x77, 0x7e, 0x85, 0x8c, 0x93,
+    0x9a, 0xa1, 0xa8, 0xaf, 0xb6, 0xbd, 0xc4, 0xcb, 0xd2, 0xd9, 0xe0, 0xe7, 0xee, 0xf5, 0xfc, 0x03,
+    0x0a, 0x11, 0x18, 0x1f, 0x26, 0x2d, 0x34, 0x3b, 0x42, 0x40, 0x06, 0xb0, 0x05, 0x3a, 0x8a, 0x04,
+    0x49, 0x50, 0x57, 0x5e, 0x65, 0x6c, 0x73, 0x7a, 0x81, 0x88, 0x8f, 0x96, 0x9d, 0xa4, 0xab, 0xb2,
+    0xb9, 0xc0, 0xc7, 0xce, 0xd5, 0xdc, 0xe3, 0xea, 0xf1, 0xf8, 0xff, 0x06, 0x0d, 0x14, 0x1b, 0x22,
+    0x29, 0x30, 0x37, 0x3e, 0x45, 0x4c, 0x53, 0x5a, 0x61, 0x68, 0x6f, 0x76, 0x7d, 0x84, 0x8b, 0x92,
+    0x99, 0xa0, 0xa7, 0xae, 0xb5, 0xbc, 0xc3, 0xca, 0xd1, 0xd8, 0x40, 0x06, 0xa0, 0x05, 0x3a, 0xc4,
+    0x04, 0xdf, 0xe6, 0xed, 0xf4, 0xfb, 0x02, 0x09, 0x10, 0x17, 0x1e, 0x25, 0x2c, 0x33, 0x3a, 0x41,
+    0x48, 0x4f, 0x56, 0x5d, 0x64, 0x6b, 0x72, 0x79, 0x80, 0x87, 0x8e, 0x95, 0x9c, 0xa3, 0xaa, 0xb1,
+    0xb8, 0xbf, 0xc6, 0xcd, 0xd4, 0xdb, 0xe2, 0xe9, 0xf0, 0xf7, 0xfe, 0x05, 0x0c, 0x13, 0x1a, 0x21,
+    0x28, 0x2f, 0x36, 0x3d, 0x44, 0x4b, 0x52, 0x59, 0x60, 0x67, 0x6e, 0x40, 0x06, 0xa0, 0x05, 0x3a,
+    0xfe, 0x04, 0x75, 0x7c, 0x83, 0x8a, 0x91, 0x98, 0x9f, 0xa6, 0xad, 0xb4, 0xbb, 0xc2, 0xc9, 0xd0,
+    0xd7, 0xde, 0xe5, 0xec, 0xf3, 0xfa, 0x01, 0x08, 0x0f, 0x16, 0x1d, 0x24, 0x2b, 0x32, 0x39, 0x40,
+    0x47, 0x4e, 0x55, 0x5c, 0x63, 0x6a, 0x71, 0x78, 0x7f, 0x86, 0x8d, 0x94, 0x9b, 0xa2, 0xa9, 0xb0,
+    0xb7, 0xbe, 0xc5, 0xcc, 0xd3, 0xda, 0xe1, 0xe8, 0xef, 0xf6, 0xfd, 0x04, 0x40, 0x06, 0xa0, 0x05,
+    0x3a, 0xb8, 0x05, 0x0b, 0x12, 0x19, 0x20, 0x27, 0x2e, 0x35, 0x3c, 0x43, 0x4a, 0x51, 0x58, 0x5f,
+    0x66, 0x6d, 0x74, 0x7b, 0x82, 0x89, 0x90, 0x97, 0x9e, 0xa5, 0xac, 0xb3, 0xba, 0xc1, 0xc8, 0xcf,
+    0xd6, 0xdd, 0xe4, 0xeb, 0xf2, 0xf9, 0x00, 0x07, 0x0e, 0x15, 0x1c, 0x23, 0x2a, 0x31, 0x38, 0x3f,
+    0x46, 0x4d, 0x54, 0x5b, 0x62, 0x69, 0x70, 0x77, 0x7e, 0x85, 0x8c, 0x93, 0x9a, 0x40, 0x06, 0xa0,
+    0x05, 0x3a, 0xf2, 0x05, 0xa1, 0xa8, 0xaf, 0xb6, 0xbd, 0xc4, 0xcb, 0xd2, 0xd9, 0xe0, 0xe7, 0xee,
+    0xf5, 0xfc, 0x03, 0x0a, 0x11, 0x18, 0x1f, 0x26, 0x2d, 0x34, 0x3b, 0x42, 0x49, 0x50, 0x57, 0x5e,
+    0x65, 0x6c, 0x73, 0x7a, 0x81, 0x88, 0x8f, 0x96, 0x9d, 0xa4, 0xab, 0xb2, 0xb9, 0xc0, 0xc7, 0xce,
+    0xd5, 0xdc, 0xe3, 0xea, 0xf1, 0xf8, 0xff, 0x06, 0x0d, 0x14, 0x1b, 0x22, 0x29, 0x30, 0x40, 0x06,
+    0xb0, 0x05, 0x3a, 0xac, 0x06, 0x37, 0x3e, 0x45, 0x4c, 0x53, 0x5a, 0x61, 0x68, 0x6f, 0x76, 0x7d,
+    0x84, 0x8b, 0x92, 0x99, 0xa0, 0xa7, 0xae, 0xb5, 0xbc, 0xc3, 0xca, 0xd1, 0xd8, 0xdf, 0xe6, 0xed,
+    0xf4, 0xfb, 0x02, 0x09, 0x10, 0x17, 0x1e, 0x25, 0x2c, 0x33, 0x3a, 0x41, 0x48, 0x4f, 0x56, 0x5d,
+    0x64, 0x6b, 0x72, 0x79, 0x80, 0x87, 0x8e, 0x95, 0x9c, 0xa3, 0xaa, 0xb1, 0xb8, 0xbf, 0xc6, 0x24,
+    0x06, 0xb0, 0x05, 0x1e, 0xe6, 0x06, 0xcd, 0xd4, 0xdb, 0xe2, 0xe9, 0xf0, 0xf7, 0xfe, 0x05, 0x0c,
+    0x13, 0x1a, 0x21, 0x28, 0x2f, 0x36, 0x3d, 0x44, 0x4b, 0x52, 0x59, 0x60, 0x67, 0x6e, 0x75, 0x7c,
+    0x83, 0x8a, 0x91, 0x98, 0x06, 0x06, 0xa0, 0x05, 0x00, 0x84, 0x07,
+};
+
+static const uint8_t xgipAcks900[] = {
+    0x0d, 0x01, 0x20, 0x05, 0x09, 0x00, 0x06, 0x20, 0x3a, 0x00, 0x00, 0x00, 0x4a, 0x03, 0x0d, 0x01,
+    0x20, 0x05, 0x09, 0x00, 0x06, 0x20, 0x22, 0x01, 0x00, 0x00, 0x62, 0x02, 0x0d, 0x01, 0x20, 0x05,
+    0x09, 0x00, 0x06, 0x20, 0x44, 0x02, 0x00, 0x00, 0x40, 0x01, 0x0d, 0x01, 0x20, 0x05, 0x09, 0x00,
+    0x06, 0x20, 0x66, 0x03, 0x00, 0x00, 0x1e, 0x00, 0x0d, 0x01, 0x20, 0x05, 0x09, 0x00, 0x06, 0x20,
+    0x84, 0x03, 0x00, 0x00, 0x00, 0x00,
+};
+
+struct XGIPVector {
+    uint16_t payloadLength;
+    const uint8_t * packets;
+    uint16_t packetsLength;
+    const uint8_t * acks;
+    uint16_t acksLength;
+};
+
+#define XGIP_VECTOR(n) { n, xgipPackets##n, sizeof(xgipPackets##n), xgipAcks##n, sizeof(xgipAcks##n) }
+
+static const XGIPVector xgipVectors[] = {
+    XGIP_VECTOR(10),
+    XGIP_VECTOR(58),
+    XGIP_VECTOR(59),
+    XGIP_VECTOR(100),
+    XGIP_VECTOR(300),
+    XGIP_VECTOR(900),
+};
+
+#endif
@@ -54,6 +54,12 @@ const skipCompressionExtensions = new Set(['png', 'json']);
 
 const serverHeader = 'GP2040-CE';
 
+// Vite emits the bundle as /assets/<name>-<content hash>.<ext>, these never change under
+// the same URL and may be cached by the browser without revalidation
+const hashedAssetPattern = /^\/assets\/.+-[A-Za-z0-9_-]{8}\.[a-z0-9]+$/;
+const immutableCacheControl = 'public, max-age=31536000, immutable';
+const revalidateCacheControl = 'no-cache';
+
 const payloadAlignment = 4;
 const hexBytesPerLine = 16;
 
@@ -207,7 +213,11 @@ function makefsdata() {
 		fsdata += createHexString(paddedQualifiedName, false);
 		fsdata += '\n';
 		fsdata += '/* HTTP header */\n';
-		fsdata += createHexString('HTTP/1.0 200 OK\r\n', true);
+		// Persistent files carry a Content-Length, which lets httpd keep the connection alive
+		fsdata += createHexString(
+			shtmlExtensions.has(ext) ? 'HTTP/1.0 200 OK\r\n' : 'HTTP/1.1 200 OK\r\n',
+			true,
+		);
 		fsdata += createHexString(`Server: ${serverHeader}\r\n`, true);
 		fsdata += createHexString(
 			`Content-Length: ${
@@ -218,6 +228,14 @@ function makefsdata() {
 		if (isCompressed) {
 			fsdata += createHexString('Content-Encoding: deflate\r\n', true);
 		}
+		fsdata += createHexString(
+			`Cache-Control: ${
+				hashedAssetPattern.test(qualifiedName)
+					? immutableCacheControl
+					: revalidateCacheControl
+			}\r\n`,
+			true,
+		);
 		fsdata += createHexString(
 			`Content-Type: ${contentTypes.get(ext) ?? defaultContentType}\r\n\r\n`,
 			true,
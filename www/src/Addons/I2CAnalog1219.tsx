@@ -13,10 +13,15 @@ import { I2C_BLOCKS } from '../Data/Peripherals';
 
 export const i2cAnalogScheme = {
 	I2CAnalog1219InputEnabled: yup.number().label('I2C Analog1219 Input Enabled'),
+	I2CAnalog1219DrdyPin: yup
+		.number()
+		.label('I2C Analog1219 DRDY Pin')
+		.validatePinWhenValue('I2CAnalog1219InputEnabled'),
 };
 
 export const i2cAnalogState = {
 	I2CAnalog1219InputEnabled: 0,
+	I2CAnalog1219DrdyPin: -1,
 };
 
 const I2CAnalog1219 = ({ values, errors, handleChange, handleCheckbox }) => {
@@ -36,7 +41,23 @@ const I2CAnalog1219 = ({ values, errors, handleChange, handleCheckbox }) => {
 				hidden={
 					!(values.I2CAnalog1219InputEnabled && getAvailablePeripherals('i2c'))
 				}
-			></div>
+			>
+				<Row className="mb-3">
+					<FormControl
+						type="number"
+						label={t('AddonsConfig:i2c-analog-ads1219-drdy-pin-label')}
+						name="I2CAnalog1219DrdyPin"
+						className="form-control-sm"
+						groupClassName="col-sm-3 mb-3"
+						value={values.I2CAnalog1219DrdyPin}
+						error={errors.I2CAnalog1219DrdyPin}
+						isInvalid={errors.I2CAnalog1219DrdyPin}
+						onChange={handleChange}
+						min={-1}
+						max={29}
+					/>
+				</Row>
+			</div>
 			{getAvailablePeripherals('i2c') ? (
 				<FormCheck
 					label={t('Common:switch-enabled')}
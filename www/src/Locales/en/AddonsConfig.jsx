@@ -75,6 +75,7 @@ export default {
 	'i2c-analog-ads1219-block-label': 'I2C Analog ADS1219 Block',
 	'i2c-analog-ads1219-speed-label': 'I2C Analog ADS1219 Speed',
 	'i2c-analog-ads1219-address-label': 'I2C Analog ADS1219 Address',
+	'i2c-analog-ads1219-drdy-pin-label': 'Data Ready (DRDY) Pin',
 	'dual-directional-input-header-text': 'Dual Directional Input',
 	'dual-directional-input-dpad-mode-label': 'Dual D-Pad Mode',
 	'dual-directional-input-combine-mode-label': 'Combination Mode',